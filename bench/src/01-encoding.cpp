@@ -0,0 +1,160 @@
+/*!
+ * @file   01-encoding.cpp
+ * @brief  Compares the encoding of messages using their frame
+ *         template with a complete re-encoding of every field.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Conf_format.h"
+#include "Field.h"
+#include "Header.h"
+#include "Message.h"
+#include "ModelArena.h"
+#include "random_util.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const uint32_t ITERATIONS = 200000;
+
+static ModelArena fields; /*!< Owns the fields of the headers */
+
+////////////////////////////////////////////////////////////////////////
+static Field* createField(const string& p_balise,
+                          const string& p_name,
+                          const string& p_pos,
+                          const string& p_size,
+                          const string& p_value)
+{
+    Field* l_field = Field_Creator::Create(p_balise, fields);
+    l_field->setParam(Field_format::name,   p_name );
+    l_field->setParam(Field_format::pos,    p_pos  );
+    l_field->setParam(Field_format::size,   p_size );
+    l_field->setParam(Field_format::endian, "LE"   );
+    l_field->setParam(Field_format::swap,   "FALSE");
+    l_field->setParam(Field_format::invert, "FALSE");
+    if(!p_value.empty())
+    {
+        l_field->setParam(Field_format::value, p_value);
+    }
+    return l_field;
+}
+
+////////////////////////////////////////////////////////////////////////
+static void createHeader(Header& p_header, const string& p_name, bool p_time)
+{
+    p_header.setParam(Headers_format::name, p_name);
+    p_header.addField(createField(Field_format::balise, "FIELD_1", "0",  "8",  "16"));
+    p_header.addField(createField(Field_format::balise, "FIELD_2", "8",  "8",  "90"));
+    p_header.addField(createField(Field_format::balise, "FIELD_3", "16", "13", "519"));
+    p_header.addField(createField(Field_format::balise, "FIELD_4", "29", "19", "2"));
+
+    Field* l_size = createField(Field_size_format::balise, "FIELD_SIZE", "48", "16", "");
+    l_size->setParam(Field_format::format, "SIZE_FORMAT_U8");
+    l_size->setParam(Field_format::part,   "SIZE_INCLUDING_HEADER");
+    p_header.addField(l_size);
+
+    if(p_time)
+    {
+        Field* l_time = createField(Field_time_format::balise, "FIELD_TIME", "64", "32", "");
+        l_time->setParam(Field_format::format, "MILLISECONDS");
+        p_header.addField(l_time);
+    }
+    p_header.compile();
+}
+
+////////////////////////////////////////////////////////////////////////
+static void createMessage(Message& p_mesg, Header& p_header, const string& p_size, const string& p_fill)
+{
+    p_mesg.setParam(Messages_format::name,     "MESG");
+    p_mesg.setParam(Messages_format::header,   p_header.getId());
+    p_mesg.setParam(Messages_format::size,     p_size);
+    p_mesg.setParam(Messages_format::src_ip,   "127.0.0.1");
+    p_mesg.setParam(Messages_format::dst_ip,   "127.0.0.1");
+    p_mesg.setParam(Messages_format::src_port, "8000");
+    p_mesg.setParam(Messages_format::dst_port, "8001");
+    p_mesg.setParam(Messages_format::fill,     p_fill);
+    p_mesg.setHeader(&p_header);
+}
+
+////////////////////////////////////////////////////////////////////////
+template<typename F>
+static double measure(F p_encode)
+{
+    auto l_start = chrono::steady_clock::now();
+    for(uint32_t i = 0; i < ITERATIONS; i++)
+    {
+        p_encode();
+    }
+    auto l_end = chrono::steady_clock::now();
+
+    return chrono::duration<double, nano>(l_end - l_start).count() / ITERATIONS;
+}
+
+////////////////////////////////////////////////////////////////////////
+static bool run(bool p_time, const string& p_size, const string& p_fill)
+{
+    Header  l_header;
+    Message l_full;
+    Message l_cached;
+    createHeader (l_header, "HEADER", p_time);
+    createMessage(l_full,   l_header, p_size, p_fill);
+    createMessage(l_cached, l_header, p_size, p_fill);
+    l_cached.compile();
+
+    vector<uint8_t> l_fullBuf  (l_full.getEncodedSize());
+    vector<uint8_t> l_cachedBuf(l_cached.getEncodedSize());
+    RandomGenerator l_random(1);
+
+    // Both paths must produce the same frames (when nothing is random)
+    if(!p_time && p_fill == "MESG_FILL_ZERO")
+    {
+        l_full  .encodeFull(l_fullBuf.data(),   l_fullBuf.size(),   l_random);
+        l_cached.encode    (l_cachedBuf.data(), l_cachedBuf.size(), l_random);
+        if(l_fullBuf != l_cachedBuf)
+        {
+            cerr << "Error - The cached frame differs from the encoded one." << endl;
+            return false;
+        }
+    }
+
+    volatile uint8_t l_sink = 0;
+    double l_fullNs   = measure([&]() { l_full.encodeFull(l_fullBuf.data(), l_fullBuf.size(), l_random); l_sink = l_fullBuf[0]; });
+    double l_cachedNs = measure([&]() { l_cached.encode(l_cachedBuf.data(), l_cachedBuf.size(), l_random); l_sink = l_cachedBuf[0]; });
+    double l_allocNs  = measure([&]()
+    {
+        vector<uint8_t> l_mesg(l_cached.getEncodedSize());
+        l_cached.encode(l_mesg.data(), l_mesg.size(), l_random);
+        l_sink = l_mesg[0];
+    });
+    (void)l_sink;
+
+    cout << (p_time ? "time   " : "static ") << p_fill << "\t"
+         << l_fullBuf.size() << " bytes\t"
+         << "full: "      << l_fullNs   << " ns\t"
+         << "template: "  << l_cachedNs << " ns\t"
+         << "allocated: " << l_allocNs  << " ns" << endl;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    bool l_ok = true;
+    for(auto& l_size: { "16", "256", "1400" })
+    {
+        l_ok &= run(false, l_size, "MESG_FILL_ZERO"  );
+        l_ok &= run(true,  l_size, "MESG_FILL_ZERO"  );
+        l_ok &= run(false, l_size, "MESG_FILL_RANDOM");
+    }
+
+    return l_ok ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+/*!
+ * @file   02-random.cpp
+ * @brief  Compares the generation of random payloads
+ *         (MESG_FILL_RANDOM) with the RandomGenerator and rand().
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "random_util.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const size_t TOTAL_BYTES = 64 * 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////
+template<typename F>
+static double measure(size_t p_size, F p_fill)
+{
+    size_t l_iterations = TOTAL_BYTES / p_size;
+
+    auto l_start = chrono::steady_clock::now();
+    for(size_t i = 0; i < l_iterations; i++)
+    {
+        p_fill();
+    }
+    auto l_end = chrono::steady_clock::now();
+
+    return chrono::duration<double, nano>(l_end - l_start).count() / l_iterations;
+}
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    RandomGenerator l_generator(42);
+
+    for(size_t l_size: { 100, 1000, 1400, 9000 })
+    {
+        vector<uint8_t> l_payload(l_size);
+        volatile uint8_t l_sink = 0;
+
+        double l_randNs = measure(l_size, [&]() {
+            for(size_t i = 0; i < l_size; i++) { l_payload[i] = static_cast<uint8_t>(rand() % 255); }
+            l_sink = l_payload[0];
+        });
+        double l_generatorNs = measure(l_size, [&]() {
+            l_generator.fill(l_payload.data(), l_size);
+            l_sink = l_payload[0];
+        });
+        (void)l_sink;
+
+        cout << l_size << " bytes\t"
+             << "rand(): "          << l_randNs      << " ns\t"
+             << "RandomGenerator: " << l_generatorNs << " ns\t"
+             << "(" << l_size / l_generatorNs << " GB/s)" << endl;
+    }
+
+    return 0;
+}
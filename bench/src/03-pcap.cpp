@@ -0,0 +1,78 @@
+/*!
+ * @file   03-pcap.cpp
+ * @brief  Measures the throughput of the capture file
+ *         sink (no network involved).
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FrameAggregator.h"
+#include "ModelInstance.h"
+#include "PcapSink.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const size_t FRAMES_COUNT = 200000;
+static const size_t BATCH_SIZE   = 32;
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    // The frames are sent on the route of the message of a model
+    const string l_model("bench-capture.xml");
+    {
+        ofstream l_xml(l_model);
+        l_xml << "<Conf>\n\t<Variables/>\n\t<Headers>\n\t\t<Header name=\"HEADER\">\n"
+              << "\t\t\t<Field name=\"FIELD\" pos=\"0\" size=\"8\" value=\"1\" endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/>\n"
+              << "\t\t</Header>\n\t</Headers>\n\t<Messages>\n"
+              << "\t\t<Mesg name=\"MESG\" header=\"HEADER\" size=\"4\" ip_src=\"127.0.0.1\" ip_dst=\"10.52.10.100\""
+              << " port_src=\"8000\" port_dst=\"8001\" fill=\"MESG_FILL_ZERO\"/>\n"
+              << "\t</Messages>\n\t<States>\n\t\t<State name=\"S\">\n"
+              << "\t\t\t<State_messages><State_mesg name=\"MESG\"/></State_messages>\n"
+              << "\t\t\t<Transitions><Transit dest_state=\"S\"><Delay value=\"1000\"/></Transit></Transitions>\n"
+              << "\t\t</State>\n\t</States>\n</Conf>\n";
+    }
+    ModelInstance l_instance;
+    l_instance.setup(l_model);
+    remove(l_model.c_str());
+    const ModelDefinition& l_definition = *l_instance.getDefinition();
+
+    const string l_file("bench-capture.pcap");
+
+    for(size_t l_size: { 100, 1400, 9000 })
+    {
+        vector<Frame> l_frames(BATCH_SIZE);
+        for(auto& l_frame: l_frames)
+        {
+            l_frame.data.assign(l_size, 0x5A);
+            l_frame.route = &l_definition.getRoute(0);
+        }
+
+        PcapSink l_sink;
+        l_sink.open(l_file, l_definition);
+
+        auto l_start = chrono::steady_clock::now();
+        for(size_t i = 0; i < FRAMES_COUNT; i += BATCH_SIZE)
+        {
+            l_sink.write(l_frames, i);
+        }
+        l_sink.close();
+        auto l_end = chrono::steady_clock::now();
+
+        double l_seconds = chrono::duration<double>(l_end - l_start).count();
+        cout << l_size << " bytes\t"
+             << l_sink.getFramesCount() / l_seconds         << " frames/s\t"
+             << l_sink.getBytesCount()  / l_seconds / 1e6   << " MB/s" << endl;
+    }
+
+    remove(l_file.c_str());
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*!
+ * @file   04-state-machine.cpp
+ * @brief  Compares the transitions per second of the object graph
+ *         of the model (State/Transition) with its compiled form
+ *         (CompiledModel), on the sample and on synthetic models.
+ *         The delays of the transitions are not waited.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ModelInstance.h"
+#include "CompiledModel.h"
+#include "State.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const size_t STEPS       = 2000000;
+static const size_t CHECK_STEPS = 10000;
+static const size_t VARIABLES   = 16;
+static const size_t GUARDS      = 48;
+static const size_t CONTROLS    = 4;
+
+////////////////////////////////////////////////////////////////////////
+static State* runGraph(ModelInstance& p_model, State* p_state)
+{
+    p_state->runOperations();
+    for(auto l_trans: p_state->getTransitions())
+    {
+        if(l_trans->run(p_model))
+        {
+            return l_trans->getDestState();
+        }
+    }
+    return p_state;
+}
+
+////////////////////////////////////////////////////////////////////////
+static void writeSynthetic(const string& p_file, size_t p_states)
+{
+    ofstream l_xml(p_file);
+    l_xml << "<Conf>\n\t<Variables>\n";
+    for(size_t v = 0; v < VARIABLES; v++)
+    {
+        l_xml << "\t\t<Variable name=\"VAR_" << v << "\" init=\"0\"/>\n";
+    }
+    l_xml << "\t</Variables>\n\t<Headers>\n\t\t<Header name=\"HEADER\">\n"
+          << "\t\t\t<Field name=\"FIELD\" pos=\"0\" size=\"8\" value=\"16\" endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/>\n"
+          << "\t\t</Header>\n\t</Headers>\n\t<Messages>\n"
+          << "\t\t<Mesg name=\"MESG\" header=\"HEADER\" size=\"10\" ip_src=\"127.0.0.1\" ip_dst=\"127.0.0.1\""
+          << " port_src=\"8000\" port_dst=\"8001\" fill=\"MESG_FILL_ZERO\"/>\n"
+          << "\t</Messages>\n\t<States>\n";
+
+    // A ring of states, each one testing the variable incremented by the previous one
+    for(size_t s = 0; s < p_states; s++)
+    {
+        l_xml << "\t\t<State name=\"S_" << s << "\">\n"
+              << "\t\t\t<Operations><Op var=\"VAR_" << s % VARIABLES << "\" operande=\"+\" value=\"1\"/></Operations>\n"
+              << "\t\t\t<State_messages><State_mesg name=\"MESG\"/></State_messages>\n"
+              << "\t\t\t<Transitions>\n";
+        if(s % 4 == 0)
+        {
+            l_xml << "\t\t\t\t<Loop times=\"3\" delay=\"0\"/>\n";
+        }
+        l_xml << "\t\t\t\t<Transit dest_state=\"S_0\"><Condition name=\"VAR_" << (s + 1) % VARIABLES
+              << "\" value=\"0\" operande=\"&lt;\"/></Transit>\n"
+              << "\t\t\t\t<Transit dest_state=\"S_" << (s + 1) % p_states
+              << "\"><Delay value=\"0\"/></Transit>\n"
+              << "\t\t\t</Transitions>\n\t\t</State>\n";
+    }
+    l_xml << "\t</States>\n</Conf>\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+static void writeGuarded(const string& p_file, size_t p_states)
+{
+    // Every state polls many guards on a few control variables, then moves
+    // on after a delay. A control variable changes on every cycle (the guards
+    // are checked against the object graph as they become true)
+    ofstream l_xml(p_file);
+    l_xml << "<Conf>\n\t<Variables>\n";
+    for(size_t v = 0; v < VARIABLES; v++)
+    {
+        l_xml << "\t\t<Variable name=\"VAR_" << v << "\" init=\"0\"/>\n";
+    }
+    l_xml << "\t</Variables>\n\t<Headers>\n\t\t<Header name=\"HEADER\">\n"
+          << "\t\t\t<Field name=\"FIELD\" pos=\"0\" size=\"8\" value=\"16\" endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/>\n"
+          << "\t\t</Header>\n\t</Headers>\n\t<Messages>\n"
+          << "\t\t<Mesg name=\"MESG\" header=\"HEADER\" size=\"10\" ip_src=\"127.0.0.1\" ip_dst=\"127.0.0.1\""
+          << " port_src=\"8000\" port_dst=\"8001\" fill=\"MESG_FILL_ZERO\"/>\n"
+          << "\t</Messages>\n\t<States>\n";
+
+    for(size_t s = 0; s < p_states; s++)
+    {
+        l_xml << "\t\t<State name=\"S_" << s << "\">\n"
+              << "\t\t\t<Operations><Op var=\"VAR_" << (s + 1 == p_states) << "\" operande=\"+\" value=\"1\"/></Operations>\n"
+              << "\t\t\t<State_messages><State_mesg name=\"MESG\"/></State_messages>\n"
+              << "\t\t\t<Transitions>\n";
+        if(s % 4 == 0)
+        {
+            l_xml << "\t\t\t\t<Loop times=\"3\" delay=\"0\"/>\n";
+        }
+        for(size_t g = 0; g < GUARDS; g++)
+        {
+            l_xml << "\t\t\t\t<Transit dest_state=\"S_" << (s + 1) % p_states << "\"><Condition name=\"VAR_" << 1 + g % CONTROLS
+                  << "\" value=\"" << 1 + g / CONTROLS << "\" operande=\"==\"/></Transit>\n";
+        }
+        l_xml << "\t\t\t\t<Transit dest_state=\"S_" << (s + 1) % p_states
+              << "\"><Delay value=\"0\"/></Transit>\n"
+              << "\t\t\t</Transitions>\n\t\t</State>\n";
+    }
+    l_xml << "\t</States>\n</Conf>\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+static bool measure(const string& p_name, const string& p_file)
+{
+    // The object graph runs on its own instance (the compiled model
+    // shares the variables of its instance)
+    ModelInstance l_instance;
+    ModelInstance l_reference;
+    l_instance.setup(p_file);
+    l_reference.setup(p_file);
+
+    CompiledModel& l_compiled = l_instance.getCompiled();
+
+    // Both engines must go through the same states
+    State* l_state = l_reference.getCurrState();
+    for(size_t i = 0; i < CHECK_STEPS; i++)
+    {
+        if(l_compiled.getStateName(l_compiled.nextState()) != l_state->getId())
+        {
+            cerr << p_name << ": the compiled model diverged at step " << i << endl;
+            return false;
+        }
+        l_compiled.step();
+        l_state = runGraph(l_reference, l_state);
+    }
+
+    auto l_start = chrono::steady_clock::now();
+    for(size_t i = 0; i < STEPS; i++)
+    {
+        l_state = runGraph(l_reference, l_state);
+    }
+    auto l_middle = chrono::steady_clock::now();
+    for(size_t i = 0; i < STEPS; i++)
+    {
+        l_compiled.nextState();
+        l_compiled.step();
+    }
+    auto l_end = chrono::steady_clock::now();
+
+    double l_graph = STEPS / chrono::duration<double>(l_middle - l_start).count();
+    double l_flat  = STEPS / chrono::duration<double>(l_end    - l_middle).count();
+
+    cout << p_name << "\t"
+         << l_compiled.getStatesCount()      << " states\t"
+         << l_compiled.getTransitionsCount() << " transitions\t"
+         << "object graph: " << l_graph / 1e6 << " M/s\t"
+         << "compiled: "     << l_flat  / 1e6 << " M/s\t"
+         << "(x" << l_flat / l_graph << ")" << endl;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    bool l_ok = true;
+
+    // The sample configuration is installed next to the bin directory
+    string l_sample = (argc > 1) ? argv[1] : "../data/Conf/conf_test.xml";
+    if(ifstream(l_sample).good())
+    {
+        l_ok = measure("sample", l_sample) && l_ok;
+    }
+    else
+    {
+        cout << "sample\t" << l_sample << " not found (give its path as argument)" << endl;
+    }
+
+    const string l_file("bench-synthetic.xml");
+    for(size_t l_states: { 16, 1000, 100000 })
+    {
+        writeSynthetic(l_file, l_states);
+        l_ok = measure("synthetic", l_file) && l_ok;
+    }
+    for(size_t l_states: { 16, 1000 })
+    {
+        writeGuarded(l_file, l_states);
+        l_ok = measure("guarded", l_file) && l_ok;
+    }
+    remove(l_file.c_str());
+
+    return l_ok ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+/*!
+ * @file   05-logs.cpp
+ * @brief  Measures the cost of the logs on the loop of the model:
+ *         the compiled model runs with the logs disabled, then with
+ *         a message per state at the debug trace level (2) - built as
+ *         a string or as a record (text and binary logs) - and with the
+ *         message written synchronously (as the logger used to).
+ *         The delays of the transitions are not waited.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "ModelInstance.h"
+#include "CompiledModel.h"
+#include "Logger.h"
+#include "time_util.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const size_t STEPS = 2000000;
+
+////////////////////////////////////////////////////////////////////////
+static double run(CompiledModel& p_model)
+{
+    auto l_start = chrono::steady_clock::now();
+    for(size_t i = 0; i < STEPS; i++)
+    {
+        uint32_t l_state = p_model.nextState();
+        INFO(string(p_model.getStateName(l_state)));
+        p_model.step();
+    }
+    Logger::flush();
+    auto l_end = chrono::steady_clock::now();
+
+    return STEPS / chrono::duration<double>(l_end - l_start).count();
+}
+
+////////////////////////////////////////////////////////////////////////
+static double runRecords(CompiledModel& p_model)
+{
+    auto l_start = chrono::steady_clock::now();
+    for(size_t i = 0; i < STEPS; i++)
+    {
+        uint32_t l_state = p_model.nextState();
+        LOG_RECORD(Logger::ERRORS_INFO, LOG_FMT_STATE, p_model.getStateName(l_state));
+        p_model.step();
+    }
+    Logger::flush();
+    auto l_end = chrono::steady_clock::now();
+
+    return STEPS / chrono::duration<double>(l_end - l_start).count();
+}
+
+////////////////////////////////////////////////////////////////////////
+static double runSynchronous(CompiledModel& p_model, const string& p_file)
+{
+    ofstream l_file(p_file, ios::out | ios::app);
+
+    auto l_start = chrono::steady_clock::now();
+    for(size_t i = 0; i < STEPS; i++)
+    {
+        l_file << TimeUtil::currentTime() << ":: " << p_model.getStateName(p_model.nextState()) << "\n";
+        p_model.step();
+    }
+    l_file.flush();
+    auto l_end = chrono::steady_clock::now();
+
+    return STEPS / chrono::duration<double>(l_end - l_start).count();
+}
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    // The sample configuration is installed next to the bin directory
+    string l_sample = (argc > 1) ? argv[1] : "../data/Conf/conf_test.xml";
+    if(!ifstream(l_sample).good())
+    {
+        cout << l_sample << " not found (give its path as argument)" << endl;
+        return 1;
+    }
+
+    ModelInstance l_instance;
+    l_instance.setup(l_sample);
+    CompiledModel& l_model = l_instance.getCompiled();
+
+    const string l_file("bench-logs.txt");
+    Logger::setup(l_file, Logger::NO_LOGS);
+    double l_off = run(l_model);
+
+    Logger::setTraceLevel(Logger::ERRORS_INFO_DEBUG);
+    double l_on    = run(l_model);
+    uint64_t l_drops = Logger::getDropCount();
+    double l_text  = runRecords(l_model);
+    Logger::closeLogs();
+
+    Logger::setBinary(true);
+    Logger::setup(l_file, Logger::ERRORS_INFO_DEBUG);
+    double l_binary = runRecords(l_model);
+    uint64_t l_binaryDrops = Logger::getDropCount();
+    Logger::closeLogs();
+    Logger::setBinary(false);
+
+    double l_sync = runSynchronous(l_model, l_file);
+    remove(l_file.c_str());
+
+    cout << "logs off: "     << l_off  / 1e6 << " M/s\t"
+         << "logs level 2: " << l_on   / 1e6 << " M/s\t"
+         << "(" << 100. * (l_off - l_on) / l_off << "% slower, "
+         << l_drops << " record(s) dropped)\t"
+         << "records (text): " << l_text / 1e6 << " M/s\t"
+         << "records (binary): " << l_binary / 1e6 << " M/s ("
+         << l_binaryDrops << " dropped)\t"
+         << "synchronous: "  << l_sync / 1e6 << " M/s" << endl;
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*!
+ * @file   06-conf-load.cpp
+ * @brief  Compares the load time and the peak memory (resident set)
+ *         of the streaming loader of the configuration files with the
+ *         pugixml document, on synthetic models.
+ *         Each load is done in its own process so that the peak memory
+ *         of a loader does not hide the other one.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ModelInstance.h"
+#include "CompiledModel.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const size_t VARIABLES = 16;
+
+/*!
+ * \brief The result of a load (written by the child process)
+ */
+struct LoadResult
+{
+    double   seconds;     /*!< Duration of ModelInstance::setup  */
+    uint64_t peakKb;      /*!< Peak resident set (VmHWM)         */
+    uint64_t states;      /*!< States of the model loaded        */
+    uint64_t transitions; /*!< Transitions of the model loaded   */
+};
+
+////////////////////////////////////////////////////////////////////////
+static void writeSynthetic(const string& p_file, size_t p_states)
+{
+    ofstream l_xml(p_file);
+    l_xml << "<Conf>\n\t<Variables>\n";
+    for(size_t v = 0; v < VARIABLES; v++)
+    {
+        l_xml << "\t\t<Variable name=\"VAR_" << v << "\" init=\"0\"/>\n";
+    }
+    l_xml << "\t</Variables>\n\t<Headers>\n\t\t<Header name=\"HEADER\">\n"
+          << "\t\t\t<Field name=\"FIELD\" pos=\"0\" size=\"8\" value=\"16\" endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/>\n"
+          << "\t\t</Header>\n\t</Headers>\n\t<Messages>\n"
+          << "\t\t<Mesg name=\"MESG\" header=\"HEADER\" size=\"10\" ip_src=\"127.0.0.1\" ip_dst=\"127.0.0.1\""
+          << " port_src=\"8000\" port_dst=\"8001\" fill=\"MESG_FILL_ZERO\"/>\n"
+          << "\t</Messages>\n\t<States>\n";
+
+    for(size_t s = 0; s < p_states; s++)
+    {
+        l_xml << "\t\t<State name=\"S_" << s << "\">\n"
+              << "\t\t\t<Operations><Op var=\"VAR_" << s % VARIABLES << "\" operande=\"+\" value=\"1\"/></Operations>\n"
+              << "\t\t\t<State_messages><State_mesg name=\"MESG\"/></State_messages>\n"
+              << "\t\t\t<Transitions>\n"
+              << "\t\t\t\t<Transit dest_state=\"S_0\"><Condition name=\"VAR_" << (s + 1) % VARIABLES
+              << "\" value=\"0\" operande=\"&lt;\"/></Transit>\n"
+              << "\t\t\t\t<Transit dest_state=\"S_" << (s + 1) % p_states
+              << "\"><Delay value=\"0\"/></Transit>\n"
+              << "\t\t\t</Transitions>\n\t\t</State>\n";
+    }
+    l_xml << "\t</States>\n</Conf>\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+static uint64_t peakResident()
+{
+    ifstream l_status("/proc/self/status");
+    string   l_line;
+    while(getline(l_status, l_line))
+    {
+        if(l_line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return stoull(l_line.substr(6));
+        }
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+static bool load(const string& p_file, ModelInstance::LOADER p_loader, LoadResult& p_result)
+{
+    int l_pipe[2];
+    if(pipe(l_pipe) != 0)
+    {
+        return false;
+    }
+
+    pid_t l_pid = fork();
+    if(l_pid < 0)
+    {
+        return false;
+    }
+
+    if(l_pid == 0)
+    {
+        LoadResult l_result{};
+
+        auto           l_start = chrono::steady_clock::now();
+        ModelInstance* l_model = new ModelInstance();
+        l_model->setup(p_file, p_loader);
+        l_result.seconds     = chrono::duration<double>(chrono::steady_clock::now() - l_start).count();
+        l_result.peakKb      = peakResident();
+        l_result.states      = l_model->getCompiled().getStatesCount();
+        l_result.transitions = l_model->getCompiled().getTransitionsCount();
+
+        // The model is not destroyed: the process ends
+        bool l_ok = (write(l_pipe[1], &l_result, sizeof(l_result)) == sizeof(l_result));
+        _exit(l_ok ? 0 : 1);
+    }
+
+    close(l_pipe[1]);
+    bool l_ok = (read(l_pipe[0], &p_result, sizeof(p_result)) == sizeof(p_result));
+    close(l_pipe[0]);
+
+    int l_status = 0;
+    waitpid(l_pid, &l_status, 0);
+    return l_ok && WIFEXITED(l_status) && WEXITSTATUS(l_status) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    bool l_ok = true;
+
+    const string l_file("bench-conf-load.xml");
+    for(size_t l_states: { 1000, 10000, 100000 })
+    {
+        writeSynthetic(l_file, l_states);
+
+        ifstream l_xml(l_file, ios::binary | ios::ate);
+        double   l_size = static_cast<double>(l_xml.tellg()) / (1024 * 1024);
+
+        LoadResult l_stream{};
+        LoadResult l_dom{};
+        if(!load(l_file, ModelInstance::STREAM_LOADER, l_stream) ||
+           !load(l_file, ModelInstance::DOM_LOADER,    l_dom))
+        {
+            cerr << l_states << " states: the load failed" << endl;
+            l_ok = false;
+            continue;
+        }
+
+        // Both loaders must build the same model
+        if(l_stream.states != l_dom.states || l_stream.transitions != l_dom.transitions)
+        {
+            cerr << l_states << " states: the loaders built different models" << endl;
+            l_ok = false;
+        }
+
+        cout << l_states << " states (" << l_size << " MB)\t"
+             << "stream: " << l_stream.seconds * 1000 << " ms, peak " << l_stream.peakKb / 1024 << " MB\t"
+             << "dom: "    << l_dom.seconds    * 1000 << " ms, peak " << l_dom.peakKb    / 1024 << " MB\t"
+             << "(peak x" << static_cast<double>(l_stream.peakKb) / l_dom.peakKb << ")" << endl;
+    }
+    remove(l_file.c_str());
+
+    return l_ok ? 0 : 1;
+}
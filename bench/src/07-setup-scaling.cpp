@@ -0,0 +1,146 @@
+/*!
+ * @file   07-setup-scaling.cpp
+ * @brief  Measures how the setup of a model scales with its number of
+ *         states (Cf. ConfGenerator): durations of the load of the file,
+ *         of the integrity check and of the compilation, and peak memory,
+ *         then the setup from the binary image of the compiled model
+ *         (Cf. ModelCache). Each model is loaded in its own process.
+ *         Usage: bench-07-setup-scaling [max_states] (default 1000000)
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ModelInstance.h"
+#include "CompiledModel.h"
+#include "ConfGenerator.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const uint32_t TRANSITIONS = 3;  /*!< Transitions per state */
+static const uint32_t HEADERS     = 8;  /*!< Headers               */
+static const uint32_t FIELDS      = 8;  /*!< Fields per header     */
+static const uint32_t MESSAGES    = 32; /*!< Messages              */
+
+/*!
+ * \brief The SetupResult struct is the result of a setup (written by the child process)
+ */
+struct SetupResult
+{
+    ModelInstance::SetupTimes times;       /*!< Durations of the steps of setup */
+    double                    seconds;     /*!< Duration of the whole setup     */
+    uint64_t                  peakKb;      /*!< Peak resident set (VmHWM)       */
+    uint64_t                  transitions; /*!< Transitions of the model        */
+};
+
+////////////////////////////////////////////////////////////////////////
+static uint64_t peakResident()
+{
+    ifstream l_status("/proc/self/status");
+    string   l_line;
+    while(getline(l_status, l_line))
+    {
+        if(l_line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return stoull(l_line.substr(6));
+        }
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+static bool setup(const string& p_file, const string& p_cache, SetupResult& p_result)
+{
+    int l_pipe[2];
+    if(pipe(l_pipe) != 0)
+    {
+        return false;
+    }
+
+    pid_t l_pid = fork();
+    if(l_pid < 0)
+    {
+        return false;
+    }
+
+    if(l_pid == 0)
+    {
+        SetupResult l_result{};
+
+        auto           l_start = chrono::steady_clock::now();
+        ModelInstance* l_model = new ModelInstance();
+        l_model->setCache(p_cache);
+        l_model->setup(p_file);
+        l_result.seconds     = chrono::duration<double>(chrono::steady_clock::now() - l_start).count();
+        l_result.times       = l_model->getSetupTimes();
+        l_result.peakKb      = peakResident();
+        l_result.transitions = l_model->getCompiled().getTransitionsCount();
+
+        // The model is not destroyed: the process ends
+        bool l_ok = (write(l_pipe[1], &l_result, sizeof(l_result)) == sizeof(l_result));
+        _exit(l_ok ? 0 : 1);
+    }
+
+    close(l_pipe[1]);
+    bool l_ok = (read(l_pipe[0], &p_result, sizeof(p_result)) == sizeof(p_result));
+    close(l_pipe[0]);
+
+    int l_status = 0;
+    waitpid(l_pid, &l_status, 0);
+    return l_ok && WIFEXITED(l_status) && WEXITSTATUS(l_status) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    uint64_t l_max   = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 1000000;
+    bool     l_ok    = true;
+    double   l_first = 0;
+
+    const string l_file("bench-setup-scaling.xml");
+    const string l_cache("bench-setup-scaling.cache");
+    for(uint64_t l_states = 1000; l_states <= l_max; l_states *= 10)
+    {
+        ConfGenerator(l_states, TRANSITIONS, HEADERS, FIELDS, MESSAGES).write(l_file);
+
+        // The image is built by the first setup, mapped by the second
+        SetupResult l_result{};
+        SetupResult l_mapped{};
+        remove(l_cache.c_str());
+        if(!setup(l_file, l_cache, l_result) || l_result.transitions != l_states * TRANSITIONS ||
+           !setup(l_file, l_cache, l_mapped) || l_mapped.transitions != l_states * TRANSITIONS)
+        {
+            cerr << l_states << " states: the setup failed" << endl;
+            l_ok = false;
+            break;
+        }
+
+        // Near-linear: the time per state does not grow with the size of the model
+        double l_perState = l_result.seconds * 1e6 / l_states;
+        l_first = l_first ? l_first : l_perState;
+
+        cout << l_states << " states\t"
+             << "load: "    << l_result.times.load_us    / 1000 << " ms\t"
+             << "check: "   << l_result.times.check_us   / 1000 << " ms\t"
+             << "compile: " << l_result.times.compile_us / 1000 << " ms\t"
+             << "total: "   << l_result.seconds * 1000          << " ms\t"
+             << "peak: "    << l_result.peakKb / 1024           << " MB\t"
+             << l_perState << " us/state (x" << l_perState / l_first << ")\t"
+             << "image: "   << l_mapped.seconds * 1000          << " ms ("
+             << l_mapped.peakKb / 1024 << " MB)" << endl;
+    }
+    remove(l_file.c_str());
+    remove(l_cache.c_str());
+
+    return l_ok ? 0 : 1;
+}
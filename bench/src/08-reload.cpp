@@ -0,0 +1,79 @@
+/*!
+ * @file   08-reload.cpp
+ * @brief  Reloads the same model again and again (as a configuration
+ *         reloaded periodically) and measures the resident memory after
+ *         every reload: it must not grow with the number of reloads.
+ *         Usage: bench-08-reload [reloads] (default 50)
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "ModelInstance.h"
+#include "ConfGenerator.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const uint64_t STATES     = 20000; /*!< States of the model reloaded                  */
+static const double   MAX_GROWTH = 0.01;  /*!< Growth per reload tolerated (of the memory)   */
+
+////////////////////////////////////////////////////////////////////////
+static uint64_t resident()
+{
+    ifstream l_status("/proc/self/status");
+    string   l_line;
+    while(getline(l_status, l_line))
+    {
+        if(l_line.compare(0, 6, "VmRSS:") == 0)
+        {
+            return stoull(l_line.substr(6));
+        }
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    uint32_t l_reloads = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 50;
+
+    const string l_file("bench-reload.xml");
+    ConfGenerator(STATES, 3, 8, 8, 32).write(l_file);
+
+    ModelInstance l_model;
+    uint64_t      l_first = 0;
+    uint64_t      l_last  = 0;
+    double        l_total = 0;
+    for(uint32_t r = 0; r < l_reloads; r++)
+    {
+        auto l_start = chrono::steady_clock::now();
+        l_model.setup(l_file);
+        l_total += chrono::duration<double>(chrono::steady_clock::now() - l_start).count();
+
+        // The first reload includes the blocks kept by the allocator
+        l_last  = resident();
+        l_first = (r == 1) ? l_last : l_first;
+        if(r < 2 || (r + 1) % 10 == 0)
+        {
+            cout << "reload " << r + 1 << "\tresident: " << l_last / 1024 << " MB" << endl;
+        }
+    }
+    remove(l_file.c_str());
+
+    // Leaked, every reload would add the whole model
+    double l_growth = (l_reloads > 2 && l_last > l_first) ? double(l_last - l_first) / (l_reloads - 2) : 0;
+    bool   l_ok     = (l_growth <= l_first * MAX_GROWTH);
+    cout << l_reloads << " reloads of " << STATES << " states\t"
+         << l_total * 1000 / l_reloads << " ms/reload\t"
+         << "growth: " << l_growth << " kB/reload"
+         << (l_ok ? "" : " (the memory grows with the reloads)") << endl;
+
+    return l_ok ? 0 : 1;
+}
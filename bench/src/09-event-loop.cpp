@@ -0,0 +1,133 @@
+/*!
+ * @file   09-event-loop.cpp
+ * @brief  Runs thousands of low-rate devices (instances of a model sending
+ *         one message per period) on a single thread (Cf. EventLoop), and
+ *         measures the states run per second, the lateness of the batches
+ *         and the CPU used by the thread. The devices are instances of
+ *         one definition of the model (Cf. ModelDefinition).
+ *         Usage: bench-09-event-loop [instances] [seconds] (default 10000 5)
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "ModelInstance.h"
+#include "CompiledModel.h"
+#include "EventLoop.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const uint64_t PERIOD_US = 100000; /*!< Period of a device (one message per period) */
+static const uint64_t TICK_US   = 100;    /*!< Tick of the event loop                      */
+
+////////////////////////////////////////////////////////////////////////
+static void writeDevice(const string& p_file)
+{
+    // Two states sending a message each, half a period apart
+    ofstream l_xml(p_file);
+    l_xml << "<Conf>\n\t<Variables>\n\t\t<Variable name=\"SENT\" init=\"0\"/>\n\t</Variables>\n"
+          << "\t<Headers>\n\t\t<Header name=\"HEADER\">\n"
+          << "\t\t\t<Field name=\"FIELD\" pos=\"0\" size=\"8\" value=\"16\" endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/>\n"
+          << "\t\t</Header>\n\t</Headers>\n\t<Messages>\n"
+          << "\t\t<Mesg name=\"MESG\" header=\"HEADER\" size=\"10\" ip_src=\"127.0.0.1\" ip_dst=\"127.0.0.1\""
+          << " port_src=\"8000\" port_dst=\"8001\" fill=\"MESG_FILL_ZERO\"/>\n"
+          << "\t</Messages>\n\t<States>\n";
+    for(size_t s = 0; s < 2; s++)
+    {
+        l_xml << "\t\t<State name=\"S_" << s << "\">\n"
+              << "\t\t\t<Operations><Op var=\"SENT\" operande=\"+\" value=\"1\"/></Operations>\n"
+              << "\t\t\t<State_messages><State_mesg name=\"MESG\"/></State_messages>\n"
+              << "\t\t\t<Transitions>\n"
+              << "\t\t\t\t<Transit dest_state=\"S_" << 1 - s << "\"><Delay value=\"" << PERIOD_US / 2 << "\"/></Transit>\n"
+              << "\t\t\t</Transitions>\n\t\t</State>\n";
+    }
+    l_xml << "\t</States>\n</Conf>\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+static double cpuSeconds()
+{
+    rusage l_usage;
+    getrusage(RUSAGE_SELF, &l_usage);
+    return l_usage.ru_utime.tv_sec + l_usage.ru_stime.tv_sec
+         + (l_usage.ru_utime.tv_usec + l_usage.ru_stime.tv_usec) / 1e6;
+}
+
+////////////////////////////////////////////////////////////////////////
+static uint64_t percentile(const EventLoop::Statistics& p_stats, double p_ratio)
+{
+    // Upper bound of the bucket holding the percentile
+    uint64_t l_rank = static_cast<uint64_t>(p_stats.ticks * p_ratio);
+    uint64_t l_seen = 0;
+    for(uint32_t b = 0; b < EventLoop::LATENESS_BUCKETS; b++)
+    {
+        l_seen += p_stats.histogram[b];
+        if(l_seen > l_rank)
+        {
+            return b ? uint64_t(1) << b : 0;
+        }
+    }
+    return p_stats.max_lateness;
+}
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    uint32_t l_count   = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 10000;
+    uint64_t l_seconds = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 5;
+
+    const string l_file("bench-device.xml");
+    writeDevice(l_file);
+
+    // The model is loaded once: every device is an instance of its definition
+    ModelInstance l_model;
+    EventLoop     l_loop;
+    l_model.setup(l_file);
+    l_loop.setup(TICK_US, EventLoop::DEFAULT_POLL_US);
+    remove(l_file.c_str());
+
+    // The devices are spread over the period (they do not move: the loop references them)
+    vector<CompiledModel> l_devices;
+    l_devices.reserve(l_count);
+
+    auto l_start = chrono::steady_clock::now();
+    for(uint32_t i = 0; i < l_count; i++)
+    {
+        l_devices.emplace_back(l_model.getDefinition());
+        l_loop.add(l_devices.back(), (PERIOD_US * i) / l_count);
+    }
+    double l_setup = chrono::duration<double>(chrono::steady_clock::now() - l_start).count();
+
+    uint64_t l_messages = 0;
+    double   l_cpu      = cpuSeconds();
+    l_start             = chrono::steady_clock::now();
+    l_loop.run([&](uint32_t, CompiledModel& p_device) { l_messages += p_device.getMessagesCount(); }, l_seconds * 1000000);
+    double l_wall = chrono::duration<double>(chrono::steady_clock::now() - l_start).count();
+    l_cpu         = cpuSeconds() - l_cpu;
+
+    const EventLoop::Statistics& l_stats = l_loop.getStatistics();
+    double l_expected = l_count * (l_wall * 1e6 / (PERIOD_US / 2));
+
+    cout << l_count << " devices (setup " << l_setup << " s, "
+         << sizeof(CompiledModel) + (l_count ? l_devices.front().getRuntimeSize() : 0) << " bytes each)\t"
+         << l_stats.steps / l_wall << " states/s (" << 100.0 * l_stats.steps / l_expected << "% of the expected)\t"
+         << l_messages / l_wall << " messages/s\t"
+         << "CPU " << 100.0 * l_cpu / l_wall << "%" << endl;
+    cout << l_stats.ticks << " batches (" << l_stats.late_ticks << " later than one tick)\t"
+         << "lateness: mean " << (l_stats.ticks ? l_stats.sum_lateness / l_stats.ticks : 0) << " us\t"
+         << "p50 <= " << percentile(l_stats, 0.5) << " us\t"
+         << "p99 <= " << percentile(l_stats, 0.99) << " us\t"
+         << "max " << l_stats.max_lateness << " us" << endl;
+
+    return (l_stats.steps > 0) ? 0 : 1;
+}
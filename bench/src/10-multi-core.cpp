@@ -0,0 +1,259 @@
+/*!
+ * @file   10-multi-core.cpp
+ * @brief  Measures how the frames encoded per second scale with the number
+ *         of workers (1, 2, 4... N), on two paths:
+ *         - the compiled devices of a WorkStealingRunner, on a mix of chatty
+ *           devices (no delay) and quiet ones (one state per second). The
+ *           chatty devices are all given to the first worker: the other workers
+ *           get their share by stealing. The devices are instances of two
+ *           definitions (Cf. ModelDefinition), whose messages are encoded with
+ *           the generators of the devices (whatever the worker).
+ *         - the per-state path of the MODEL API: every thread steps its own
+ *           ModelInstances through State::runOperations, the encoding of the
+ *           messages of the state and State::runTransitions.
+ *         NB : The scaling is only measured up to the number of cores: the rows
+ *              with more workers are reported as unverified.
+ *         Usage: bench-10-multi-core [max_workers] [seconds] (default cores 2)
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ModelInstance.h"
+#include "CompiledModel.h"
+#include "State.h"
+#include "EventLoop.h"
+#include "WorkStealingRunner.h"
+
+using namespace ModGen;
+using namespace std;
+
+static const uint32_t CHATTY    = 64;      /*!< Devices without delay                     */
+static const uint32_t SPACING   = 64;      /*!< One chatty device every SPACING devices   */
+static const uint64_t PERIOD_US = 1000000; /*!< Period of the quiet devices               */
+static const uint32_t FRAME     = 1400;    /*!< Size of the messages (bytes)              */
+static const uint32_t INSTANCES = 4;       /*!< ModelInstances per thread (per-state path) */
+
+/*!
+ * \brief The Counter struct counts the frames of a worker (on its own cache line)
+ */
+struct alignas(64) Counter
+{
+    uint64_t frames; /*!< Frames encoded by the worker */
+};
+
+////////////////////////////////////////////////////////////////////////
+static void writeDevice(const string& p_file, uint64_t p_delay)
+{
+    // Two states sending a random message each
+    ofstream l_xml(p_file);
+    l_xml << "<Conf>\n\t<Variables>\n\t\t<Variable name=\"SENT\" init=\"0\"/>\n\t</Variables>\n"
+          << "\t<Headers>\n\t\t<Header name=\"HEADER\">\n"
+          << "\t\t\t<Field name=\"FIELD\" pos=\"0\" size=\"8\" value=\"16\" endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/>\n"
+          << "\t\t</Header>\n\t</Headers>\n\t<Messages>\n"
+          << "\t\t<Mesg name=\"MESG\" header=\"HEADER\" size=\"" << FRAME << "\" ip_src=\"127.0.0.1\" ip_dst=\"127.0.0.1\""
+          << " port_src=\"8000\" port_dst=\"8001\" fill=\"MESG_FILL_RANDOM\"/>\n"
+          << "\t</Messages>\n\t<States>\n";
+    for(size_t s = 0; s < 2; s++)
+    {
+        l_xml << "\t\t<State name=\"S_" << s << "\">\n"
+              << "\t\t\t<Operations><Op var=\"SENT\" operande=\"+\" value=\"1\"/></Operations>\n"
+              << "\t\t\t<State_messages><State_mesg name=\"MESG\"/></State_messages>\n"
+              << "\t\t\t<Transitions>\n"
+              << "\t\t\t\t<Transit dest_state=\"S_" << 1 - s << "\"><Delay value=\"" << p_delay << "\"/></Transit>\n"
+              << "\t\t\t</Transitions>\n\t\t</State>\n";
+    }
+    l_xml << "\t</States>\n</Conf>\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+static vector<uint32_t> getWorkerCounts(uint32_t p_maxWorkers)
+{
+    // 1, 2, 4... then the maximum
+    vector<uint32_t> l_counts;
+    for(uint32_t w = 1; w < p_maxWorkers; w *= 2)
+    {
+        l_counts.push_back(w);
+    }
+    l_counts.push_back(max(p_maxWorkers, 1u));
+    return l_counts;
+}
+
+////////////////////////////////////////////////////////////////////////
+static void printRow(uint32_t p_workers, double p_rate, double p_base)
+{
+    cout << p_workers << " worker(s)\t"
+         << p_rate / 1e6 << " M frames/s\t"
+         << "(x" << (p_base ? p_rate / p_base : 0) << ")";
+    if(p_workers > thread::hardware_concurrency())
+    {
+        cout << " [unverified: " << p_workers << " workers on " << thread::hardware_concurrency() << " core(s)]";
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+static void stepStates(ModelInstance* const* p_models, uint64_t p_us, Counter& p_counter)
+{
+    vector<uint8_t> l_buffer(FRAME * 2);
+
+    // As the MODEL API: next state, operations, messages, transitions
+    auto l_end = chrono::steady_clock::now() + chrono::microseconds(p_us);
+    while(chrono::steady_clock::now() < l_end)
+    {
+        for(uint32_t i = 0; i < INSTANCES; i++)
+        {
+            ModelInstance& l_model = *p_models[i];
+            l_model.nextState();
+
+            State* l_state = l_model.getCurrState();
+            if(!l_model.isResumed())
+            {
+                l_state->runOperations();
+            }
+            if(l_model.isSent())
+            {
+                for(size_t m = 0; m < l_state->getMessagesCount(); m++)
+                {
+                    l_model.encodeMessage(m, l_buffer.data(), l_buffer.size());
+                }
+                p_counter.frames += l_state->getMessagesCount();
+            }
+            l_state->runTransitions(l_model);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    uint32_t l_maxWorkers = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10))
+                                       : max(thread::hardware_concurrency(), 1u);
+    uint64_t l_seconds    = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 2;
+
+    vector<uint32_t> l_counts = getWorkerCounts(l_maxWorkers);
+    if(thread::hardware_concurrency() < l_counts.back())
+    {
+        cout << "Scaling unverified beyond " << thread::hardware_concurrency() << " core(s): "
+             << "the rows with more workers measure workers sharing the cores, not scaling" << endl;
+    }
+
+    const string l_chatty("bench-chatty.xml");
+    const string l_quiet ("bench-quiet.xml");
+    writeDevice(l_chatty, 0);
+    writeDevice(l_quiet,  PERIOD_US / 2);
+
+    ModelInstance l_chattyModel;
+    ModelInstance l_quietModel;
+    l_chattyModel.setup(l_chatty);
+    l_quietModel.setup(l_quiet);
+
+    // Every thread of the per-state path steps its own instances
+    vector<unique_ptr<ModelInstance>> l_instances;
+    for(uint32_t i = 0; i < INSTANCES * l_counts.back(); i++)
+    {
+        l_instances.emplace_back(new ModelInstance());
+        l_instances.back()->setup(l_chatty);
+    }
+    remove(l_chatty.c_str());
+    remove(l_quiet.c_str());
+
+    // With a power of 2 of workers, the chatty devices all start on the first one
+    vector<CompiledModel> l_devices;
+    WorkStealingRunner    l_runner;
+    l_devices.reserve(CHATTY * SPACING);
+    for(uint32_t i = 0; i < CHATTY * SPACING; i++)
+    {
+        l_devices.emplace_back(((i % SPACING) ? l_quietModel : l_chattyModel).getDefinition());
+        l_runner.add(l_devices.back(), (i % SPACING) ? (PERIOD_US * i) / (CHATTY * SPACING) : 0);
+    }
+
+    bool   l_ok   = true;
+    double l_base = 0;
+    cout << "Compiled devices (WorkStealingRunner):" << endl;
+    for(uint32_t w: l_counts)
+    {
+        l_runner.setup(w, EventLoop::DEFAULT_TICK_US, EventLoop::DEFAULT_POLL_US);
+
+        // Every worker encodes into its own buffer
+        vector<vector<uint8_t>> l_buffers(w, vector<uint8_t>(FRAME * 2));
+        vector<Counter>         l_counters(w, Counter{ 0 });
+
+        auto l_start = chrono::steady_clock::now();
+        l_runner.run([&](uint32_t p_worker, uint32_t, CompiledModel& p_device)
+        {
+            for(size_t m = 0; m < p_device.getMessagesCount(); m++)
+            {
+                p_device.encodeMessage(m, l_buffers[p_worker].data(), l_buffers[p_worker].size());
+            }
+            l_counters[p_worker].frames += p_device.getMessagesCount();
+        }, l_seconds * 1000000);
+        double l_wall = chrono::duration<double>(chrono::steady_clock::now() - l_start).count();
+
+        uint64_t l_frames = 0;
+        for(auto& l_counter: l_counters)
+        {
+            l_frames += l_counter.frames;
+        }
+
+        const WorkStealingRunner::Statistics l_stats = l_runner.getStatistics();
+        double l_rate = l_frames / l_wall;
+        l_base        = l_base ? l_base : l_rate;
+
+        printRow(w, l_rate, l_base);
+        cout << "\t" << l_stats.stolen << " instances stolen\t"
+             << "lateness: mean " << (l_stats.steps ? l_stats.sum_lateness / l_stats.steps : 0) << " us, "
+             << "max " << l_stats.max_lateness << " us" << endl;
+        l_ok = (l_frames > 0) && l_ok;
+    }
+
+    l_base = 0;
+    cout << "Per-state path (" << INSTANCES << " ModelInstances per thread):" << endl;
+    for(uint32_t w: l_counts)
+    {
+        vector<Counter> l_counters(w, Counter{ 0 });
+        vector<thread>  l_threads;
+
+        auto l_start = chrono::steady_clock::now();
+        for(uint32_t t = 0; t < w; t++)
+        {
+            l_threads.emplace_back([&, t]()
+            {
+                vector<ModelInstance*> l_models;
+                for(uint32_t i = 0; i < INSTANCES; i++)
+                {
+                    l_models.push_back(l_instances[t * INSTANCES + i].get());
+                }
+                stepStates(l_models.data(), l_seconds * 1000000, l_counters[t]);
+            });
+        }
+        for(auto& l_thread: l_threads)
+        {
+            l_thread.join();
+        }
+        double l_wall = chrono::duration<double>(chrono::steady_clock::now() - l_start).count();
+
+        uint64_t l_frames = 0;
+        for(auto& l_counter: l_counters)
+        {
+            l_frames += l_counter.frames;
+        }
+
+        double l_rate = l_frames / l_wall;
+        l_base        = l_base ? l_base : l_rate;
+
+        printRow(w, l_rate, l_base);
+        cout << endl;
+        l_ok = (l_frames > 0) && l_ok;
+    }
+
+    return l_ok ? 0 : 1;
+}
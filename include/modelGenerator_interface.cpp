@@ -6,17 +6,83 @@
  * @date   23/07/2019
  */
 
+#include <memory>
+
 #include "modelGenerator_interface.h"
 #include "version_util.h"
 #include "Logger.h"
 #include "Model.h"
+#include "ModelInstance.h"
 #include "State.h"
 #include "opt_util.h"
 #include "Exception.h"
 #include "time_util.h"
+#include "Message.h"
+#include "FrameAggregator.h"
+#include "UdpSender.h"
+#include "PcapSink.h"
+#include "VariableStore.h"
+#include "Conf_format.h"
 
 using namespace ModGen;
 
+static FrameAggregator& getAggregator(void)
+{
+    static FrameAggregator l_aggregator;
+    return l_aggregator;
+}
+
+static UdpSender& getSender(void)
+{
+    static UdpSender l_sender;
+    return l_sender;
+}
+
+static PcapSink& getPcapSink(void)
+{
+    static PcapSink l_sink;
+    return l_sink;
+}
+
+static ModelInstance& getModel(ModelInstance* p_instance)
+{
+    if(!p_instance)
+    {
+        throw Exception::IntegrityCheckException<ModelInstance>("Invalid model instance");
+    }
+    return *p_instance;
+}
+
+static VariableStore& getVariables(ModelInstance* p_instance, uint32_t p_variable)
+{
+    VariableStore& l_variables = getModel(p_instance).getVariables();
+    if(p_variable >= l_variables.size())
+    {
+        throw Exception::IntegrityCheckException<VariableStore>("Invalid variable handle " + std::to_string(p_variable));
+    }
+    return l_variables;
+}
+
+static const ModelDefinition& getDefinition(void)
+{
+    auto l_definition = Model::getInstance().getDefinition();
+    if(!l_definition)
+    {
+        throw Exception::IntegrityCheckException<ModelDefinition>("The model is not set up");
+    }
+    return *l_definition;
+}
+
+static Frame& getReadyFrame(std::size_t p_index)
+{
+    auto& l_frames = getAggregator().getFrames();
+    if(p_index >= l_frames.size())
+    {
+        throw Exception::IntegrityCheckException<Frame>("No frame at index " + std::to_string(p_index));
+    }
+    return l_frames[p_index];
+}
+
 std::string ModelGeneratorAPI::VERSION::VersionCommit(void)
 {
 	return getVersionCommit();
@@ -52,6 +118,21 @@ int32_t ModelGeneratorAPI::UTIL::getDefaultTraceValue(void)
     return DEFAULT_LOGS_TRACEVAL;
 }
 
+int32_t ModelGeneratorAPI::UTIL::getDefaultSendingMethod(void)
+{
+    return DEFAULT_SENDING_METHOD;
+}
+
+uint64_t ModelGeneratorAPI::UTIL::getDefaultTimeout(void)
+{
+    return DEFAULT_AUTO_TIMEOUT;
+}
+
+uint32_t ModelGeneratorAPI::UTIL::getDefaultFrameSize(void)
+{
+    return DEFAULT_FRAME_MAXSIZE;
+}
+
 void ModelGeneratorAPI::UTIL::displayHelp(void)
 {
     display_help();
@@ -102,64 +183,443 @@ void ModelGeneratorAPI::LOGS::close(void)
     Logger::closeLogs();
 }
 
+void ModelGeneratorAPI::LOGS::flush(void)
+{
+    Logger::flush();
+}
+
+uint64_t ModelGeneratorAPI::LOGS::getDropCount(void)
+{
+    return Logger::getDropCount();
+}
+
+uint64_t ModelGeneratorAPI::LOGS::getOverflowCount(void)
+{
+    return Logger::getOverflowCount();
+}
+
+void ModelGeneratorAPI::LOGS::setBinary(bool p_binary)
+{
+    Logger::setBinary(p_binary);
+}
+
+uint64_t ModelGeneratorAPI::LOGS::decode(const std::string& p_binaryFile,
+                                         const std::string& p_textFile)
+{
+    std::ifstream l_binary(p_binaryFile, std::ios::in | std::ios::binary);
+    std::ofstream l_text  (p_textFile);
+    if(!l_binary.is_open() || !l_text.is_open())
+    {
+        throw Exception::LoggerError("Error - LOGS::decode - Unable to open " + p_binaryFile + " or " + p_textFile + ".");
+    }
+
+    return LogFormat::decode(l_binary, l_text);
+}
+
 void ModelGeneratorAPI::MODEL::create(const std::string& p_confFile)
 {
     Model::setup(p_confFile);
+
+    // The frames and routes reference the messages of the previous model
+    getAggregator().reset();
+    getSender().close();
+    getPcapSink().close();
+}
+
+void ModelGeneratorAPI::MODEL::setCache(const std::string& p_cacheFile)
+{
+    Model::setCache(p_cacheFile);
 }
 
 void ModelGeneratorAPI::MODEL::log(void)
 {
-    Model::log();
+    log(getDefaultInstance());
 }
 
 std::vector< std::vector<unsigned char> > ModelGeneratorAPI::MODEL::getMessages(void)
 {
-    return Model::getCurrState()->getMessages();
+    return getMessages(getDefaultInstance());
+}
+
+std::size_t ModelGeneratorAPI::MODEL::getMessagesCount(void)
+{
+    return getMessagesCount(getDefaultInstance());
+}
+
+uint32_t ModelGeneratorAPI::MODEL::getMessageSize(std::size_t p_index)
+{
+    return getMessageSize(getDefaultInstance(), p_index);
+}
+
+uint32_t ModelGeneratorAPI::MODEL::encodeMessage(std::size_t    p_index,
+                                                 unsigned char* p_buffer,
+                                                 std::size_t    p_capacity)
+{
+    return encodeMessage(getDefaultInstance(), p_index, p_buffer, p_capacity);
 }
 
 void ModelGeneratorAPI::MODEL::runOperations(void)
 {
-    Model::getCurrState()->runOperations();
+    runOperations(getDefaultInstance());
 }
 
 void ModelGeneratorAPI::MODEL::runTransitions(void)
 {
-    Model::getCurrState()->runTransitions();
+    runTransitions(getDefaultInstance());
 }
 
 void ModelGeneratorAPI::MODEL::nextState(void)
 {
-    Model::nextState();
+    nextState(getDefaultInstance());
+}
+
+void ModelGeneratorAPI::MODEL::setScheduling(uint64_t p_spin_us,
+                                             int32_t  p_latePolicy)
+{
+    setScheduling(getDefaultInstance(), p_spin_us, p_latePolicy);
+}
+
+uint64_t ModelGeneratorAPI::MODEL::getLateCount(void)
+{
+    return getLateCount(getDefaultInstance());
 }
 
 const std::string& ModelGeneratorAPI::MODEL::currentStateString(void)
 {
-    return Model::getCurrState()->getId();
+    return currentStateString(getDefaultInstance());
+}
+
+ModelGeneratorAPI::MODEL::VARIABLE ModelGeneratorAPI::MODEL::getVariable(const std::string& p_name)
+{
+    return getVariable(getDefaultInstance(), p_name);
+}
+
+int32_t ModelGeneratorAPI::MODEL::getVariableValue(VARIABLE p_variable)
+{
+    return getVariableValue(getDefaultInstance(), p_variable);
+}
+
+void ModelGeneratorAPI::MODEL::setVariableValue(VARIABLE p_variable,
+                                                int32_t  p_value)
+{
+    setVariableValue(getDefaultInstance(), p_variable, p_value);
+}
+
+uint32_t ModelGeneratorAPI::MODEL::getVariableVersion(VARIABLE p_variable)
+{
+    return getVariableVersion(getDefaultInstance(), p_variable);
+}
+
+bool ModelGeneratorAPI::MODEL::waitVariable(VARIABLE p_variable,
+                                            uint32_t p_version,
+                                            uint64_t p_timeout_us)
+{
+    return waitVariable(getDefaultInstance(), p_variable, p_version, p_timeout_us);
 }
 
 std::vector< std::string > ModelGeneratorAPI::MODEL::getMessagesSrcIp(void)
 {
-    return Model::getCurrState()->getMessagesSrcIP();
+    return getMessagesSrcIp(getDefaultInstance());
 }
 
 std::vector< std::string > ModelGeneratorAPI::MODEL::getMessagesDstIp(void)
 {
-    return Model::getCurrState()->getMessagesDstIP();
+    return getMessagesDstIp(getDefaultInstance());
 }
 
 std::vector< std::string > ModelGeneratorAPI::MODEL::getMessagesIntface(void)
 {
-    return Model::getCurrState()->getMessagesIntface();
+    return getMessagesIntface(getDefaultInstance());
 }
 
 std::vector< uint32_t > ModelGeneratorAPI::MODEL::getMessagesSrcPort(void)
 {
-    return Model::getCurrState()->getMessagesSrcPort();
+    return getMessagesSrcPort(getDefaultInstance());
 }
 
 std::vector< uint32_t > ModelGeneratorAPI::MODEL::getMessagesDstPort(void)
 {
-    return Model::getCurrState()->getMessagesDstPort();
+    return getMessagesDstPort(getDefaultInstance());
+}
+
+ModelGeneratorAPI::MODEL::INSTANCE ModelGeneratorAPI::MODEL::getDefaultInstance(void)
+{
+    return &Model::getInstance();
+}
+
+ModelGeneratorAPI::MODEL::INSTANCE ModelGeneratorAPI::MODEL::createInstance(const std::string& p_confFile)
+{
+    std::unique_ptr<ModelInstance> l_instance(new ModelInstance());
+    l_instance->setup(p_confFile);
+
+    return l_instance.release();
+}
+
+void ModelGeneratorAPI::MODEL::destroyInstance(INSTANCE p_instance)
+{
+    if(p_instance == &Model::getInstance())
+    {
+        throw Exception::IntegrityCheckException<ModelInstance>("The default instance of the model cannot be destroyed");
+    }
+    delete p_instance;
+}
+
+void ModelGeneratorAPI::MODEL::log(INSTANCE p_instance)
+{
+    getModel(p_instance).log();
+}
+
+std::vector< std::vector<unsigned char> > ModelGeneratorAPI::MODEL::getMessages(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    return l_model.isSent() ? l_model.encodeMessages() : std::vector< std::vector<unsigned char> >();
+}
+
+std::size_t ModelGeneratorAPI::MODEL::getMessagesCount(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    return l_model.isSent() ? l_model.getCurrState()->getMessagesCount() : 0;
+}
+
+uint32_t ModelGeneratorAPI::MODEL::getMessageSize(INSTANCE    p_instance,
+                                                  std::size_t p_index)
+{
+    return getModel(p_instance).getMessageSize(p_index);
+}
+
+uint32_t ModelGeneratorAPI::MODEL::encodeMessage(INSTANCE       p_instance,
+                                                 std::size_t    p_index,
+                                                 unsigned char* p_buffer,
+                                                 std::size_t    p_capacity)
+{
+    return getModel(p_instance).encodeMessage(p_index, p_buffer, p_capacity);
+}
+
+void ModelGeneratorAPI::MODEL::runOperations(INSTANCE p_instance)
+{
+    // A resumed state was not left: its operations were already run
+    ModelInstance& l_model = getModel(p_instance);
+    if(!l_model.isResumed())
+    {
+        l_model.getCurrState()->runOperations();
+    }
+}
+
+void ModelGeneratorAPI::MODEL::runTransitions(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    l_model.getCurrState()->runTransitions(l_model);
+}
+
+void ModelGeneratorAPI::MODEL::nextState(INSTANCE p_instance)
+{
+    getModel(p_instance).nextState();
+}
+
+void ModelGeneratorAPI::MODEL::setScheduling(INSTANCE p_instance,
+                                             uint64_t p_spin_us,
+                                             int32_t  p_latePolicy)
+{
+    getModel(p_instance).getScheduler().setup(p_spin_us, p_latePolicy);
+}
+
+uint64_t ModelGeneratorAPI::MODEL::getLateCount(INSTANCE p_instance)
+{
+    return getModel(p_instance).getScheduler().getLateCount();
+}
+
+const std::string& ModelGeneratorAPI::MODEL::currentStateString(INSTANCE p_instance)
+{
+    return getModel(p_instance).getCurrState()->getId();
+}
+
+ModelGeneratorAPI::MODEL::VARIABLE ModelGeneratorAPI::MODEL::getVariable(INSTANCE           p_instance,
+                                                                       const std::string& p_name)
+{
+    SymbolTable::ID l_id = getModel(p_instance).getSymbols().variables.find(p_name);
+    if(l_id == SymbolTable::NONE)
+    {
+        throw Exception::UnimplementedElement<Variables_format>(p_name);
+    }
+    return l_id;
+}
+
+int32_t ModelGeneratorAPI::MODEL::getVariableValue(INSTANCE p_instance,
+                                                   VARIABLE p_variable)
+{
+    return getVariables(p_instance, p_variable).get(p_variable);
+}
+
+void ModelGeneratorAPI::MODEL::setVariableValue(INSTANCE p_instance,
+                                                VARIABLE p_variable,
+                                                int32_t  p_value)
+{
+    getVariables(p_instance, p_variable).set(p_variable, p_value);
+}
+
+uint32_t ModelGeneratorAPI::MODEL::getVariableVersion(INSTANCE p_instance,
+                                                      VARIABLE p_variable)
+{
+    return getVariables(p_instance, p_variable).getVersion(p_variable);
+}
+
+bool ModelGeneratorAPI::MODEL::waitVariable(INSTANCE p_instance,
+                                            VARIABLE p_variable,
+                                            uint32_t p_version,
+                                            uint64_t p_timeout_us)
+{
+    return getVariables(p_instance, p_variable).wait(p_variable, p_version,
+                                                     std::chrono::steady_clock::now() + std::chrono::microseconds(p_timeout_us));
+}
+
+std::vector< std::string > ModelGeneratorAPI::MODEL::getMessagesSrcIp(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    return l_model.isSent() ? l_model.getCurrState()->getMessagesSrcIP() : std::vector< std::string >();
+}
+
+std::vector< std::string > ModelGeneratorAPI::MODEL::getMessagesDstIp(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    return l_model.isSent() ? l_model.getCurrState()->getMessagesDstIP() : std::vector< std::string >();
+}
+
+std::vector< std::string > ModelGeneratorAPI::MODEL::getMessagesIntface(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    return l_model.isSent() ? l_model.getCurrState()->getMessagesIntface() : std::vector< std::string >();
+}
+
+std::vector< uint32_t > ModelGeneratorAPI::MODEL::getMessagesSrcPort(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    return l_model.isSent() ? l_model.getCurrState()->getMessagesSrcPort() : std::vector< uint32_t >();
+}
+
+std::vector< uint32_t > ModelGeneratorAPI::MODEL::getMessagesDstPort(INSTANCE p_instance)
+{
+    ModelInstance& l_model = getModel(p_instance);
+    return l_model.isSent() ? l_model.getCurrState()->getMessagesDstPort() : std::vector< uint32_t >();
+}
+
+void ModelGeneratorAPI::SENDER::setup(int32_t  p_method,
+                                      uint32_t p_maxSize,
+                                      uint64_t p_timeout)
+{
+    getAggregator().setup(p_method, p_maxSize, p_timeout);
+}
+
+std::size_t ModelGeneratorAPI::SENDER::aggregate(void)
+{
+    if(Model::getInstance().isSent())
+    {
+        getAggregator().addState(Model::getInstance());
+    }
+    return getAggregator().getFrames().size();
+}
+
+std::size_t ModelGeneratorAPI::SENDER::poll(void)
+{
+    getAggregator().poll();
+    return getAggregator().getFrames().size();
+}
+
+uint64_t ModelGeneratorAPI::SENDER::getTimeLeft(void)
+{
+    return getAggregator().getTimeLeft();
+}
+
+std::size_t ModelGeneratorAPI::SENDER::flush(void)
+{
+    getAggregator().flush();
+    return getAggregator().getFrames().size();
+}
+
+std::size_t ModelGeneratorAPI::SENDER::getFramesCount(void)
+{
+    return getAggregator().getFrames().size();
+}
+
+const std::vector<unsigned char>& ModelGeneratorAPI::SENDER::getFrame(std::size_t p_index)
+{
+    return getReadyFrame(p_index).data;
+}
+
+const std::vector<uint32_t>& ModelGeneratorAPI::SENDER::getFrameBoundaries(std::size_t p_index)
+{
+    return getReadyFrame(p_index).boundaries;
+}
+
+std::string ModelGeneratorAPI::SENDER::getFrameSrcIp(std::size_t p_index)
+{
+    return getReadyFrame(p_index).route->src_ip;
+}
+
+std::string ModelGeneratorAPI::SENDER::getFrameDstIp(std::size_t p_index)
+{
+    return getReadyFrame(p_index).route->dst_ip;
+}
+
+std::string ModelGeneratorAPI::SENDER::getFrameIntface(std::size_t p_index)
+{
+    return getReadyFrame(p_index).route->interface;
+}
+
+uint32_t ModelGeneratorAPI::SENDER::getFrameSrcPort(std::size_t p_index)
+{
+    return getReadyFrame(p_index).route->src_port;
+}
+
+uint32_t ModelGeneratorAPI::SENDER::getFrameDstPort(std::size_t p_index)
+{
+    return getReadyFrame(p_index).route->dst_port;
+}
+
+void ModelGeneratorAPI::SENDER::clearFrames(void)
+{
+    getAggregator().clearFrames();
+}
+
+void ModelGeneratorAPI::SENDER::open(void)
+{
+    getSender().setup(getDefinition());
+}
+
+void ModelGeneratorAPI::SENDER::openPcap(const std::string& p_filePath)
+{
+    getPcapSink().open(p_filePath, getDefinition());
+}
+
+std::size_t ModelGeneratorAPI::SENDER::send(void)
+{
+    std::size_t l_sent = 0;
+    if(getPcapSink().isOpened())
+    {
+        l_sent = getPcapSink().write(getAggregator().getFrames());
+    }
+    else
+    {
+        l_sent = getSender().send(getAggregator().getFrames());
+    }
+    getAggregator().clearFrames();
+
+    return l_sent;
+}
+
+void ModelGeneratorAPI::SENDER::close(void)
+{
+    getSender().close();
+    getPcapSink().close();
+}
+
+uint64_t ModelGeneratorAPI::SENDER::getSentFramesCount(void)
+{
+    return getSender().getFramesCount() + getPcapSink().getFramesCount();
+}
+
+uint64_t ModelGeneratorAPI::SENDER::getSyscallsCount(void)
+{
+    return getSender().getSyscallsCount();
 }
 
 uint64_t ModelGeneratorAPI::TIME::getDIANE(uint64_t &p_time_today_us)
@@ -175,4 +635,19 @@ uint64_t ModelGeneratorAPI::TIME::getDIANEValue(const uint64_t p_time_us)
     HHR_DIANE_Time l_diane(p_time_us);
 
     return l_diane.toInt();
-}
\ No newline at end of file
+}
+
+void ModelGeneratorAPI::TIME::startVirtualClock(uint64_t p_start_us)
+{
+    TimeUtil::startVirtual(p_start_us);
+}
+
+void ModelGeneratorAPI::TIME::stopVirtualClock(void)
+{
+    TimeUtil::stopVirtual();
+}
+
+uint64_t ModelGeneratorAPI::TIME::getVirtualTime(void)
+{
+    return TimeUtil::virtual_microseconds();
+}
@@ -14,6 +14,11 @@
 #include <string>
 #include <vector>
 
+namespace ModGen
+{
+    class ModelInstance;
+}
+
 //! Library access interface
 namespace ModelGeneratorAPI
 {
@@ -60,6 +65,24 @@ namespace ModelGeneratorAPI
          */
         int32_t getDefaultTraceValue(void);
 
+        /*!
+         * \brief getDefaultSendingMethod
+         * \return the default sending method (Cf. SENDER::setup)
+         */
+        int32_t getDefaultSendingMethod(void);
+
+        /*!
+         * \brief getDefaultTimeout
+         * \return the default timeout (us) of the AUTO sending method
+         */
+        uint64_t getDefaultTimeout(void);
+
+        /*!
+         * \brief getDefaultFrameSize
+         * \return the default maximum size (bytes) of a frame
+         */
+        uint32_t getDefaultFrameSize(void);
+
         /*!
          * \brief displayHelp displays the available options of the command
          *        line regarding the modelGenerator library.
@@ -146,6 +169,43 @@ namespace ModelGeneratorAPI
          *        already handles it.
          */
         void close(void);
+
+        /*!
+         * \brief flush waits until every message written so far
+         *        is in the log file (the messages are written
+         *        by a background thread).
+         */
+        void flush(void);
+
+        /*!
+         * \brief getDropCount
+         * \return the number of messages dropped because too many
+         *         messages were waiting to be written.
+         */
+        uint64_t getDropCount(void);
+
+        /*!
+         * \brief getOverflowCount
+         * \return the number of messages truncated because of their size.
+         */
+        uint64_t getOverflowCount(void);
+
+        /*!
+         * \brief setBinary selects the format of the log files
+         *        (applied by the next call to setup).
+         * \param p_binary true to write the logs in binary (faster,
+         *        Cf. decode), false to write them as text (default).
+         */
+        void setBinary(bool p_binary);
+
+        /*!
+         * \brief decode renders a binary log file as text logs.
+         * \param p_binaryFile the binary log file.
+         * \param p_textFile the text log file to create.
+         * \return the number of messages decoded.
+         */
+        uint64_t decode(const std::string& p_binaryFile,
+                        const std::string& p_textFile);
     }
 
     //! Model informations access interface
@@ -153,10 +213,22 @@ namespace ModelGeneratorAPI
     {
         /*!
          * \brief create creates a model from an xml configuration file
+         *        (the frames of the previous model are dropped - Cf. SENDER).
          * \param p_confFile the xml conf file path
          */
         void create(const std::string& p_confFile);
 
+        /*!
+         * \brief setCache sets the binary image of the compiled model, mapped by
+         *        create instead of loading the xml conf file while the file is
+         *        unchanged (the image is rebuilt otherwise).
+         *        NB : The xml conf file is only loaded when the states of the
+         *             model are first used (nextState, runOperations...): the
+         *             compiled instances and the variables do not need it.
+         * \param p_cacheFile the image file path (empty to disable the cache)
+         */
+        void setCache(const std::string& p_cacheFile);
+
         /*!
          * \brief log logs the created Model using the \a Logger
          *        NB: This will log the state of the message only if
@@ -167,10 +239,40 @@ namespace ModelGeneratorAPI
         /*!
          * \brief getMessages returns the messages associated to
          *        the current state of the model.
+         *        NB : A waiting state run again after its timeout (without
+         *             having been left) has no message, unless it is resent
+         *             (resend attribute) - the same holds for the other getters
+         *             of the messages and for SENDER::aggregate.
          * \return the messages associated to the current state of the model.
          */
         std::vector< std::vector<unsigned char> > getMessages(void);
 
+        /*!
+         * \brief getMessagesCount
+         * \return the number of messages associated to the current state of the model.
+         */
+        std::size_t getMessagesCount(void);
+
+        /*!
+         * \brief getMessageSize
+         * \param p_index the index of the message in the current state (Cf. getMessages).
+         * \return the exact size (bytes) of the message once encoded.
+         */
+        uint32_t getMessageSize(std::size_t p_index);
+
+        /*!
+         * \brief encodeMessage encodes a message of the current state of the model
+         *        into a caller-owned buffer, without any allocation.
+         * \param p_index the index of the message in the current state (Cf. getMessages).
+         * \param p_buffer the buffer to write the message to.
+         * \param p_capacity the size (bytes) of the buffer.
+         * \return the number of bytes written.
+         *         Throws if the buffer is too small (Cf. getMessageSize).
+         */
+        uint32_t encodeMessage(std::size_t    p_index,
+                               unsigned char* p_buffer,
+                               std::size_t    p_capacity);
+
         /*!
          * \brief getMessagesSrcIp returns the list of the source ips
          *       associated to the messages to be sent in the current state of the model.
@@ -209,6 +311,8 @@ namespace ModelGeneratorAPI
         /*!
          * \brief runOperations runs the operations of the current state of
          *        the model. Operations modify the variables of the model.
+         *        They are not run again when a waiting state is run again after
+         *        its timeout (Cf. getMessages).
          */
         void runOperations(void);
 
@@ -224,11 +328,305 @@ namespace ModelGeneratorAPI
          */
         void nextState(void);
 
+        /*!
+         * \brief setScheduling sets how the delays of the transitions are waited.
+         *        The delays are counted from the previous deadline, not from the
+         *        time the transition is run, so that they do not drift.
+         * \param p_spin_us the time (us) spent spinning before each deadline (0 to only sleep).
+         * \param p_latePolicy the behaviour when a deadline has already passed:
+         * <ul>
+         * <li> 0 : Catch up - do not wait, the next delays are shortened
+         *          (by one period at most: the deadlines are counted from now beyond)
+         * <li> 1 : Skip - wait for the next deadline, the missed periods are dropped
+         * <li> 2 : Rebase - do not wait, the next deadlines are counted from now
+         * </ul>
+         */
+        void setScheduling(uint64_t p_spin_us,
+                           int32_t  p_latePolicy);
+
+        /*!
+         * \brief getLateCount
+         * \return the number of deadlines which had already passed when waited.
+         */
+        uint64_t getLateCount(void);
+
         /*!
          * \brief currentStateString
          * \return the current state name of the model.
          */
         const std::string& currentStateString(void);
+
+        /*!
+         * \brief VARIABLE is the handle of a variable of the model (Cf. getVariable).
+         *        The variables can be read, written and waited for from any thread
+         *        while the model runs (i.e. by an external control system driving
+         *        the conditions of the transitions).
+         *        The handles are valid until the model is created again.
+         */
+        typedef uint32_t VARIABLE;
+
+        /*!
+         * \brief getVariable
+         * \param p_name the name of the variable.
+         * \return the handle of the variable (throws if the model has no such variable).
+         */
+        VARIABLE getVariable(const std::string& p_name);
+
+        /*!
+         * \brief getVariableValue
+         * \param p_variable the handle of the variable.
+         * \return the current value of the variable.
+         */
+        int32_t getVariableValue(VARIABLE p_variable);
+
+        /*!
+         * \brief setVariableValue sets the value of a variable
+         *        (the threads waiting for the variable are woken up).
+         * \param p_variable the handle of the variable.
+         * \param p_value the value.
+         */
+        void setVariableValue(VARIABLE p_variable,
+                              int32_t  p_value);
+
+        /*!
+         * \brief getVariableVersion
+         * \param p_variable the handle of the variable.
+         * \return the version of the variable, incremented by every change.
+         */
+        uint32_t getVariableVersion(VARIABLE p_variable);
+
+        /*!
+         * \brief waitVariable blocks until a variable changes.
+         * \param p_variable the handle of the variable.
+         * \param p_version the version the variable had (Cf. getVariableVersion).
+         * \param p_timeout_us the maximum time (us) to wait.
+         * \return true if the variable changed, false on timeout.
+         */
+        bool waitVariable(VARIABLE p_variable,
+                          uint32_t p_version,
+                          uint64_t p_timeout_us);
+
+        /*!
+         * \brief INSTANCE is the handle of a model instance.
+         *        Every instance owns its own states, messages, variables and scheduler
+         *        so that several automatons (i.e. simulated devices) can run in the same
+         *        process - each instance being used by one thread at a time (except for
+         *        its variables, Cf. VARIABLE).
+         *        The functions above operate on the default instance (Cf. getDefaultInstance).
+         */
+        typedef ModGen::ModelInstance* INSTANCE;
+
+        /*!
+         * \brief getDefaultInstance
+         * \return the handle of the default instance of the model (Cf. create).
+         */
+        INSTANCE getDefaultInstance(void);
+
+        /*!
+         * \brief createInstance creates a new model instance from an xml configuration file.
+         *        The frames of the SENDER are left untouched.
+         * \param p_confFile the xml conf file path
+         * \return the handle of the instance, to be released with destroyInstance.
+         */
+        INSTANCE createInstance(const std::string& p_confFile);
+
+        /*!
+         * \brief destroyInstance releases a model instance created by createInstance.
+         * \param p_instance the handle of the instance (not usable afterwards).
+         */
+        void destroyInstance(INSTANCE p_instance);
+
+        /*!
+         * \brief The following functions are the same as above, operating on the
+         *        given model instance rather than on the default one.
+         * \param p_instance the handle of the instance.
+         */
+        void log(INSTANCE p_instance);
+        std::vector< std::vector<unsigned char> > getMessages(INSTANCE p_instance);
+        std::size_t getMessagesCount(INSTANCE p_instance);
+        uint32_t getMessageSize(INSTANCE    p_instance,
+                                std::size_t p_index);
+        uint32_t encodeMessage(INSTANCE       p_instance,
+                               std::size_t    p_index,
+                               unsigned char* p_buffer,
+                               std::size_t    p_capacity);
+        std::vector< std::string > getMessagesSrcIp(INSTANCE p_instance);
+        std::vector< std::string > getMessagesDstIp(INSTANCE p_instance);
+        std::vector< std::string > getMessagesIntface(INSTANCE p_instance);
+        std::vector< uint32_t > getMessagesSrcPort(INSTANCE p_instance);
+        std::vector< uint32_t > getMessagesDstPort(INSTANCE p_instance);
+        void runOperations(INSTANCE p_instance);
+        void runTransitions(INSTANCE p_instance);
+        void nextState(INSTANCE p_instance);
+        void setScheduling(INSTANCE p_instance,
+                           uint64_t p_spin_us,
+                           int32_t  p_latePolicy);
+        uint64_t getLateCount(INSTANCE p_instance);
+        const std::string& currentStateString(INSTANCE p_instance);
+        VARIABLE getVariable(INSTANCE           p_instance,
+                             const std::string& p_name);
+        int32_t getVariableValue(INSTANCE p_instance,
+                                 VARIABLE p_variable);
+        void setVariableValue(INSTANCE p_instance,
+                              VARIABLE p_variable,
+                              int32_t  p_value);
+        uint32_t getVariableVersion(INSTANCE p_instance,
+                                    VARIABLE p_variable);
+        bool waitVariable(INSTANCE p_instance,
+                          VARIABLE p_variable,
+                          uint32_t p_version,
+                          uint64_t p_timeout_us);
+    }
+
+    //! Frames packing interface
+    namespace SENDER
+    {
+        /*!
+         * \brief setup sets the sending method used to pack the messages into frames.
+         *        The frames not yet retrieved are dropped.
+         * \param p_method the sending method:
+         * <ul>
+         * <li> 0 : SIMPLE - one message per frame
+         * <li> 1 : Smart Multiplex - the messages of a state sharing the same
+         *          source and destination are packed together
+         * <li> 2 : Full Multiplex - the messages of consecutive states are packed together
+         * <li> 3 : AUTO - Full Multiplex, a frame is also sent when its timeout expires
+         * </ul>
+         * \param p_maxSize the maximum size (bytes) of a frame.
+         * \param p_timeout the timeout (us) of the AUTO method.
+         */
+        void setup(int32_t  p_method,
+                   uint32_t p_maxSize,
+                   uint64_t p_timeout);
+
+        /*!
+         * \brief aggregate packs the messages of the current state of the model.
+         * \return the number of frames ready to be sent.
+         */
+        std::size_t aggregate(void);
+
+        /*!
+         * \brief poll makes ready the pending frames whose timeout has expired
+         *        (AUTO method) without any new message - Ex/ while the model
+         *        waits for a delay (Cf. getTimeLeft).
+         * \return the number of frames ready to be sent.
+         */
+        std::size_t poll(void);
+
+        /*!
+         * \brief getTimeLeft
+         * \return the time (us) before the timeout of the first pending frame
+         *         expires (Cf. poll) - 0 if it has expired, UINT64_MAX if
+         *         no frame waits for a timeout.
+         */
+        uint64_t getTimeLeft(void);
+
+        /*!
+         * \brief flush makes every pending frame ready to be sent
+         *        (Ex/ before stopping the model).
+         * \return the number of frames ready to be sent.
+         */
+        std::size_t flush(void);
+
+        /*!
+         * \brief getFramesCount
+         * \return the number of frames ready to be sent.
+         */
+        std::size_t getFramesCount(void);
+
+        /*!
+         * \brief getFrame
+         * \param p_index the index of the frame (Cf. getFramesCount).
+         * \return the data of the frame.
+         */
+        const std::vector<unsigned char>& getFrame(std::size_t p_index);
+
+        /*!
+         * \brief getFrameBoundaries
+         * \param p_index the index of the frame (Cf. getFramesCount).
+         * \return the offset (bytes) of every message in the frame.
+         */
+        const std::vector<uint32_t>& getFrameBoundaries(std::size_t p_index);
+
+        /*!
+         * \brief getFrameSrcIp
+         * \param p_index the index of the frame (Cf. getFramesCount).
+         * \return the source ip of the frame.
+         */
+        std::string getFrameSrcIp(std::size_t p_index);
+
+        /*!
+         * \brief getFrameDstIp
+         * \param p_index the index of the frame (Cf. getFramesCount).
+         * \return the destination ip of the frame.
+         */
+        std::string getFrameDstIp(std::size_t p_index);
+
+        /*!
+         * \brief getFrameIntface
+         * \param p_index the index of the frame (Cf. getFramesCount).
+         * \return the network interface of the frame.
+         */
+        std::string getFrameIntface(std::size_t p_index);
+
+        /*!
+         * \brief getFrameSrcPort
+         * \param p_index the index of the frame (Cf. getFramesCount).
+         * \return the source port of the frame.
+         */
+        uint32_t getFrameSrcPort(std::size_t p_index);
+
+        /*!
+         * \brief getFrameDstPort
+         * \param p_index the index of the frame (Cf. getFramesCount).
+         * \return the destination port of the frame.
+         */
+        uint32_t getFrameDstPort(std::size_t p_index);
+
+        /*!
+         * \brief clearFrames drops the frames ready to be sent
+         *        once they have been retrieved.
+         */
+        void clearFrames(void);
+
+        /*!
+         * \brief open resolves the addresses of the messages of the model and
+         *        binds a UDP socket for every (source ip, source port, interface).
+         *        Throws if an address cannot be resolved or a socket cannot be bound.
+         */
+        void open(void);
+
+        /*!
+         * \brief openPcap writes the frames into a pcap capture file instead of
+         *        sending them (Cf. send). Throws if the file cannot be created.
+         * \param p_filePath the path of the capture file.
+         */
+        void openPcap(const std::string& p_filePath);
+
+        /*!
+         * \brief send sends the frames ready to be sent to their destination
+         *        (one system call per socket when available) and drops them.
+         *        The frames are written to the capture file instead if one is opened.
+         * \return the number of frames successfully sent.
+         */
+        std::size_t send(void);
+
+        /*!
+         * \brief close closes the sockets opened by open and the capture file.
+         */
+        void close(void);
+
+        /*!
+         * \brief getSentFramesCount
+         * \return the number of frames sent (or written) since open.
+         */
+        uint64_t getSentFramesCount(void);
+
+        /*!
+         * \brief getSyscallsCount
+         * \return the number of system calls used to send the frames since open.
+         */
+        uint64_t getSyscallsCount(void);
     }
 
     /*!
@@ -251,6 +649,25 @@ namespace ModelGeneratorAPI
          * \return the HHR DIANE format of the specified duration p_time_us.
          */
         uint64_t getDIANEValue(const uint64_t p_time_us);
+
+        /*!
+         * \brief startVirtualClock makes the calling thread run on a virtual clock:
+         *        the delays of the transitions advance it instead of being waited,
+         *        and the time fields of the messages read it.
+         * \param p_start_us the start time (us since epoch) of the virtual clock.
+         */
+        void startVirtualClock(uint64_t p_start_us);
+
+        /*!
+         * \brief stopVirtualClock makes the calling thread run on the system clock again.
+         */
+        void stopVirtualClock(void);
+
+        /*!
+         * \brief getVirtualTime
+         * \return the time (us) ellapsed on the virtual clock of the calling thread.
+         */
+        uint64_t getVirtualTime(void);
     }
 }
 
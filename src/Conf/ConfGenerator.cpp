@@ -0,0 +1,100 @@
+/*!
+ * @file   ConfGenerator.cpp
+ * @brief  Implementations of the functions defined in \a ConfGenerator.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <algorithm>
+#include <fstream>
+
+#include "ConfGenerator.h"
+#include "Exception.h"
+#include "Logger.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+ConfGenerator::ConfGenerator(uint64_t p_states,
+                             uint32_t p_transitions,
+                             uint32_t p_headers,
+                             uint32_t p_fields,
+                             uint32_t p_messages,
+                             uint32_t p_variables) :
+    states     (max<uint64_t>(p_states,      1)),
+    transitions(max<uint32_t>(p_transitions, 1)),
+    headers    (max<uint32_t>(p_headers,     1)),
+    fields     (max<uint32_t>(p_fields,      1)),
+    messages   (max<uint32_t>(p_messages,    1)),
+    variables  (max<uint32_t>(p_variables,   1))
+{}
+
+////////////////////////////////////////////////////////////////////////
+void ConfGenerator::write(ostream& p_out) const
+{
+    p_out << "<Conf>\n\t<Variables>\n";
+    for(uint32_t v = 0; v < variables; v++)
+    {
+        p_out << "\t\t<Variable name=\"VAR_" << v << "\" init=\"0\"/>\n";
+    }
+
+    p_out << "\t</Variables>\n\t<Headers>\n";
+    for(uint32_t h = 0; h < headers; h++)
+    {
+        p_out << "\t\t<Header name=\"HEADER_" << h << "\">\n";
+        for(uint32_t f = 0; f < fields; f++)
+        {
+            p_out << "\t\t\t<Field name=\"FIELD_" << f << "\" pos=\"" << f * 8 << "\" size=\"8\" value=\"" << (h + f) % 256
+                  << "\" endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/>\n";
+        }
+        p_out << "\t\t</Header>\n";
+    }
+
+    p_out << "\t</Headers>\n\t<Messages>\n";
+    for(uint32_t m = 0; m < messages; m++)
+    {
+        p_out << "\t\t<Mesg name=\"MESG_" << m << "\" header=\"HEADER_" << m % headers << "\" size=\"" << 16 + m % 64
+              << "\" ip_src=\"127.0.0.1\" ip_dst=\"127.0.0.1\" port_src=\"" << 8000 + m % 1000
+              << "\" port_dst=\"" << 9000 + m % 1000 << "\" fill=\"MESG_FILL_ZERO\"/>\n";
+    }
+
+    p_out << "\t</Messages>\n\t<States>\n";
+    for(uint64_t s = 0; s < states; s++)
+    {
+        p_out << "\t\t<State name=\"S_" << s << "\">\n"
+              << "\t\t\t<Operations><Op var=\"VAR_" << s % variables << "\" operande=\"+\" value=\"1\"/></Operations>\n"
+              << "\t\t\t<State_messages><State_mesg name=\"MESG_" << s % messages << "\"/></State_messages>\n"
+              << "\t\t\t<Transitions>\n";
+
+        // The destinations of the conditions are spread over the whole model
+        for(uint32_t t = 1; t < transitions; t++)
+        {
+            p_out << "\t\t\t\t<Transit dest_state=\"S_" << (s * 2654435761ull + t * 40503ull) % states
+                  << "\"><Condition name=\"VAR_" << (s + t) % variables << "\" value=\"" << 1000000 + t
+                  << "\" operande=\"" << ((t % 2) ? "==" : ">") << "\"/></Transit>\n";
+        }
+        p_out << "\t\t\t\t<Transit dest_state=\"S_" << (s + 1) % states << "\"><Delay value=\"1000\"/></Transit>\n"
+              << "\t\t\t</Transitions>\n\t\t</State>\n";
+    }
+    p_out << "\t</States>\n</Conf>\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfGenerator::write(const string& p_filePath) const
+{
+    ofstream l_file(p_filePath);
+    if(l_file.is_open())
+    {
+        write(l_file);
+    }
+
+    if(!l_file.is_open() || !l_file.flush())
+    {
+        ERROR("Error - Unable to write the configuration file " + p_filePath + ".");
+        throw Exception::ParsingFileError("Unable to write the configuration file " + p_filePath + ".");
+    }
+}
+
+} // namespace ModGen
@@ -0,0 +1,71 @@
+/*!
+ * @file   ConfGenerator.h
+ * @brief  Contains the generator of synthetic configuration files
+ *         (used to measure how the load of a model scales).
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef CONFGENERATOR_MODELGENERATOR
+#define CONFGENERATOR_MODELGENERATOR
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ModGen {
+
+/*!
+ * \brief The ConfGenerator class writes a valid configuration file of the
+ *        requested size.
+ *        Every state operates on a variable, sends a message and has
+ *        \a transitions transitions: conditions on the variables towards
+ *        pseudo-random states, then a delay towards the next state (the
+ *        states form a ring, every one of them is reachable).
+ *        Every message references a header, every header has \a fields
+ *        fields of 8 bits.
+ */
+class ConfGenerator
+{
+public:
+    /*!
+     * \brief ConfGenerator constructor
+     * \param p_states the number of states (N).
+     * \param p_transitions the number of transitions per state (M >= 1).
+     * \param p_headers the number of headers (K >= 1).
+     * \param p_fields the number of fields per header (>= 1).
+     * \param p_messages the number of messages (J >= 1).
+     * \param p_variables the number of variables (>= 1).
+     */
+    ConfGenerator(uint64_t p_states,
+                  uint32_t p_transitions,
+                  uint32_t p_headers,
+                  uint32_t p_fields,
+                  uint32_t p_messages,
+                  uint32_t p_variables = 16);
+
+    /*!
+     * \brief write writes the configuration.
+     * \param p_out the stream to write to.
+     */
+    void write(std::ostream& p_out) const;
+
+    /*!
+     * \brief write writes the configuration into a file.
+     * \param p_filePath the path of the file.
+     * NB : Throws a ParsingFileError if the file cannot be written.
+     */
+    void write(const std::string& p_filePath) const;
+
+private:
+    uint64_t states;      /*!< Number of states               */
+    uint32_t transitions; /*!< Number of transitions per state */
+    uint32_t headers;     /*!< Number of headers              */
+    uint32_t fields;      /*!< Number of fields per header    */
+    uint32_t messages;    /*!< Number of messages             */
+    uint32_t variables;   /*!< Number of variables            */
+};
+
+} // namespace ModGen
+
+#endif // CONFGENERATOR_MODELGENERATOR
@@ -0,0 +1,437 @@
+/*!
+ * @file   ConfReader.cpp
+ * @brief  Implementations of the functions defined in \a ConfReader.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "ConfReader.h"
+#include "Exception.h"
+#include "Logger.h"
+
+namespace ModGen {
+
+using namespace std;
+
+/*!
+ * \brief Classes of the characters of the file (one bit per class)
+ */
+static const uint8_t CHAR_SPACE     = 0x01; /*!< White space                         */
+static const uint8_t CHAR_DELIMITER = 0x02; /*!< Ends a name                         */
+static const uint8_t CHAR_SPECIAL   = 0x04; /*!< Not copied as is in attribute values */
+
+////////////////////////////////////////////////////////////////////////
+static const uint8_t* charClasses()
+{
+    static const struct Table
+    {
+        uint8_t classes[256];
+        Table() : classes()
+        {
+            for(int c = 0; c < 256; c++)
+            {
+                if(isspace(c))                     { classes[c] |= CHAR_SPACE | CHAR_DELIMITER; }
+                if(c && strchr("=/<>\"'", c))      { classes[c] |= CHAR_DELIMITER;              }
+                if(c && strchr("&<\"'\r\n\t", c))  { classes[c] |= CHAR_SPECIAL;                }
+            }
+            classes[0] |= CHAR_DELIMITER;
+        }
+    } l_table;
+
+    return l_table.classes;
+}
+
+////////////////////////////////////////////////////////////////////////
+static inline bool is(char p_char, uint8_t p_class)
+{
+    return charClasses()[static_cast<unsigned char>(p_char)] & p_class;
+}
+
+////////////////////////////////////////////////////////////////////////
+ConfReader::ConfReader(const string& p_filePath) :
+    file(nullptr),
+    buffer(BLOCK_SIZE),
+    position(0),
+    size(0),
+    offset(0),
+    name(),
+    attributes(),
+    count(0),
+    opened(),
+    depth(0),
+    closing(false)
+{
+    file = fopen(p_filePath.c_str(), "rb");
+    if(!file)
+    {
+        ERROR("Error - Unable to open the configuration file " + p_filePath + ".");
+        throw Exception::ParsingFileError("Unable to open the configuration file " + p_filePath + ".");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+ConfReader::~ConfReader()
+{
+    if(file)
+    {
+        fclose(file);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ConfReader::fill()
+{
+    size     = fread(buffer.data(), 1, buffer.size(), file);
+    position = 0;
+    return size > 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+ConfReader::EVENT ConfReader::next()
+{
+    // A self-closing tag is returned as a start and an end tag
+    if(closing)
+    {
+        closing = false;
+        depth   = opened.size() + 1;
+        return END_ELEMENT;
+    }
+
+    while(true)
+    {
+        // The texts between the tags are skipped (block by block)
+        int l_char = EOF;
+        while(position < size || fill())
+        {
+            const char* l_start = buffer.data() + position;
+            const char* l_tag   = static_cast<const char*>(memchr(l_start, '<', size - position));
+            if(l_tag)
+            {
+                offset  += static_cast<uint64_t>(l_tag - l_start);
+                position = static_cast<size_t>(l_tag - buffer.data());
+                l_char   = get();
+                break;
+            }
+            offset  += size - position;
+            position = size;
+        }
+
+        if(l_char == EOF)
+        {
+            if(!opened.empty())
+            {
+                error("Unexpected end of file - the element " + opened.back() + " is not closed.");
+            }
+            name.clear();
+            depth = 0;
+            return END_OF_FILE;
+        }
+
+        l_char = peek();
+        if(l_char == '?')
+        {
+            skipUntil("?>");
+        }
+        else if(l_char == '!')
+        {
+            get();
+            if(peek() == '-')
+            {
+                expect('-');
+                expect('-');
+                skipUntil("-->");
+            }
+            else if(peek() == '[')
+            {
+                skipUntil("]]>");
+            }
+            else
+            {
+                // Document type (the internal subset is not supported)
+                skipUntil(">");
+            }
+        }
+        else if(l_char == '/')
+        {
+            get();
+            readName(name);
+            if(skipSpaces() != '>')
+            {
+                error("Invalid end tag " + name + ".");
+            }
+            get();
+
+            if(opened.empty() || opened.back() != name)
+            {
+                error("Unexpected end tag " + name + ".");
+            }
+            depth = opened.size();
+            opened.pop_back();
+            return END_ELEMENT;
+        }
+        else
+        {
+            readName(name);
+
+            count = 0;
+            while(true)
+            {
+                l_char = skipSpaces();
+                if(l_char == '>')
+                {
+                    get();
+                    break;
+                }
+                if(l_char == '/')
+                {
+                    get();
+                    expect('>');
+                    closing = true;
+                    break;
+                }
+
+                if(count == attributes.size())
+                {
+                    attributes.emplace_back();
+                }
+                readName(attributes[count].first);
+                if(skipSpaces() != '=')
+                {
+                    error("Invalid attribute " + attributes[count].first + " of the element " + name + ".");
+                }
+                get();
+                skipSpaces();
+                readValue(attributes[count].second);
+                count++;
+            }
+
+            if(closing)
+            {
+                depth = opened.size() + 1;
+            }
+            else
+            {
+                opened.push_back(name);
+                depth = opened.size();
+            }
+            return START_ELEMENT;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfReader::expect(int p_char)
+{
+    if(get() != p_char)
+    {
+        error(string("Expected character '") + static_cast<char>(p_char) + "'.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfReader::skipUntil(const char* p_end)
+{
+    size_t l_length  = strlen(p_end);
+    size_t l_matched = 0;
+
+    while(l_matched < l_length)
+    {
+        int l_char = get();
+        if(l_char == EOF)
+        {
+            error(string("Unexpected end of file - expected \"") + p_end + "\".");
+        }
+
+        if(l_char == p_end[l_matched])
+        {
+            l_matched++;
+        }
+        else
+        {
+            // The characters read end with the matched start of the end, then
+            // l_char: the match goes on with the longest start of the end which
+            // is also their suffix (Ex/ "]]]>" for "]]>", or "--->" for "-->")
+            size_t l_next = l_matched;
+            while(l_next > 0 && (p_end[l_next - 1] != l_char ||
+                                 memcmp(p_end, p_end + l_matched - l_next + 1, l_next - 1) != 0))
+            {
+                l_next--;
+            }
+            l_matched = l_next;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfReader::readName(string& p_name)
+{
+    p_name.clear();
+
+    // The name is appended by runs of the current block
+    while(position < size || fill())
+    {
+        size_t l_end = position;
+        while(l_end < size && !is(buffer[l_end], CHAR_DELIMITER))
+        {
+            l_end++;
+        }
+        p_name.append(buffer.data() + position, l_end - position);
+        offset  += l_end - position;
+        position = l_end;
+
+        if(l_end < size)
+        {
+            break;
+        }
+    }
+
+    if(p_name.empty())
+    {
+        error("Expected a name.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfReader::readValue(string& p_value)
+{
+    p_value.clear();
+
+    int l_quote = get();
+    if(l_quote != '"' && l_quote != '\'')
+    {
+        error("Expected a quoted attribute value.");
+    }
+
+    int l_char = get();
+    while(l_char != l_quote)
+    {
+        // The plain characters are appended by runs of the current block
+        if(l_char != EOF && !is(static_cast<char>(l_char), CHAR_SPECIAL))
+        {
+            size_t l_start = position - 1;
+            while(position < size && !is(buffer[position], CHAR_SPECIAL))
+            {
+                position++;
+            }
+            offset += position - l_start - 1;
+            p_value.append(buffer.data() + l_start, position - l_start);
+            l_char = get();
+            continue;
+        }
+
+        switch(l_char)
+        {
+        case EOF:
+            error("Unexpected end of file in an attribute value.");
+        case '<':
+            error("Invalid character '<' in an attribute value.");
+        case '&':
+            readEntity(p_value);
+            break;
+        case '\r':
+            // Same normalization as the xml parsers (\r\n -> ' ')
+            if(peek() == '\n')
+            {
+                get();
+            }
+            p_value.push_back(' ');
+            break;
+        case '\n':
+        case '\t':
+            p_value.push_back(' ');
+            break;
+        default:
+            p_value.push_back(static_cast<char>(l_char));
+            break;
+        }
+        l_char = get();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfReader::readEntity(string& p_value)
+{
+    string l_entity;
+    int    l_char = get();
+    while(l_char != ';')
+    {
+        if(l_char == EOF || l_entity.size() > 8)
+        {
+            error("Invalid entity &" + l_entity + ".");
+        }
+        l_entity.push_back(static_cast<char>(l_char));
+        l_char = get();
+    }
+
+    if     (l_entity == "lt")   { p_value.push_back('<');  }
+    else if(l_entity == "gt")   { p_value.push_back('>');  }
+    else if(l_entity == "amp")  { p_value.push_back('&');  }
+    else if(l_entity == "quot") { p_value.push_back('"');  }
+    else if(l_entity == "apos") { p_value.push_back('\''); }
+    else if(l_entity.size() > 1 && l_entity[0] == '#')
+    {
+        bool          l_hex  = (l_entity[1] == 'x');
+        char*         l_end  = nullptr;
+        unsigned long l_code = strtoul(l_entity.c_str() + (l_hex ? 2 : 1), &l_end, l_hex ? 16 : 10);
+        if(*l_end || l_code > 0x10FFFF)
+        {
+            error("Invalid character reference &" + l_entity + ";.");
+        }
+
+        // UTF-8 encoding of the character
+        if(l_code < 0x80)
+        {
+            p_value.push_back(static_cast<char>(l_code));
+        }
+        else if(l_code < 0x800)
+        {
+            p_value.push_back(static_cast<char>(0xC0 | (l_code >> 6)));
+            p_value.push_back(static_cast<char>(0x80 | (l_code & 0x3F)));
+        }
+        else if(l_code < 0x10000)
+        {
+            p_value.push_back(static_cast<char>(0xE0 | (l_code >> 12)));
+            p_value.push_back(static_cast<char>(0x80 | ((l_code >> 6) & 0x3F)));
+            p_value.push_back(static_cast<char>(0x80 | (l_code & 0x3F)));
+        }
+        else
+        {
+            p_value.push_back(static_cast<char>(0xF0 | (l_code >> 18)));
+            p_value.push_back(static_cast<char>(0x80 | ((l_code >> 12) & 0x3F)));
+            p_value.push_back(static_cast<char>(0x80 | ((l_code >> 6) & 0x3F)));
+            p_value.push_back(static_cast<char>(0x80 | (l_code & 0x3F)));
+        }
+    }
+    else
+    {
+        error("Unknown entity &" + l_entity + ";.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+int ConfReader::skipSpaces()
+{
+    while(position < size || fill())
+    {
+        if(!is(buffer[position], CHAR_SPACE))
+        {
+            return static_cast<unsigned char>(buffer[position]);
+        }
+        position++;
+        offset++;
+    }
+    return EOF;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfReader::error(const string& p_msg)
+{
+    ERROR("Error - Configuration file parsing failed (position " + to_string(offset) + ") - " + p_msg);
+    throw Exception::ParsingFileError(p_msg, static_cast<int>(offset));
+}
+
+} // namespace ModGen
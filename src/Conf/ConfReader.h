@@ -0,0 +1,189 @@
+/*!
+ * @file   ConfReader.h
+ * @brief  Contains the streaming reader of the configuration files.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef CONFREADER_MODELGENERATOR
+#define CONFREADER_MODELGENERATOR
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ModGen {
+
+/*!
+ * \brief The ConfReader class reads an xml configuration file
+ *        element by element (pull parser).
+ *        Only the current element is held in memory, whatever the size of
+ *        the file: the start tags (name and attributes) and end tags are
+ *        returned in the order of the file. The texts, comments, processing
+ *        instructions, CDATA sections and document type are skipped.
+ *        NB : Throws a ParsingFileError (with the offset in the file) if the
+ *             file is not well-formed.
+ */
+class ConfReader
+{
+public:
+    /**
+     * Enumerate of the events returned by the reader.
+     */
+    typedef enum {
+        START_ELEMENT = 0, /*!< Start tag (name and attributes) */
+        END_ELEMENT   = 1, /*!< End tag (name)                  */
+        END_OF_FILE   = 2  /*!< No more element                 */
+    } EVENT;
+
+    /*!
+     * \brief ConfReader constructor
+     * \param p_filePath the path of the configuration file.
+     * NB : Throws a ParsingFileError if the file cannot be opened.
+     */
+    explicit ConfReader(const std::string& p_filePath);
+
+    /*!
+     * \brief ~ConfReader destructor (closes the file)
+     */
+    ~ConfReader();
+
+    ConfReader(const ConfReader&)            = delete;
+    ConfReader& operator=(const ConfReader&) = delete;
+
+    /*!
+     * \brief next reads the next tag of the file.
+     * \return the event read.
+     */
+    EVENT next();
+
+    /*!
+     * \brief getName
+     * \return the name of the element of the last event.
+     */
+    const std::string& getName() const { return name; }
+
+    /*!
+     * \brief getAttributesCount
+     * \return the number of attributes of the last start tag.
+     */
+    std::size_t getAttributesCount() const { return count; }
+
+    /*!
+     * \brief getAttributeName
+     * \param p_index the index of the attribute (< getAttributesCount).
+     * \return the name of the attribute.
+     */
+    const std::string& getAttributeName(std::size_t p_index) const { return attributes[p_index].first; }
+
+    /*!
+     * \brief getAttributeValue
+     * \param p_index the index of the attribute (< getAttributesCount).
+     * \return the value of the attribute (entities replaced).
+     */
+    const std::string& getAttributeValue(std::size_t p_index) const { return attributes[p_index].second; }
+
+    /*!
+     * \brief getDepth
+     * \return the depth of the element of the last event (1 for the root).
+     */
+    std::size_t getDepth() const { return depth; }
+
+    /*!
+     * \brief getOffset
+     * \return the offset (bytes) of the reader in the file.
+     */
+    uint64_t getOffset() const { return offset; }
+
+private:
+    /*!
+     * \brief get reads a character of the file.
+     * \return the character, EOF at the end of the file.
+     */
+    int get()
+    {
+        if(position == size && !fill())
+        {
+            return EOF;
+        }
+        offset++;
+        return static_cast<unsigned char>(buffer[position++]);
+    }
+
+    /*!
+     * \brief peek reads a character of the file without consuming it.
+     * \return the character, EOF at the end of the file.
+     */
+    int peek()
+    {
+        if(position == size && !fill())
+        {
+            return EOF;
+        }
+        return static_cast<unsigned char>(buffer[position]);
+    }
+
+    /*!
+     * \brief fill reads the next block of the file.
+     * \return false at the end of the file.
+     */
+    bool fill();
+
+    /*!
+     * \brief expect reads a character which must be the specified one.
+     */
+    void expect(int p_char);
+
+    /*!
+     * \brief skipUntil skips the file up to (and including) the specified string.
+     */
+    void skipUntil(const char* p_end);
+
+    /*!
+     * \brief readName reads the name of a tag or an attribute.
+     */
+    void readName(std::string& p_name);
+
+    /*!
+     * \brief readValue reads the value of an attribute (quoted).
+     */
+    void readValue(std::string& p_value);
+
+    /*!
+     * \brief readEntity appends the character referenced by an entity (after '&').
+     */
+    void readEntity(std::string& p_value);
+
+    /*!
+     * \brief skipSpaces skips the white spaces of the file.
+     * \return the next character (not consumed).
+     */
+    int skipSpaces();
+
+    /*!
+     * \brief error throws a ParsingFileError at the current offset.
+     */
+    [[noreturn]] void error(const std::string& p_msg);
+
+private:
+    static const std::size_t BLOCK_SIZE = 65536; /*!< Size of the blocks read from the file */
+
+    std::FILE*               file;       /*!< The configuration file                 */
+    std::vector<char>        buffer;     /*!< The current block of the file          */
+    std::size_t              position;   /*!< Position of the reader in the block    */
+    std::size_t              size;       /*!< Size of the current block              */
+    uint64_t                 offset;     /*!< Position of the reader in the file     */
+
+    std::string              name;       /*!< Name of the element of the last event  */
+    std::vector<std::pair<std::string, std::string>>
+                             attributes; /*!< Attributes (reused between tags)       */
+    std::size_t              count;      /*!< Attributes of the last start tag       */
+    std::vector<std::string> opened;     /*!< Names of the opened elements           */
+    std::size_t              depth;      /*!< Depth of the element of the last event */
+    bool                     closing;    /*!< The last start tag was self-closing    */
+};
+
+} // namespace ModGen
+
+#endif // CONFREADER_MODELGENERATOR
@@ -27,6 +27,7 @@ const string Messages_format::src_port  = "port_src";
 const string Messages_format::dst_port  = "port_dst";
 const string Messages_format::fill      = "fill";
 const string Messages_format::interface = "interface";
+const string Messages_format::seed      = "seed";
 
 const string Headers_format::balise     = "Headers";
 const string Headers_format::name       = "name";
@@ -51,6 +52,9 @@ const string Field_time_format::balise  = "Field_time";
 const string State_format::balise       = "States";
 const string State_format::balise_2     = "State";
 const string State_format::name         = "name";
+const string State_format::wait         = "wait";
+const string State_format::timeout      = "wait_timeout";
+const string State_format::resend       = "resend";
 
 const string StateOp_format::balise     = "Operations";
 const string StateOp_format::balise_2   = "Op";
@@ -43,6 +43,7 @@ struct Messages_format {
     static const std::string dst_port; /*!< string used as destination port name                 */
     static const std::string fill;     /*!< string used as name for the filling method           */
     static const std::string interface;/*!< string used as name for the interface param          */
+    static const std::string seed;     /*!< string used as name for the random seed param        */
 };
 
 struct Headers_format {
@@ -79,6 +80,9 @@ struct State_format {
     static const std::string balise;   /*!< string used for the balise tag                       */
     static const std::string balise_2; /*!< string used for the balise tag                       */
     static const std::string name;     /*!< string used for the id param                         */
+    static const std::string wait;     /*!< string used for the wait param                       */
+    static const std::string timeout;  /*!< string used for the wait_timeout param               */
+    static const std::string resend;   /*!< string used for the resend param                     */
 };
 
 struct StateOp_format {
@@ -268,6 +268,75 @@ struct UnknownFileType : std::exception
     std::string message; /*!< message to display */
 };
 
+/**
+ * @brief The BufferOverflow struct is thrown if a caller-provided
+ *        buffer is too small to hold the data to be written.
+ */
+struct BufferOverflow : std::exception
+{
+    BufferOverflow(std::size_t p_required, std::size_t p_capacity):
+        message("Buffer too small: " + std::to_string(p_required) + " bytes required, "
+                + std::to_string(p_capacity) + " available") {}
+
+    /**
+     * @brief ~BufferOverflow default destructor
+     */
+    virtual ~BufferOverflow() noexcept {}
+
+    /**
+     * @brief what returns a char string describing the exception
+     * @return message to display
+     */
+    const char* what() const noexcept { return message.c_str(); }
+
+    std::string message; /*!< message to display */
+};
+
+/**
+ * @brief The SocketError struct is thrown if a socket used
+ *        to send the messages could not be set up.
+ */
+struct SocketError : std::exception
+{
+    SocketError(const std::string& p_msg, int p_errno):
+        message(p_msg + " (" + std::strerror(p_errno) + ")") {}
+
+    /**
+     * @brief ~SocketError default destructor
+     */
+    virtual ~SocketError() noexcept {}
+
+    /**
+     * @brief what returns a char string describing the exception
+     * @return message to display
+     */
+    const char* what() const noexcept { return message.c_str(); }
+
+    std::string message; /*!< message to display */
+};
+
+/**
+ * @brief The OutputFileError struct is thrown if an output
+ *        file (Ex/ a capture file) cannot be written.
+ */
+struct OutputFileError : std::exception
+{
+    OutputFileError(const std::string& p_msg): message(p_msg) {}
+
+    /**
+     * @brief ~OutputFileError default destructor
+     */
+    virtual ~OutputFileError() noexcept {}
+
+    /**
+     * @brief what returns a char string describing the exception
+     * @return message to display
+     */
+    const char* what() const noexcept { return message.c_str(); }
+
+    std::string message; /*!< message to display */
+};
+
 } // namespace Exception
 
 } // namespace ModGen
@@ -0,0 +1,163 @@
+/*!
+ * @file   LogFormat.cpp
+ * @brief  Implementations of the functions defined in \a LogFormat.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <ctime>
+#include <vector>
+
+#include "LogFormat.h"
+#include "Exception.h"
+
+namespace ModGen {
+
+using namespace std;
+
+const char* LogFormat::MAGIC = "MGLOG1";
+
+/////////////////////////////////////////////////////////////////////////////////
+const char* LogFormat::getFormat(uint16_t p_format)
+{
+    static const char* l_formats[LOG_FMT_COUNT] = {
+        "%s",                   // LOG_FMT_TEXT
+        "%s",                   // LOG_FMT_RAW
+        "%s",                   // LOG_FMT_STATE
+        "%d frame(s) emitted"   // LOG_FMT_FRAMES
+    };
+
+    return (p_format < LOG_FMT_COUNT) ? l_formats[p_format] : nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+void LogFormat::render(uint16_t     p_format,
+                       const char*  p_args,
+                       size_t       p_length,
+                       string&      p_out)
+{
+    // The messages already built are not packed
+    if(p_format == LOG_FMT_TEXT || p_format == LOG_FMT_RAW)
+    {
+        p_out.append(p_args, p_length);
+        return;
+    }
+
+    const char* l_format = getFormat(p_format);
+    if(!l_format)
+    {
+        p_out.append("Unknown log format " + to_string(p_format));
+        return;
+    }
+
+    // A truncated record is rendered up to its last complete argument
+    size_t l_pos = 0;
+    for(const char* l_char = l_format; *l_char; l_char++)
+    {
+        if(l_char[0] != '%' || (l_char[1] != 'd' && l_char[1] != 's'))
+        {
+            p_out.push_back(*l_char);
+            continue;
+        }
+
+        if(*(++l_char) == 'd')
+        {
+            int64_t l_value = 0;
+            if(l_pos + sizeof(l_value) > p_length) { break; }
+            memcpy(&l_value, p_args + l_pos, sizeof(l_value));
+            l_pos += sizeof(l_value);
+            p_out.append(to_string(l_value));
+        }
+        else
+        {
+            uint16_t l_size = 0;
+            if(l_pos + sizeof(l_size) > p_length) { break; }
+            memcpy(&l_size, p_args + l_pos, sizeof(l_size));
+            l_pos += sizeof(l_size);
+            l_size = static_cast<uint16_t>(min<size_t>(l_size, p_length - l_pos));
+            p_out.append(p_args + l_pos, l_size);
+            l_pos += l_size;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+void LogFormat::renderLine(const LogRecordHeader& p_header,
+                           const char*            p_args,
+                           string&                p_out)
+{
+    if(p_header.format == LOG_FMT_RAW)
+    {
+        p_out.append(p_args, p_header.length);
+        return;
+    }
+
+    // Same format as TimeUtil::currentTime - the local time is computed once per second
+    static thread_local time_t l_second = -1;
+    static thread_local char   l_prefix[32];
+    static thread_local size_t l_prefixSize = 0;
+
+    time_t l_time = static_cast<time_t>(p_header.time_us / 1000000);
+    if(l_time != l_second)
+    {
+        tm l_local;
+#ifdef _WIN32
+        localtime_s(&l_local, &l_time);
+#else
+        localtime_r(&l_time, &l_local);
+#endif
+        l_prefixSize = strftime(l_prefix, sizeof(l_prefix), "%Hh:%Mm:%Ss:", &l_local);
+        l_second     = l_time;
+    }
+
+    p_out.append(l_prefix, l_prefixSize);
+    p_out.append(to_string((p_header.time_us / 1000) % 1000));
+    p_out.append("ms:: ");
+    render(p_header.format, p_args, p_header.length, p_out);
+    p_out.push_back('\n');
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+uint64_t LogFormat::decode(istream& p_binary, ostream& p_text)
+{
+    LogRecordHeader l_header;
+    vector<char>    l_args;
+    string          l_line;
+    uint64_t        l_count  = 0;
+    bool            l_binary = false;
+
+    while(p_binary.read(reinterpret_cast<char*>(&l_header), sizeof(l_header)))
+    {
+        // A binary log file starts with a header record
+        if(!l_binary && l_header.format != LOG_FMT_HEADER)
+        {
+            throw Exception::LoggerError("Error - LogFormat::decode - Not a binary log file.");
+        }
+
+        l_args.resize(l_header.length);
+        if(!p_binary.read(l_args.data(), l_header.length))
+        {
+            throw Exception::LoggerError("Error - LogFormat::decode - Truncated record.");
+        }
+
+        // Every opening of the log file writes a header record
+        if(l_header.format == LOG_FMT_HEADER)
+        {
+            if(string(l_args.begin(), l_args.end()) != MAGIC)
+            {
+                throw Exception::LoggerError("Error - LogFormat::decode - Invalid header record.");
+            }
+            l_binary = true;
+            continue;
+        }
+
+        l_line.clear();
+        renderLine(l_header, l_args.data(), l_line);
+        p_text.write(l_line.data(), static_cast<streamsize>(l_line.size()));
+        l_count++;
+    }
+
+    return l_count;
+}
+
+} // namespace ModGen
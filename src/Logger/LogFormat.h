@@ -0,0 +1,173 @@
+/*!
+ * @file   LogFormat.h
+ * @brief  Contains the formats of the log records and the functions
+ *         packing their arguments and rendering them as text.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef LOGFORMAT_MODELGENERATOR
+#define LOGFORMAT_MODELGENERATOR
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ModGen {
+
+/**
+ * Enumerate of the formats of the log records.
+ * The arguments of a record are packed by LogFormat::pack and
+ * only rendered as text by the writer of the logger (text logs)
+ * or by LogFormat::decode (binary logs).
+ */
+typedef enum {
+    LOG_FMT_TEXT   = 0,      /*!< A message already built (string)    */
+    LOG_FMT_RAW    = 1,      /*!< Written as is (no time nor new line) */
+    LOG_FMT_STATE  = 2,      /*!< "%s"                  : State entered */
+    LOG_FMT_FRAMES = 3,      /*!< "%d frame(s) emitted" : Frames sent   */
+    LOG_FMT_COUNT,           /*!< Number of formats                    */
+    LOG_FMT_HEADER = 0xFFFF  /*!< First record of a binary log file    */
+} LOGFORMATID;
+
+/*!
+ * \brief The LogRecordHeader struct precedes the arguments of every record
+ *        of a binary log file (in the byte order of the host).
+ */
+struct LogRecordHeader
+{
+    uint16_t format;  /*!< Format of the record (Cf. LOGFORMATID) */
+    uint16_t length;  /*!< Size of the arguments of the record    */
+    int32_t  level;   /*!< Trace level of the record              */
+    uint64_t time_us; /*!< Time of the record (us since epoch)    */
+};
+
+/*!
+ * \brief The LogFormat class packs the arguments of the log records
+ *        and renders them as text.
+ *        The arguments are packed in the order of the format:
+ *        the integers as int64_t, the strings as their size (uint16_t)
+ *        followed by their characters.
+ */
+class LogFormat
+{
+public:
+    static const char* MAGIC; /*!< Arguments of the LOG_FMT_HEADER record */
+
+    /*!
+     * \brief getFormat
+     * \param p_format the ID of the format.
+     * \return the format (printf-like, %d for integers and %s for strings),
+     *         nullptr if unknown.
+     */
+    static const char* getFormat(uint16_t p_format);
+
+    /*!
+     * \brief pack packs the arguments of a record into a buffer.
+     * \param p_buffer the buffer.
+     * \param p_size the size of the buffer.
+     * \param p_args the arguments (integers and strings).
+     * \return the size of the packed arguments - if it is over p_size,
+     *         only the first p_size bytes were written (as snprintf).
+     */
+    template<typename... Args>
+    static std::size_t pack(char* p_buffer, std::size_t p_size, const Args&... p_args)
+    {
+        std::size_t l_length = 0;
+        (packArg(p_buffer, p_size, l_length, p_args), ...);
+        return l_length;
+    }
+
+    /*!
+     * \brief render appends the message of a record to a string.
+     * \param p_format the ID of the format of the record.
+     * \param p_args the packed arguments of the record.
+     * \param p_length the size of the packed arguments.
+     * \param p_out the string to append the message to.
+     */
+    static void render(uint16_t           p_format,
+                       const char*        p_args,
+                       std::size_t        p_length,
+                       std::string&       p_out);
+
+    /*!
+     * \brief renderLine appends a record to a string as a line of the text logs
+     *        (time and message, Cf. TimeUtil::currentTime).
+     * \param p_header the format, trace level and time of the record.
+     * \param p_args the packed arguments of the record.
+     * \param p_out the string to append the line to.
+     */
+    static void renderLine(const LogRecordHeader& p_header,
+                           const char*            p_args,
+                           std::string&           p_out);
+
+    /*!
+     * \brief decode renders a binary log file as text logs.
+     * \param p_binary the binary logs.
+     * \param p_text the stream to write the text logs to.
+     * \return the number of records decoded.
+     * NB : Throws a LoggerError if p_binary is not a binary log file.
+     */
+    static uint64_t decode(std::istream& p_binary, std::ostream& p_text);
+
+private:
+    /*!
+     * \brief packBytes appends a value to the packed arguments
+     *        (only the bytes fitting in the buffer are copied).
+     */
+    static void packBytes(char*        p_buffer,
+                          std::size_t  p_size,
+                          std::size_t& p_length,
+                          const void*  p_value,
+                          std::size_t  p_valueSize)
+    {
+        if(p_length < p_size)
+        {
+            std::memcpy(p_buffer + p_length, p_value, std::min(p_valueSize, p_size - p_length));
+        }
+        p_length += p_valueSize;
+    }
+
+    /*!
+     * \brief packArg appends an argument to the packed arguments.
+     */
+    template<typename T>
+    static void packArg(char* p_buffer, std::size_t p_size, std::size_t& p_length, const T& p_value)
+    {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                      "The arguments of a log record are integers or strings");
+        int64_t l_value = static_cast<int64_t>(p_value);
+        packBytes(p_buffer, p_size, p_length, &l_value, sizeof(l_value));
+    }
+
+    static void packString(char* p_buffer, std::size_t p_size, std::size_t& p_length,
+                           const char* p_value, std::size_t p_valueSize)
+    {
+        uint16_t l_size = static_cast<uint16_t>(std::min<std::size_t>(p_valueSize, UINT16_MAX));
+        packBytes(p_buffer, p_size, p_length, &l_size,  sizeof(l_size));
+        packBytes(p_buffer, p_size, p_length, p_value, l_size);
+    }
+
+    static void packArg(char* p_buffer, std::size_t p_size, std::size_t& p_length, const std::string& p_value)
+    {
+        packString(p_buffer, p_size, p_length, p_value.data(), p_value.size());
+    }
+
+    static void packArg(char* p_buffer, std::size_t p_size, std::size_t& p_length, const char* p_value)
+    {
+        packString(p_buffer, p_size, p_length, p_value, std::strlen(p_value));
+    }
+
+    static void packArg(char* p_buffer, std::size_t p_size, std::size_t& p_length, std::string_view p_value)
+    {
+        packString(p_buffer, p_size, p_length, p_value.data(), p_value.size());
+    }
+};
+
+} // namespace ModGen
+
+#endif // LOGFORMAT_MODELGENERATOR
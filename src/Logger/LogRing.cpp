@@ -0,0 +1,131 @@
+/*!
+ * @file   LogRing.cpp
+ * @brief  Implementations of the functions defined in \a LogRing.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "LogRing.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+LogRing::LogRing(size_t p_capacity) :
+    records(),
+    mask(0),
+    enqueue(0),
+    dequeue(0),
+    drops(0),
+    overflows(0)
+{
+    size_t l_capacity = 2;
+    while(l_capacity < p_capacity)
+    {
+        l_capacity <<= 1;
+    }
+
+    records = vector<LogRecord>(l_capacity);
+    mask    = l_capacity - 1;
+
+    // A slot is free for the producer reserving the position equal to its sequence
+    for(size_t i = 0; i < l_capacity; i++)
+    {
+        records[i].sequence.store(i, memory_order_relaxed);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+bool LogRing::push(int32_t     p_level,
+                   uint64_t    p_time_us,
+                   uint16_t    p_format,
+                   const char* p_text,
+                   size_t      p_length)
+{
+    LogRecord* l_record = nullptr;
+    uint64_t   l_pos    = enqueue.load(memory_order_relaxed);
+
+    // Reserve a slot
+    while(true)
+    {
+        l_record         = &records[l_pos & mask];
+        uint64_t l_seq   = l_record->sequence.load(memory_order_acquire);
+        int64_t  l_delta = static_cast<int64_t>(l_seq - l_pos);
+
+        if(l_delta == 0)
+        {
+            if(enqueue.compare_exchange_weak(l_pos, l_pos + 1, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(l_delta < 0)
+        {
+            // The consumer did not release this slot yet: the ring is full
+            drops.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            l_pos = enqueue.load(memory_order_relaxed);
+        }
+    }
+
+    if(p_length > LogRecord::LOG_TEXT_SIZE)
+    {
+        overflows.fetch_add(1, memory_order_relaxed);
+        p_length = LogRecord::LOG_TEXT_SIZE;
+    }
+
+    l_record->time_us = p_time_us;
+    l_record->level   = p_level;
+    l_record->length  = static_cast<uint16_t>(p_length);
+    l_record->format  = p_format;
+    memcpy(l_record->text, p_text, p_length);
+
+    // Publish the record to the consumer
+    l_record->sequence.store(l_pos + 1, memory_order_release);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+const LogRecord* LogRing::front()
+{
+    uint64_t   l_pos    = dequeue.load(memory_order_relaxed);
+    LogRecord* l_record = &records[l_pos & mask];
+
+    if(l_record->sequence.load(memory_order_acquire) != l_pos + 1)
+    {
+        return nullptr;
+    }
+    return l_record;
+}
+
+////////////////////////////////////////////////////////////////////////
+void LogRing::pop()
+{
+    uint64_t l_pos = dequeue.load(memory_order_relaxed);
+
+    // The slot is free again for the producers of the next round
+    records[l_pos & mask].sequence.store(l_pos + mask + 1, memory_order_release);
+    dequeue.store(l_pos + 1, memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool LogRing::isEmpty() const
+{
+    return dequeue.load(memory_order_acquire) == enqueue.load(memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////////////////
+void LogRing::resetCounters()
+{
+    drops.store(0, memory_order_relaxed);
+    overflows.store(0, memory_order_relaxed);
+}
+
+} // namespace ModGen
@@ -0,0 +1,119 @@
+/*!
+ * @file   LogRing.h
+ * @brief  Contains the ring buffer of log records written by the
+ *         threads of the software and read by the writer of the logger.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef LOGRING_MODELGENERATOR
+#define LOGRING_MODELGENERATOR
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ModGen {
+
+/*!
+ * \brief The LogRecord struct is a fixed-size log record.
+ *        The messages longer than LOG_TEXT_SIZE are truncated.
+ */
+struct LogRecord
+{
+    static constexpr std::size_t LOG_TEXT_SIZE = 224; /*!< Maximum size of a message */
+
+    std::atomic<uint64_t> sequence;            /*!< Sequence number of the slot (Cf. LogRing) */
+    uint64_t              time_us;             /*!< Time of the record (us since epoch)       */
+    int32_t               level;               /*!< Trace level of the record                 */
+    uint16_t              length;              /*!< Size of the message                       */
+    uint16_t              format;              /*!< Format of the message (Cf. LogFormat.h)   */
+    char                  text[LOG_TEXT_SIZE]; /*!< The message (or its packed arguments)     */
+};
+
+/*!
+ * \brief The LogRing class is a bounded lock-free ring of log records
+ *        with multiple producers and a single consumer.
+ *
+ *        Every slot holds a sequence number telling whether it is free for
+ *        the producers or ready for the consumer: the producers only contend
+ *        on the reservation of a slot (one compare-and-swap), never on a lock.
+ *        When the ring is full, the record is dropped instead of blocking
+ *        the producer.
+ */
+class LogRing
+{
+public:
+    /*!
+     * \brief LogRing constructor
+     * \param p_capacity the number of records (rounded up to a power of 2).
+     */
+    explicit LogRing(std::size_t p_capacity);
+
+    LogRing(const LogRing&)            = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    /*!
+     * \brief push copies a message into a free record (any thread).
+     * \param p_level the trace level of the message.
+     * \param p_time_us the time of the message (us since epoch).
+     * \param p_format the format of the message (Cf. LOGFORMATID).
+     * \param p_text the message.
+     * \param p_length the size of the message.
+     * \return false if the message was dropped (ring full).
+     */
+    bool push(int32_t     p_level,
+              uint64_t    p_time_us,
+              uint16_t    p_format,
+              const char* p_text,
+              std::size_t p_length);
+
+    /*!
+     * \brief front returns the oldest ready record (consumer thread only).
+     * \return the record, nullptr if the ring is empty.
+     */
+    const LogRecord* front();
+
+    /*!
+     * \brief pop releases the record returned by front (consumer thread only).
+     */
+    void pop();
+
+    /*!
+     * \brief isEmpty
+     * \return true if every pushed record has been popped.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief getDropCount
+     * \return the number of records dropped because the ring was full.
+     */
+    uint64_t getDropCount() const { return drops.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief getOverflowCount
+     * \return the number of messages truncated to LogRecord::LOG_TEXT_SIZE.
+     */
+    uint64_t getOverflowCount() const { return overflows.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief resetCounters sets the drop and overflow counters to 0.
+     */
+    void resetCounters();
+
+private:
+    std::vector<LogRecord> records;   /*!< The slots of the ring                   */
+    uint64_t               mask;      /*!< Capacity - 1                            */
+    alignas(64)
+    std::atomic<uint64_t>  enqueue;   /*!< Next slot to reserve (producers)        */
+    alignas(64)
+    std::atomic<uint64_t>  dequeue;   /*!< Next slot to read (consumer)            */
+    std::atomic<uint64_t>  drops;     /*!< Records dropped (ring full)             */
+    std::atomic<uint64_t>  overflows; /*!< Messages truncated                      */
+};
+
+} // namespace ModGen
+
+#endif // LOGRING_MODELGENERATOR
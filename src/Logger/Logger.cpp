@@ -5,6 +5,8 @@
  * @date   16/07/2019
  */
 
+#include <chrono>
+#include <ctime>
 #include <iostream>
 
 #include "Logger.h"
@@ -16,41 +18,31 @@ namespace ModGen {
 using namespace std;
 
 /////////////////////////////////////////////////////////////////////////////////
-void ERROR(const string& p_msg)
-{
-    Logger::append(p_msg, Logger::ERRORS_ONLY);
-}
-
-/////////////////////////////////////////////////////////////////////////////////
-void INFO(const string& p_msg)
-{
-    Logger::append(p_msg, Logger::ERRORS_INFO);
-}
-
-/////////////////////////////////////////////////////////////////////////////////
-void DEBUG(const string &p_msg)
-{
-    Logger::append(p_msg, Logger::ERRORS_INFO_DEBUG);
-}
-
-/////////////////////////////////////////////////////////////////////////////////
-void DEBUG(const vector<uint8_t>& p_byteArray)
+void WRITE(const string& p_msg, const int32_t& p_traceLevel)
 {
-    Logger::append(p_byteArray, Logger::ERRORS_INFO_DEBUG);
+    if(p_traceLevel >= 0)
+    {
+        Logger::append(p_msg, static_cast<Logger::TRACELEVELS>(p_traceLevel));
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////
-void WRITE(const string& p_msg, const int32_t& p_traceLevel)
+void WRITE(const vector<uint8_t>& p_byteArray, const int32_t& p_traceLevel)
 {
     if(p_traceLevel >= 0)
     {
-        Logger::append(p_msg, static_cast<Logger::TRACELEVELS>(p_traceLevel));
+        Logger::append(p_byteArray, static_cast<Logger::TRACELEVELS>(p_traceLevel));
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+atomic<int32_t> Logger::enabledLevel(Logger::NO_LOGS);
+
 /////////////////////////////////////////////////////////////////////////////////
 void Logger::setLogFile(const string& p_filePath)
 {
+    getInstance().stopWriter();
+
     if(getInstance().logFile)
     {
         if(getInstance().logFile->is_open())
@@ -71,7 +63,8 @@ void Logger::setLogFile(const string& p_filePath)
     // Do not declare any log file if empty
     if(!p_filePath.empty())
     {
-        getInstance().logFile = new ofstream(p_filePath, ios::out | ios::app);
+        ios::openmode l_mode = getInstance().binary ? (ios::out | ios::app | ios::binary) : (ios::out | ios::app);
+        getInstance().logFile = new ofstream(p_filePath, l_mode);
         getInstance().logName = new string(p_filePath);
         if (!getInstance().logFile->is_open())
         {
@@ -79,33 +72,34 @@ void Logger::setLogFile(const string& p_filePath)
                                          + p_filePath + ").");
         }
 
+        getInstance().startWriter();
         INFO("Log file set to " + p_filePath);
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+void Logger::setBinary(bool p_binary)
+{
+    getInstance().binary = p_binary;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 void Logger::setTraceLevel(TRACELEVELS p_traceLevel)
 {
     getInstance().traceLevel = p_traceLevel;
+    getInstance().updateLevel();
 }
 
 /////////////////////////////////////////////////////////////////////////////////
 bool Logger::isDebugEnabled()
 {
-    return getInstance().traceLevel >= ERRORS_INFO_DEBUG;
+    return isEnabled(ERRORS_INFO_DEBUG);
 }
 
 /////////////////////////////////////////////////////////////////////////////////
 bool Logger::isOpened()
 {
-    bool l_return = false;
-
-    if(getInstance().logFile)
-    {
-        l_return = getInstance().logFile->is_open();
-    }
-
-    return l_return;
+    return getInstance().opened.load(memory_order_acquire);
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -125,12 +119,22 @@ string Logger::getLogFile()
 Logger::Logger() :
     logFile(nullptr),
     logName(nullptr),
-    traceLevel(NO_LOGS)
+    traceLevel(NO_LOGS),
+    opened(false),
+    binary(false),
+    ring(RING_CAPACITY),
+    writer(),
+    running(false),
+    writing(false),
+    wakeMutex(),
+    wakeUp()
 {}
 
 /////////////////////////////////////////////////////////////////////////////////
 Logger::~Logger()
 {
+    stopWriter();
+
     if(logFile)
     {
         logFile->close();
@@ -152,51 +156,174 @@ Logger& Logger::getInstance()
 
 /////////////////////////////////////////////////////////////////////////////////
 void Logger::append(const string &p_msg, TRACELEVELS p_traceLevel)
+{
+    push(p_traceLevel, LOG_FMT_TEXT, p_msg.data(), p_msg.size());
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+void Logger::append(const vector<uint8_t> &p_byteArray, TRACELEVELS p_traceLevel)
 {
     if(getInstance().isOpened() && 
        getInstance().traceLevel >= p_traceLevel)
     {
-        string l_currenTime = TimeUtil::currentTime();
-        switch(p_traceLevel)
-        {
-            case ERRORS_ONLY: cerr << l_currenTime << ":: " << p_msg << "\n"; break;
-            default:break;
-        }
+        string l_msg;
+        l_msg.reserve(2 * p_byteArray.size());
+        for(auto& l_char : p_byteArray) { l_msg += static_cast<char>(l_char); l_msg += ' '; }
 
-        if(!getInstance().logFile)
+        push(p_traceLevel, LOG_FMT_RAW, l_msg.data(), l_msg.size());
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+void Logger::push(TRACELEVELS p_traceLevel,
+                  uint16_t    p_format,
+                  const char* p_text,
+                  size_t      p_length)
+{
+    if(getInstance().isOpened() && 
+       getInstance().traceLevel >= p_traceLevel)
+    {
+        // Formatted and written by the writer thread
+        LogRecordHeader l_header;
+        l_header.format  = p_format;
+        l_header.length  = static_cast<uint16_t>(min(p_length, LogRecord::LOG_TEXT_SIZE));
+        l_header.level   = p_traceLevel;
+        l_header.time_us = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>
+                               (chrono::system_clock::now().time_since_epoch()).count());
+
+        if(p_traceLevel == ERRORS_ONLY)
         {
-            throw Exception::LoggerError(l_currenTime + ":: Error - Logger::append - Unspecified log file.");
+            string l_line;
+            LogFormat::renderLine(l_header, p_text, l_line);
+            cerr << l_line;
         }
 
-        *getInstance().logFile << l_currenTime << ":: " << p_msg << "\n";
+        getInstance().ring.push(p_traceLevel, l_header.time_us, p_format, p_text, p_length);
     }
 }
 
 /////////////////////////////////////////////////////////////////////////////////
-void Logger::append(const vector<uint8_t> &p_byteArray, TRACELEVELS p_traceLevel)
+void Logger::startWriter()
 {
-    if(getInstance().isOpened() && 
-       getInstance().traceLevel >= p_traceLevel)
+    ring.resetCounters();
+    running.store(true, memory_order_release);
+    writer = thread(&Logger::writeRecords, this);
+    opened.store(true, memory_order_release);
+    updateLevel();
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+void Logger::updateLevel()
+{
+    enabledLevel.store(opened.load(memory_order_acquire) ? traceLevel.load() : NO_LOGS,
+                       memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+void Logger::stopWriter()
+{
+    opened.store(false, memory_order_release);
+    updateLevel();
+    if(!writer.joinable())
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> l_lock(wakeMutex);
+        running.store(false, memory_order_release);
+    }
+    wakeUp.notify_one();
+    writer.join();
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+void Logger::writeRecords()
+{
+    string l_batch;
+
+    // Every opening of a binary log file starts with a header record
+    if(binary)
     {
-        switch(p_traceLevel)
+        LogRecordHeader l_header = { LOG_FMT_HEADER, static_cast<uint16_t>(strlen(LogFormat::MAGIC)), NO_LOGS, 0 };
+        l_batch.append(reinterpret_cast<const char*>(&l_header), sizeof(l_header));
+        l_batch.append(LogFormat::MAGIC, l_header.length);
+    }
+
+    while(true)
+    {
+        // Read before draining: the records pushed before the stop are written
+        bool l_stop = !running.load(memory_order_acquire);
+
+        size_t l_count = 0;
+        writing.store(true);
+        for(const LogRecord* l_record = ring.front();
+            l_record && l_count < WRITE_BATCH;
+            l_record = ring.front(), l_count++)
+        {
+            LogRecordHeader l_header;
+            l_header.format  = l_record->format;
+            l_header.length  = l_record->length;
+            l_header.level   = l_record->level;
+            l_header.time_us = l_record->time_us;
+
+            if(binary)
+            {
+                l_batch.append(reinterpret_cast<const char*>(&l_header), sizeof(l_header));
+                l_batch.append(l_record->text, l_record->length);
+            }
+            else
+            {
+                LogFormat::renderLine(l_header, l_record->text, l_batch);
+            }
+            ring.pop();
+        }
+
+        if(!l_batch.empty())
         {
-            case ERRORS_ONLY:
-                for(auto& l_char : p_byteArray) { cerr << l_char << " "; }
-                break;
-            default:
-                // for(auto& l_char : p_byteArray) { cout << l_char << " "; }
-                break;
+            logFile->write(l_batch.data(), static_cast<streamsize>(l_batch.size()));
+            logFile->flush();
+            l_batch.clear();
         }
+        writing.store(false);
 
-        if(!getInstance().logFile)
+        if(l_count)
         {
-            throw Exception::LoggerError(TimeUtil::currentTime() + ":: Error - Logger::append - Unspecified log file.");
+            continue;
+        }
+        if(l_stop)
+        {
+            break;
         }
 
-        for(auto& l_char : p_byteArray) { *getInstance().logFile << l_char << " "; }
+        // The producers do not notify (lock-free): the ring is polled
+        unique_lock<mutex> l_lock(wakeMutex);
+        wakeUp.wait_for(l_lock, chrono::milliseconds(5), [this]() { return !running.load(memory_order_acquire); });
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+void Logger::flush()
+{
+    Logger& l_logger = getInstance();
+    while(l_logger.writer.joinable() && (!l_logger.ring.isEmpty() || l_logger.writing.load()))
+    {
+        this_thread::sleep_for(chrono::microseconds(100));
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+uint64_t Logger::getDropCount()
+{
+    return getInstance().ring.getDropCount();
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+uint64_t Logger::getOverflowCount()
+{
+    return getInstance().ring.getOverflowCount();
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 void Logger::setup(const string& p_filePath, TRACELEVELS p_traceLevel)
 {
@@ -207,6 +334,8 @@ void Logger::setup(const string& p_filePath, TRACELEVELS p_traceLevel)
 /////////////////////////////////////////////////////////////////////////////////
 void Logger::closeLogs()
 {
+    getInstance().stopWriter();
+
     if(getInstance().logFile)
     {
         getInstance().logFile->close();
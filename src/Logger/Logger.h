@@ -9,9 +9,63 @@
 #ifndef LOGGER_MODELGENERATOR
 #define LOGGER_MODELGENERATOR
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+#include "LogRing.h"
+#include "LogFormat.h"
+
+/*!
+ * \brief LOG_LEVEL_MAX is the highest trace level compiled in the library
+ *        (Cf. Logger::TRACELEVELS - set by the LOG_LEVEL_MAX cmake option).
+ *        The messages of the levels above it are removed at compile time.
+ */
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX 2
+#endif
+
+/*!
+ * \brief LOG_MESSAGE logs a message with the specified trace level.
+ *        The message is only built when it is logged: the arguments are
+ *        not evaluated when the level is off (they must not have side effects).
+ */
+#define LOG_MESSAGE(p_traceLevel, ...)                                  \
+    do {                                                                \
+        if constexpr((p_traceLevel) <= LOG_LEVEL_MAX)                   \
+        {                                                               \
+            if(ModGen::Logger::isEnabled(p_traceLevel))                 \
+            {                                                           \
+                ModGen::WRITE((__VA_ARGS__), (p_traceLevel));           \
+            }                                                           \
+        }                                                               \
+    } while(0)
+
+#define ERROR(...) LOG_MESSAGE(ModGen::Logger::ERRORS_ONLY,       __VA_ARGS__) /*!< Logs an error         */
+#define INFO(...)  LOG_MESSAGE(ModGen::Logger::ERRORS_INFO,       __VA_ARGS__) /*!< Logs an information   */
+#define DEBUG(...) LOG_MESSAGE(ModGen::Logger::ERRORS_INFO_DEBUG, __VA_ARGS__) /*!< Logs a debug message  */
+
+/*!
+ * \brief LOG_RECORD logs a record with the specified trace level and format
+ *        (Cf. LOGFORMATID). Its arguments (integers and strings) are copied
+ *        as is: the message is only built by the writer of the logger, or by
+ *        the decoder of the binary logs.
+ */
+#define LOG_RECORD(p_traceLevel, p_format, ...)                         \
+    do {                                                                \
+        if constexpr((p_traceLevel) <= LOG_LEVEL_MAX)                   \
+        {                                                               \
+            if(ModGen::Logger::isEnabled(p_traceLevel))                 \
+            {                                                           \
+                ModGen::Logger::record((p_traceLevel), (p_format),      \
+                                       __VA_ARGS__);                    \
+            }                                                           \
+        }                                                               \
+    } while(0)
+
 namespace ModGen {
 
 /*!
@@ -21,11 +75,8 @@ namespace ModGen {
  * for the <b> ModelGenerator Library </b>.
  */
 
-void ERROR(const std::string& p_msg);
-void INFO (const std::string& p_msg);
-void DEBUG(const std::string& p_msg);
-void DEBUG(const std::vector<uint8_t> &p_byteArray);
 void WRITE(const std::string& p_msg, const int32_t& p_traceLevel);
+void WRITE(const std::vector<uint8_t>& p_byteArray, const int32_t& p_traceLevel);
 
 /**
  * @brief The Logger class manages the data to log and to display.
@@ -50,6 +101,27 @@ public:
      */
     static void setLogFile(const std::string& p_filePath);
 
+    /**
+     * @brief setBinary selects the format of the log files
+     *        (applied at the next opening of a log file).
+     * @param p_binary true to write the records in binary (Cf. LogFormat::decode),
+     *        false to write them as text.
+     */
+    static void setBinary(bool p_binary);
+
+    /**
+     * @brief record logs a record whose message is built later (Cf. LOG_RECORD)
+     * @param p_traceLevel the level of trace of the record
+     * @param p_format the format of the record (Cf. LOGFORMATID)
+     * @param p_args the arguments of the format
+     */
+    template<typename... Args>
+    static void record(TRACELEVELS p_traceLevel, uint16_t p_format, const Args&... p_args)
+    {
+        char l_args[LogRecord::LOG_TEXT_SIZE];
+        push(p_traceLevel, p_format, l_args, LogFormat::pack(l_args, sizeof(l_args), p_args...));
+    }
+
     /**
      * @brief setTraceLevel set the level of data to be traced
      * <ul>
@@ -67,6 +139,19 @@ public:
      */
     static bool isDebugEnabled();
 
+    /**
+     * @brief isEnabled tells whether the messages of a trace level
+     *        are logged (level compiled in, log file opened and
+     *        trace level high enough).
+     * @param p_traceLevel the level of trace of the messages
+     * @return true if the messages are logged.
+     */
+    static bool isEnabled(TRACELEVELS p_traceLevel)
+    {
+        return p_traceLevel <= LOG_LEVEL_MAX &&
+               p_traceLevel <= enabledLevel.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief isOpened
      * @return true if the log file is opened.
@@ -88,10 +173,29 @@ public:
     static void setup(const std::string& p_filePath, TRACELEVELS p_traceLevel);
 
     /**
-     * @brief close closes the current log file.
+     * @brief close closes the current log file
+     *        (once every pending record has been written).
      */
     static void closeLogs();
-    
+
+    /**
+     * @brief flush waits until every pending record has been written
+     *        to the log file.
+     */
+    static void flush();
+
+    /**
+     * @brief getDropCount
+     * @return the number of records dropped because the ring was full.
+     */
+    static uint64_t getDropCount();
+
+    /**
+     * @brief getOverflowCount
+     * @return the number of messages truncated to the size of a record.
+     */
+    static uint64_t getOverflowCount();
+
 private:
     /**
      * @brief Logger Default constructor
@@ -128,40 +232,74 @@ private:
                        TRACELEVELS                 p_traceLevel);
 
     /**
-     * @brief ERROR displays errors only 
-     * @param p_msg error message to display
+     * @brief push adds a record to the ring if its trace level is logged.
+     * @param p_traceLevel the level of trace of the record.
+     * @param p_format the format of the record.
+     * @param p_text the message or the packed arguments of the record.
+     * @param p_length their size (truncated to the size of a record).
      */
-    friend void ERROR(const std::string& p_msg);
+    static void push(TRACELEVELS p_traceLevel,
+                     uint16_t    p_format,
+                     const char* p_text,
+                     std::size_t p_length);
 
     /**
-     * @brief INFO displays information and errors
-     * @param p_msg message to display
+     * @brief startWriter starts the thread writing the records to the log file.
      */
-    friend void INFO(const std::string& p_msg);
+    void startWriter();
 
     /**
-     * @brief DEBUG displays debug informations
-     * @param p_msg message to display
+     * @brief stopWriter stops the thread writing the records to the log file
+     *        once every pending record has been written.
      */
-    friend void DEBUG(const std::string& p_msg);
+    void stopWriter();
 
     /**
-     * @brief DEBUG displays debug informations
-     * @param p_msg byteArray message to display
+     * @brief writeRecords is the loop of the writer thread: the records are
+     *        formatted and written to the log file by batches.
      */
-    friend void DEBUG(const std::vector<uint8_t>& p_byteArray);
+    void writeRecords();
 
     /**
-     * @brief DEBUG displays default informations
-     * @param p_msg byteArray message to display
+     * @brief updateLevel computes the level of trace checked
+     *        by isEnabled (NO_LOGS when the log file is closed).
+     */
+    void updateLevel();
+
+    /**
+     * @brief WRITE logs a message with the specified trace level
+     * @param p_msg message to display
+     * @param p_traceLevel the level of trace of the message
      */
     friend void WRITE(const std::string& p_msg, 
                       const int32_t&     p_traceLevel);
 
+    /**
+     * @brief WRITE logs a message with the specified trace level
+     * @param p_byteArray byteArray message to display
+     * @param p_traceLevel the level of trace of the message
+     */
+    friend void WRITE(const std::vector<uint8_t>& p_byteArray,
+                      const int32_t&              p_traceLevel);
+
 private:
-    std::ofstream* logFile;    /*!< The stream used for the logs.  */
-    std::string*   logName;    /*!< The file name used for logs.   */
-    TRACELEVELS    traceLevel; /*!< current saved level of trace.  */
+    static const std::size_t RING_CAPACITY = 8192; /*!< Number of records of the ring   */
+    static const std::size_t WRITE_BATCH   = 256;  /*!< Records written at once (max)   */
+
+    std::ofstream*           logFile;    /*!< The stream used for the logs.              */
+    std::string*             logName;    /*!< The file name used for logs.               */
+    std::atomic<TRACELEVELS> traceLevel; /*!< current saved level of trace.              */
+    std::atomic<bool>        opened;     /*!< The log file is opened (for the producers) */
+    bool                     binary;     /*!< The log file is written in binary          */
+
+    LogRing                  ring;       /*!< Records waiting to be written              */
+    std::thread              writer;     /*!< Thread writing the records                 */
+    std::atomic<bool>        running;    /*!< The writer thread must keep running        */
+    std::atomic<bool>        writing;    /*!< The writer thread is writing a batch       */
+    std::mutex               wakeMutex;  /*!< Mutex of the wake-up condition             */
+    std::condition_variable  wakeUp;     /*!< Wakes the writer thread up                 */
+
+    static std::atomic<int32_t> enabledLevel; /*!< Level of the logged messages (Cf. isEnabled) */
 };
 
 } // namespace ModGen
@@ -0,0 +1,404 @@
+/*!
+ * @file   CompiledModel.cpp
+ * @brief  Implementations of the functions defined in \a CompiledModel.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <thread>
+
+#include "CompiledModel.h"
+#include "Exception.h"
+#include "Logger.h"
+#include "random_util.h"
+#include "time_util.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+CompiledModel::CompiledModel() :
+    definition(),
+    shared(nullptr),
+    block(),
+    values(0),
+    versions(0),
+    counters(0),
+    watches(0),
+    current(0),
+    next(0),
+    parked(false),
+    resumed(false),
+    wake_up()
+{}
+
+////////////////////////////////////////////////////////////////////////
+CompiledModel::CompiledModel(shared_ptr<const ModelDefinition> p_definition, VariableStore* p_shared) :
+    CompiledModel()
+{
+    setup(move(p_definition), p_shared);
+}
+
+////////////////////////////////////////////////////////////////////////
+CompiledModel::CompiledModel(const CompiledModel& p_other) :
+    CompiledModel()
+{
+    *this = p_other;
+}
+
+////////////////////////////////////////////////////////////////////////
+CompiledModel& CompiledModel::operator=(const CompiledModel& p_other)
+{
+    if(this == &p_other)
+    {
+        return *this;
+    }
+
+    definition = p_other.definition;
+    block      = p_other.block;
+    values     = p_other.values;
+    versions   = p_other.versions;
+    counters   = p_other.counters;
+    watches    = p_other.watches;
+    current    = p_other.current;
+    next       = p_other.next;
+    parked     = p_other.parked;
+    resumed    = p_other.resumed;
+    wake_up    = p_other.wake_up;
+
+    // The copy has variables of its own: those shared are copied into the block
+    shared = nullptr;
+    if(p_other.shared)
+    {
+        for(uint32_t i = 0; i < definition->getVariablesCount(); i++)
+        {
+            block[values   + i] = static_cast<uint32_t>(p_other.shared->get(i));
+            block[versions + i] = p_other.shared->getVersion(i);
+        }
+    }
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+void CompiledModel::setup(shared_ptr<const ModelDefinition> p_definition, VariableStore* p_shared)
+{
+    definition = move(p_definition);
+    shared     = p_shared;
+    if(!definition)
+    {
+        clear();
+        return;
+    }
+
+    values   = definition->getValuesOffset();
+    versions = definition->getVersionsOffset();
+    counters = definition->getCountersOffset();
+    watches  = definition->getWatchesOffset();
+    reset();
+}
+
+////////////////////////////////////////////////////////////////////////
+void CompiledModel::clear()
+{
+    definition.reset();
+    shared = nullptr;
+    block.clear();
+
+    current = 0;
+    next    = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+void CompiledModel::reset()
+{
+    if(!definition)
+    {
+        return;
+    }
+
+    // The initial image holds the initial values and the transitions always made
+    block.assign(definition->getBlock(), definition->getBlock() + definition->getBlockSize());
+    if(shared)
+    {
+        shared->reset();
+    }
+    for(uint32_t w = 0; w < definition->watches.size(); w++)
+    {
+        evaluate(w, getVersion(definition->watches[w].var));
+    }
+
+    current = definition->getStart();
+    next    = current;
+    parked  = false;
+    resumed = false;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t CompiledModel::nextState()
+{
+    if(!definition || next >= definition->states.size())
+    {
+        ERROR("Error - Unable to run the compiled model - no valid state found.");
+        throw Exception::IntegrityCheckException<CompiledModel>("Unable to run the compiled model - no valid state found.");
+    }
+
+    current = next;
+    return current;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline void CompiledModel::evaluate(uint32_t p_watch, uint32_t p_version)
+{
+    const ModelDefinition& l_def   = *definition;
+    const CompiledWatch&   l_watch = l_def.watches[p_watch];
+
+    block[watches + p_watch] = p_version;
+    int32_t l_value = getValue(l_watch.var);
+
+    for(uint32_t d = l_watch.dep_begin; d < l_watch.dep_end; d++)
+    {
+        uint32_t                  l_index = l_def.dependents[d];
+        const CompiledTransition& l_trans = l_def.transitions[l_index];
+
+        bool l_made;
+        switch(l_trans.kind)
+        {
+        case ModelDefinition::TRANS_OVER:  l_made = (l_value >  l_trans.value); break;
+        case ModelDefinition::TRANS_UNDER: l_made = (l_value <  l_trans.value); break;
+        default:                           l_made = (l_value == l_trans.value); break;
+        }
+
+        uint32_t l_bit = uint32_t(1) << (l_index % 32);
+        block[l_index / 32] = l_made ? (block[l_index / 32] |  l_bit)
+                                     : (block[l_index / 32] & ~l_bit);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool CompiledModel::runLoop(const CompiledTransition& p_trans)
+{
+    // Same as LoopTransition::run - the last iteration is not made
+    uint32_t& l_counter = block[counters + p_trans.slot];
+    if(static_cast<int32_t>(++l_counter) != p_trans.value)
+    {
+        return true;
+    }
+    l_counter = 0;
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline uint32_t CompiledModel::findMade(uint32_t p_begin, uint32_t p_end) const
+{
+    // The cached conditions are the first words of the block
+    for(uint32_t i = p_begin; i < p_end; i = (i / 32 + 1) * 32)
+    {
+        uint32_t l_word = block[i / 32] >> (i % 32);
+        if(l_word)
+        {
+#if defined(__GNUC__)
+            uint32_t l_found = i + static_cast<uint32_t>(__builtin_ctz(l_word));
+#else
+            uint32_t l_found = i;
+            for(; !(l_word & 1); l_word >>= 1)
+            {
+                l_found++;
+            }
+#endif
+            return (l_found < p_end) ? l_found : p_end;
+        }
+    }
+    return p_end;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline uint32_t CompiledModel::findIndexed(const CompiledState& p_state)
+{
+    const ModelDefinition& l_def = *definition;
+
+    // Only the conditions on the variables which changed are evaluated
+    // again (the versions are read before the values: no change is missed)
+    for(uint32_t w = p_state.watch_begin; w < p_state.watch_end; w++)
+    {
+        uint32_t l_version = getVersion(l_def.watches[w].var);
+        if(l_version != block[watches + w])
+        {
+            evaluate(w, l_version);
+        }
+    }
+
+    // The cached conditions are made: only the loops are run
+    uint32_t i = findMade(p_state.trans_begin, p_state.trans_end);
+    while(i < p_state.trans_end && l_def.transitions[i].kind == ModelDefinition::TRANS_LOOP && !runLoop(l_def.transitions[i]))
+    {
+        i = findMade(i + 1, p_state.trans_end);
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t CompiledModel::step()
+{
+    if(!definition || current >= definition->states.size())
+    {
+        ERROR("Error - Unable to run the compiled model - no valid state found.");
+        throw Exception::IntegrityCheckException<CompiledModel>("Unable to run the compiled model - no valid state found.");
+    }
+
+    const ModelDefinition& l_def   = *definition;
+    const CompiledState&   l_state = l_def.states[current];
+
+    // A resumed state was not left: its operations were already run
+    uint32_t l_opBegin = resumed ? l_state.op_end : l_state.op_begin;
+    parked  = false;
+    resumed = false;
+
+    for(uint32_t i = l_opBegin; i < l_state.op_end; i++)
+    {
+        const CompiledOperation& l_op = l_def.operations[i];
+        switch(l_op.kind)
+        {
+        case ModelDefinition::OPER_ADD:    addValue(l_op.var,  l_op.value); break;
+        case ModelDefinition::OPER_SUB:    addValue(l_op.var, -l_op.value); break;
+        case ModelDefinition::OPER_ASSIGN: setValue(l_op.var,  l_op.value); break;
+        default:                           setValue(l_op.var,  0);          break;
+        }
+    }
+
+    if(l_state.flags & ModelDefinition::STATE_INDEXED)
+    {
+        uint32_t l_made = findIndexed(l_state);
+        if(l_made < l_state.trans_end)
+        {
+            next = l_def.transitions[l_made].dest;
+            return l_def.transitions[l_made].delay;
+        }
+    }
+    else
+    {
+        // A waiting state keeps the versions of its variables (Cf. park)
+        for(uint32_t w = l_state.watch_begin; w < l_state.watch_end; w++)
+        {
+            block[watches + w] = getVersion(l_def.watches[w].var);
+        }
+
+        for(uint32_t i = l_state.trans_begin; i < l_state.trans_end; i++)
+        {
+            const CompiledTransition& l_trans = l_def.transitions[i];
+
+            bool l_made = false;
+            switch(l_trans.kind)
+            {
+            case ModelDefinition::TRANS_LOOP:  l_made = runLoop(l_trans);                          break;
+            case ModelDefinition::TRANS_OVER:  l_made = (getValue(l_trans.slot) >  l_trans.value); break;
+            case ModelDefinition::TRANS_UNDER: l_made = (getValue(l_trans.slot) <  l_trans.value); break;
+            case ModelDefinition::TRANS_EQUAL: l_made = (getValue(l_trans.slot) == l_trans.value); break;
+            default:                           l_made = true;                                      break;
+            }
+
+            if(l_made)
+            {
+                next = l_trans.dest;
+                return l_trans.delay;
+            }
+        }
+    }
+
+    if(l_state.flags & ModelDefinition::STATE_WAIT)
+    {
+        parked  = true;
+        wake_up = l_state.timeout ? VariableStore::TimePoint::clock::now() + chrono::microseconds(l_state.timeout)
+                                  : VariableStore::TimePoint::max();
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t CompiledModel::encodeMessage(uint32_t p_state, size_t p_index, uint8_t* p_buffer, size_t p_capacity)
+{
+    if(!definition || p_state >= definition->states.size() || p_index >= definition->getMessagesCount(p_state))
+    {
+        ERROR("Error - Unable to encode the message " + to_string(p_index) + " of the state " + to_string(p_state) + ".");
+        throw Exception::IntegrityCheckException<CompiledModel>("Unable to encode the message " + to_string(p_index) + " of the state " + to_string(p_state) + ".");
+    }
+
+    return definition->encode(definition->getMessage(p_state, p_index), p_buffer, p_capacity, block.data());
+}
+
+////////////////////////////////////////////////////////////////////////
+void CompiledModel::seed(uint64_t p_seed)
+{
+    if(!definition)
+    {
+        return;
+    }
+
+    // One seed per message, drawn from the seed of the instance
+    RandomGenerator l_seeds(p_seed);
+    for(uint32_t m = 0; m < definition->getMessagesTotal(); m++)
+    {
+        uint32_t l_offset = definition->getRandomOffset(m);
+        if(l_offset != ModelDefinition::NO_RANDOM)
+        {
+            uint64_t l_seed;
+            l_seeds.fill(reinterpret_cast<uint8_t*>(&l_seed), sizeof(l_seed));
+            RandomGenerator(l_seed).save(&block[l_offset]);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+bool CompiledModel::park(uint64_t p_max_us)
+{
+    if(!parked)
+    {
+        return true;
+    }
+
+    const ModelDefinition& l_def   = *definition;
+    const CompiledState&   l_state = l_def.states[current];
+
+    // Virtual time: the timeout advances the clock instead of being waited
+    if(l_state.timeout && TimeUtil::isVirtual())
+    {
+        TimeUtil::advanceVirtual(l_state.timeout);
+        parked  = false;
+        resumed = true;
+        return true;
+    }
+
+    VariableStore::TimePoint l_now      = VariableStore::TimePoint::clock::now();
+    VariableStore::TimePoint l_deadline = (wake_up - l_now > chrono::microseconds(p_max_us)) ? l_now + chrono::microseconds(p_max_us)
+                                                                                              : wake_up;
+
+    // Nobody else changes the variables of the block: only the timeout can end the park
+    bool l_changed = false;
+    if(shared)
+    {
+        l_changed = shared->wait(l_deadline, [&]()
+        {
+            for(uint32_t w = l_state.watch_begin; w < l_state.watch_end; w++)
+            {
+                if(shared->getVersion(l_def.watches[w].var) != block[watches + w])
+                {
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+    else if(l_deadline > l_now)
+    {
+        this_thread::sleep_until(l_deadline);
+    }
+
+    if(l_changed || VariableStore::TimePoint::clock::now() >= wake_up)
+    {
+        parked  = false;
+        resumed = true;
+    }
+    return resumed;
+}
+
+} // namespace ModGen
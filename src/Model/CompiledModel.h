@@ -0,0 +1,347 @@
+/*!
+ * @file   CompiledModel.h
+ * @brief  Contains an instance of the flattened form of the finite
+ *         state machine, used to run it without the object graph.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef COMPILEDMODEL_MODELGENERATOR
+#define COMPILEDMODEL_MODELGENERATOR
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ModelDefinition.h"
+#include "VariableStore.h"
+
+namespace ModGen {
+
+/*!
+ * \brief The CompiledModel class is an instance of a compiled model: the
+ *        runtime state of a \a ModelDefinition, which it shares (read only)
+ *        with the other instances of the model.
+ *
+ *        The runtime state is the current and next states, and a block of words
+ *        laid out by the definition (Cf. ModelDefinition::getBlockSize): the cached
+ *        conditions, the variables, the loop counters and the versions of the
+ *        variables read by the states. A new instance is a copy of the initial
+ *        image of the block, and a copy of an instance is a copy of its block:
+ *        many instances of a model cost a few tens of bytes each, and can be run
+ *        by several threads (one instance is only run by one thread at a time).
+ *
+ *        The instance of a \a ModelInstance uses the variables of the model
+ *        instead (Cf. VariableStore), so that they can be driven by other threads
+ *        while the model runs; the variables of the other instances are in their
+ *        block (Cf. getVariable).
+ *        A waiting state (Cf. State::isWaiting) whose conditions are all false
+ *        is parked: it is run again once one of its variables changed (Cf. park).
+ *
+ *        The results of the conditions of the states with many conditions on
+ *        a few variables (Cf. ModelDefinition::INDEXED_CONDITIONS) are cached in
+ *        a bitset: such a state indexes the transitions reading each of its variables
+ *        (Cf. ModelDefinition::CompiledWatch), and only the conditions on the variables
+ *        which changed since they were last evaluated are evaluated again. The transition
+ *        made is the first set bit of the state (declaration order). The other states
+ *        test their transitions in turn (cheaper for a few conditions).
+ */
+class CompiledModel
+{
+public:
+    typedef ModelDefinition::CompiledState      CompiledState;
+    typedef ModelDefinition::CompiledWatch      CompiledWatch;
+    typedef ModelDefinition::CompiledOperation  CompiledOperation;
+    typedef ModelDefinition::CompiledTransition CompiledTransition;
+
+    /*!
+     * \brief CompiledModel default constructor (no definition)
+     */
+    CompiledModel();
+
+    /*!
+     * \brief CompiledModel constructor of a new instance, in its start state.
+     * \param p_definition the definition of the model.
+     * \param p_shared the variables of the model, shared with other threads
+     *        (null for variables of its own).
+     */
+    explicit CompiledModel(std::shared_ptr<const ModelDefinition> p_definition,
+                           VariableStore*                         p_shared = nullptr);
+
+    /*!
+     * \brief CompiledModel copy constructor: the copy is in the same state,
+     *        with variables of its own (their current values).
+     * \param p_other the instance to copy.
+     */
+    CompiledModel(const CompiledModel& p_other);
+
+    /*!
+     * \brief operator = copies the state of an instance (Cf. copy constructor).
+     * \param p_other the instance to copy.
+     */
+    CompiledModel& operator=(const CompiledModel& p_other);
+
+    /*!
+     * \brief setup makes the instance a new instance of a definition.
+     * \param p_definition the definition of the model.
+     * \param p_shared the variables of the model, shared with other threads
+     *        (null for variables of its own).
+     */
+    void setup(std::shared_ptr<const ModelDefinition> p_definition, VariableStore* p_shared = nullptr);
+
+    /*!
+     * \brief clear drops the definition and the runtime state.
+     */
+    void clear();
+
+    /*!
+     * \brief reset restores the initial runtime state (start state, variables
+     *        of the model, loop counters and generators of the messages).
+     */
+    void reset();
+
+    /*!
+     * \brief nextState makes the model go into its next state.
+     * \return the index of the current state.
+     */
+    uint32_t nextState();
+
+    /*!
+     * \brief step runs the operations then the transitions of the current state
+     *        (only the transitions when the state is resumed, Cf. park).
+     *        The delay is not waited (Cf. Scheduler).
+     * \return the delay (us) to wait before the next state, 0 if no transition is made.
+     */
+    uint64_t step();
+
+    /*!
+     * \brief isParked
+     * \return true if the last step made no transition on a waiting state
+     *         (Cf. park).
+     */
+    bool isParked() const { return parked; }
+
+    /*!
+     * \brief park blocks while the current state is parked, until one of the
+     *        variables it tests changes or its timeout is reached - the state
+     *        is then resumed by the next call to nextState. The variables of
+     *        an instance which does not share them only change with its states:
+     *        only the timeout is waited.
+     * \param p_max_us the maximum time (us) to block (i.e. to check for a stop request).
+     * \return true if the state is to be resumed, false if it is still parked.
+     */
+    bool park(uint64_t p_max_us);
+
+    /*!
+     * \brief getCurrent
+     * \return the index of the current state.
+     */
+    uint32_t getCurrent() const { return current; }
+
+    /*!
+     * \brief getNext
+     * \return the index of the next state.
+     */
+    uint32_t getNext() const { return next; }
+
+    /*!
+     * \brief getDefinition
+     * \return the definition of the model (null if none).
+     */
+    const std::shared_ptr<const ModelDefinition>& getDefinition() const { return definition; }
+
+    /*!
+     * \brief getStateName
+     * \param p_state the index of a state.
+     * \return the name ID of the state.
+     */
+    std::string_view getStateName(uint32_t p_state) const { return definition->getStateName(p_state); }
+
+    /*!
+     * \brief getStatesCount
+     * \return the number of compiled states.
+     */
+    std::size_t getStatesCount() const { return definition ? definition->getStatesCount() : 0; }
+
+    /*!
+     * \brief getTransitionsCount
+     * \return the number of compiled transitions.
+     */
+    std::size_t getTransitionsCount() const { return definition ? definition->getTransitionsCount() : 0; }
+
+    /*!
+     * \brief getMessagesCount
+     * \return the number of messages of the current state.
+     */
+    std::size_t getMessagesCount() const
+    {
+        const CompiledState& l_state = definition->states[current];
+        return (resumed && !(l_state.flags & ModelDefinition::STATE_RESEND)) ? 0 : l_state.mesg_end - l_state.mesg_begin;
+    }
+
+    /*!
+     * \brief getMessageSize
+     * \param p_index the index of a message of the current state.
+     * \return the size (bytes) of the encoded message.
+     */
+    uint32_t getMessageSize(std::size_t p_index) const
+    {
+        return definition->getMessageSize(definition->getMessage(current, p_index));
+    }
+
+    /*!
+     * \brief getRoute
+     * \param p_index the index of a message of the current state.
+     * \return the addressing of the message.
+     */
+    const ModelDefinition::Route& getRoute(std::size_t p_index) const
+    {
+        return definition->getRoute(definition->getMessage(current, p_index));
+    }
+
+    /*!
+     * \brief encodeMessage encodes a message of the current state
+     *        (Cf. encodeMessage of a state).
+     */
+    uint32_t encodeMessage(std::size_t p_index, uint8_t* p_buffer, std::size_t p_capacity)
+    {
+        return encodeMessage(current, p_index, p_buffer, p_capacity);
+    }
+
+    /*!
+     * \brief encodeMessage encodes a message of a state into a caller-owned buffer.
+     *        The DATA part is drawn from the generator of the message in the block
+     *        of the instance: the payloads of an instance do not depend on the
+     *        thread encoding them, and a copy of the instance continues its streams.
+     * \param p_state the index of a state.
+     * \param p_index the index of a message of the state.
+     * \param p_buffer the buffer to write the message to.
+     * \param p_capacity the size (bytes) of the buffer.
+     * \return the number of bytes written (Cf. getMessageSize).
+     * \throw Exception::BufferOverflow if the buffer is too small.
+     */
+    uint32_t encodeMessage(uint32_t p_state, std::size_t p_index, uint8_t* p_buffer, std::size_t p_capacity);
+
+    /*!
+     * \brief seed seeds again the generators of the messages of the
+     *        instance (e.g. one seed per instance, for reproducible runs).
+     * \param p_seed the seed.
+     */
+    void seed(uint64_t p_seed);
+
+    /*!
+     * \brief getVariable
+     * \param p_id the ID of a variable (Cf. ModelInstance::ModelSymbols).
+     * \return the value of the variable.
+     */
+    int32_t getVariable(SymbolTable::ID p_id) const { return getValue(p_id); }
+
+    /*!
+     * \brief setVariable sets a variable of the instance (from the thread
+     *        running it - the shared variables are set through the model).
+     * \param p_id the ID of a variable (Cf. ModelInstance::ModelSymbols).
+     * \param p_value the value.
+     */
+    void setVariable(SymbolTable::ID p_id, int32_t p_value) { setValue(p_id, p_value); }
+
+    /*!
+     * \brief getRuntimeSize
+     * \return the size (bytes) of the runtime block of the instance.
+     */
+    std::size_t getRuntimeSize() const { return block.size() * sizeof(uint32_t); }
+
+private:
+    /*!
+     * \brief getValue
+     * \return the value of a variable.
+     */
+    int32_t getValue(uint32_t p_var) const
+    {
+        return shared ? shared->get(p_var) : static_cast<int32_t>(block[values + p_var]);
+    }
+
+    /*!
+     * \brief getVersion
+     * \return the number of changes of a variable.
+     */
+    uint32_t getVersion(uint32_t p_var) const
+    {
+        return shared ? shared->getVersion(p_var) : block[versions + p_var];
+    }
+
+    /*!
+     * \brief setValue sets a variable (a new version).
+     */
+    void setValue(uint32_t p_var, int32_t p_value)
+    {
+        if(shared)
+        {
+            shared->set(p_var, p_value);
+            return;
+        }
+        block[values + p_var] = static_cast<uint32_t>(p_value);
+        block[versions + p_var]++;
+    }
+
+    /*!
+     * \brief addValue adds a value to a variable (a new version).
+     */
+    void addValue(uint32_t p_var, int32_t p_value)
+    {
+        if(shared)
+        {
+            shared->add(p_var, p_value);
+            return;
+        }
+        block[values + p_var] += static_cast<uint32_t>(p_value);
+        block[versions + p_var]++;
+    }
+
+    /*!
+     * \brief evaluate evaluates again the conditions of a state on a variable.
+     * \param p_watch the index of the variable read by the state.
+     * \param p_version the version of the variable (read before its value).
+     */
+    void evaluate(uint32_t p_watch, uint32_t p_version);
+
+    /*!
+     * \brief runLoop runs a loop transition (Cf. ModelDefinition::TRANS_LOOP).
+     * \param p_trans the transition.
+     * \return true if the transition is made.
+     */
+    bool runLoop(const CompiledTransition& p_trans);
+
+    /*!
+     * \brief findMade
+     * \return the index of the first transition of [p_begin, p_end) whose
+     *         bit is set (made, or a loop to run), p_end if none.
+     */
+    uint32_t findMade(uint32_t p_begin, uint32_t p_end) const;
+
+    /*!
+     * \brief findIndexed runs the transitions of a state from the cached conditions.
+     * \return the index of the transition made, trans_end if none.
+     */
+    uint32_t findIndexed(const CompiledState& p_state);
+
+private:
+    std::shared_ptr<const ModelDefinition> definition; /*!< The model (shared by the instances)        */
+    VariableStore*                         shared;     /*!< Shared variables (null: in the block)      */
+    std::vector<uint32_t>                  block;      /*!< Runtime block (Cf. ModelDefinition)        */
+    uint32_t                               values;     /*!< Values of the variables (block)            */
+    uint32_t                               versions;   /*!< Versions of the variables (block)          */
+    uint32_t                               counters;   /*!< Counters of the loop transitions (block)   */
+    uint32_t                               watches;    /*!< Versions of the watches (block)            */
+    uint32_t                               current;    /*!< Index of the current state                 */
+    uint32_t                               next;       /*!< Index of the next state                    */
+    bool                                   parked;     /*!< The current state is parked                */
+    bool                                   resumed;    /*!< The current state is resumed               */
+    VariableStore::TimePoint               wake_up;    /*!< End of the park (timeout of the state)     */
+};
+
+} // namespace ModGen
+
+#endif // COMPILEDMODEL_MODELGENERATOR
@@ -0,0 +1,525 @@
+/*!
+ * @file   ConfLoader.cpp
+ * @brief  Implementations of the functions defined in \a ConfLoader.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <errno.h>
+#include <cstring>
+#include <limits>
+
+#include "ConfLoader.h"
+#include "ConfReader.h"
+#include "ModelInstance.h"
+#include "Model.h"
+#include "Message.h"
+#include "Field.h"
+#include "Conf_format.h"
+#include "Exception.h"
+#include "Logger.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+ConfLoader::ConfLoader(ModelInstance& p_model) :
+    model(p_model),
+    root(false),
+    section(SECTION_NONE),
+    block(BLOCK_NONE),
+    header(),
+    state(nullptr),
+    stateId(SymbolTable::NONE),
+    operation(),
+    transition(nullptr),
+    destName()
+{}
+
+////////////////////////////////////////////////////////////////////////
+ConfLoader::~ConfLoader()
+{}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::loadFile(const string& p_filePath)
+{
+    ConfReader l_reader(p_filePath);
+    Attributes l_attributes;
+
+    for(ConfReader::EVENT l_event = l_reader.next(); l_event != ConfReader::END_OF_FILE; l_event = l_reader.next())
+    {
+        if(l_event == ConfReader::START_ELEMENT)
+        {
+            l_attributes.clear();
+            for(size_t i = 0; i < l_reader.getAttributesCount(); i++)
+            {
+                l_attributes.emplace_back(l_reader.getAttributeName(i).c_str(),
+                                          l_reader.getAttributeValue(i).c_str());
+            }
+            startElement(l_reader.getName().c_str(), l_attributes, l_reader.getDepth());
+        }
+        else
+        {
+            endElement(l_reader.getDepth());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::loadDocument(const pugi::xml_document& p_doc)
+{
+    pugi::xml_node l_root = p_doc.child(Conf_format::root.c_str());
+
+    Attributes l_attributes;
+    startElement(l_root.name(), l_attributes, 1);
+
+    // Only the first section of each kind is loaded
+    for(const string* l_section: { &Variables_format::balise, &Messages_format::balise,
+                                   &Headers_format::balise,   &State_format::balise })
+    {
+        pugi::xml_node l_node = l_root.child(l_section->c_str());
+        if(l_node)
+        {
+            loadNode(l_node, 2);
+        }
+    }
+
+    endElement(1);
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::loadNode(const pugi::xml_node& p_node, size_t p_depth)
+{
+    Attributes l_attributes;
+    for (pugi::xml_attribute attr = p_node.first_attribute(); attr; attr = attr.next_attribute())
+    {
+        l_attributes.emplace_back(attr.name(), attr.value());
+    }
+
+    startElement(p_node.name(), l_attributes, p_depth);
+    for (pugi::xml_node l_child = p_node.first_child(); l_child; l_child = l_child.next_sibling())
+    {
+        if(l_child.type() == pugi::node_element)
+        {
+            loadNode(l_child, p_depth + 1);
+        }
+    }
+    endElement(p_depth);
+}
+
+////////////////////////////////////////////////////////////////////////
+ConfLoader::TAG ConfLoader::getTag(const char* p_name)
+{
+    // The names are interned in the order of the TAG enumerate
+    static const SymbolTable& l_tags = []() -> const SymbolTable&
+    {
+        static SymbolTable l_table;
+        for(const string* l_name: { &Conf_format::root,
+                                    &Variables_format::balise,
+                                    &Messages_format::balise,
+                                    &Headers_format::balise,
+                                    &State_format::balise,
+                                    &State_format::balise_2,
+                                    &StateOp_format::balise,
+                                    &StateOp_format::balise_2,
+                                    &StateTransition_format::balise,
+                                    &StateTransition_format::balise_2,
+                                    &StateTransitionLoop_format::balise,
+                                    &StateTransitionCondVar_format::balise,
+                                    &StateTransitionCondDelay_format::balise,
+                                    &StateMessage_format::balise,
+                                    &StateMessage_format::balise_2 })
+        {
+            l_table.intern(*l_name);
+        }
+        return l_table;
+    }();
+
+    SymbolTable::ID l_id = l_tags.find(p_name);
+    return (l_id == SymbolTable::NONE) ? TAG_UNKNOWN : static_cast<TAG>(l_id);
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::startElement(const char* p_name, const Attributes& p_attributes, size_t p_depth)
+{
+    TAG l_tag = getTag(p_name);
+
+    switch(p_depth)
+    {
+    case 1:
+        root = (l_tag == TAG_CONF);
+        break;
+    case 2:
+        section = SECTION_NONE;
+        if(!root)                        { break;                       }
+        else if(l_tag == TAG_VARIABLES)  { section = SECTION_VARIABLES; }
+        else if(l_tag == TAG_MESSAGES)   { section = SECTION_MESSAGES;  }
+        else if(l_tag == TAG_HEADERS)    { section = SECTION_HEADERS;   }
+        else if(l_tag == TAG_STATES)     { section = SECTION_STATES;    }
+        break;
+    case 3:
+        switch(section)
+        {
+        case SECTION_VARIABLES: addVariable(p_attributes);             break;
+        case SECTION_MESSAGES:  addMessage(p_attributes);              break;
+        case SECTION_STATES:    addState(p_name, l_tag, p_attributes); break;
+        case SECTION_HEADERS:
+            header = Header();
+            for(auto& l_attr: p_attributes)
+            {
+                header.setParam(l_attr.first, l_attr.second);
+            }
+            break;
+        default: break;
+        }
+        break;
+    case 4:
+        if(section == SECTION_HEADERS)     { addField(p_name, p_attributes); }
+        else if(section == SECTION_STATES) { startBlock(p_name, l_tag);      }
+        break;
+    case 5:
+        if(section != SECTION_STATES) { break; }
+        switch(block)
+        {
+        case BLOCK_OPERATIONS:  addOperation(p_name, l_tag, p_attributes); break;
+        case BLOCK_TRANSITIONS: startTransit(p_name, l_tag, p_attributes); break;
+        case BLOCK_MESSAGES:    addStateMesg(p_name, l_tag, p_attributes); break;
+        default: break;
+        }
+        break;
+    case 6:
+        if(section == SECTION_STATES && block == BLOCK_TRANSITIONS && !destName.empty())
+        {
+            addCondition(p_name, l_tag, p_attributes);
+        }
+        break;
+    default:
+        // The children of the other elements are ignored
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::endElement(size_t p_depth)
+{
+    switch(p_depth)
+    {
+    case 1: root    = false;        break;
+    case 2: section = SECTION_NONE; break;
+    case 3:
+        if(section == SECTION_HEADERS) { endHeader(); }
+        state   = nullptr;
+        stateId = SymbolTable::NONE;
+        break;
+    case 4:
+        if(section == SECTION_STATES && block == BLOCK_OPERATIONS) { endOperations(); }
+        block = BLOCK_NONE;
+        break;
+    case 5:
+        if(section == SECTION_STATES && block == BLOCK_TRANSITIONS) { endTransition(); }
+        break;
+    default:
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::addVariable(const Attributes& p_attributes)
+{
+    string l_currVar = "";
+    int    l_currVal = -1;
+    for(auto& attr: p_attributes)
+    {
+        if(!strncmp(attr.first, Variables_format::name.c_str(), MAX_NAME_SIZE))
+        {
+            l_currVar = attr.second;
+        }
+        else if(!strncmp(attr.first, Variables_format::init.c_str(), MAX_NAME_SIZE))
+        {
+            errno  = 0;
+            char *ptr;
+            l_currVal = strtol(attr.second, &ptr, 10);
+            if ((errno == ERANGE &&
+                 (l_currVal == numeric_limits<long>::max() || l_currVal == numeric_limits<long>::min())) ||
+                 (errno != 0 && l_currVal == 0) ||
+                 ptr == attr.second)
+            {
+                ERROR("Error - Invalid format for 'init' variable model parameter.");
+                throw Exception::ParsingFileError("Invalid value for variable initialization.");
+            }
+        }
+        else
+        {
+            ERROR("Error - Invalid format of the variable model");
+            throw Exception::ParsingFileParamError<ModelInstance>(string(attr.first));
+        }
+
+        if(!l_currVar.empty() && l_currVal != -1)
+        {
+            model.addVariable(l_currVar, l_currVal);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::addMessage(const Attributes& p_attributes)
+{
+    Message l_currentMesg;
+    for(auto& attr: p_attributes)
+    {
+        l_currentMesg.setParam(attr.first, attr.second);
+    }
+
+    // Message valide (tous les champs obligatoires sont renseignés)
+    if(!l_currentMesg.isValid())
+    {
+        ERROR("Error - Unable to retrieve mandatory parameters for the current message.");
+        throw Exception::ParsingFileError("Unable to retrive every mandatory parameters the for current Message.");
+    }
+    // Ajouter le message à la liste - sauf doublon (ID déjà existant)
+    else if( model.elements->symbols.messages.intern(l_currentMesg.getId()) < model.elements->modelMes.size() )
+    {
+        ERROR("Error - A message with ID (" + l_currentMesg.getId() + ") already exists.");
+        throw Exception::ParsingFileError("A message with ID (" + l_currentMesg.getId() + ") already exists.");
+    }
+    model.elements->modelMes.push_back(l_currentMesg);
+    DEBUG("Added a new message (" + l_currentMesg.getId() + ") to the model.");
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::addField(const char* p_name, const Attributes& p_attributes)
+{
+    Field* l_currField = Field_Creator::Create(p_name, model.elements->arena);
+
+    // Paramètres du champ courant
+    for(auto& attr: p_attributes)
+    {
+        l_currField->setParam(attr.first, attr.second);
+    }
+
+    if(!l_currField->isValid())
+    {
+        ERROR("Error - Unable to retrieve mandatory parameters for the current Field (" + string(p_name) + ").");
+        throw Exception::ParsingFileError("Unable to retrive every mandatory parameters for current Field (" + string(p_name) + ").");
+    }
+
+    header.addField(l_currField);
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::endHeader()
+{
+    if(!header.isValid())
+    {
+        ERROR("Error - Unable to retrieve mandatory parameters for the current Header.");
+        throw Exception::ParsingFileError("Unable to retrive every mandatory parameters for current Header.");
+    }
+    // Ajouter le header à la liste - sauf doublon (ID déjà existant)
+    else if( model.elements->symbols.headers.intern(header.getId()) < model.elements->modelHead.size() )
+    {
+        ERROR("Error - A header with ID (" + header.getId() + ") already exists");
+        throw Exception::ParsingFileError("A header with ID (" + header.getId() + ") already exists.");
+    }
+    model.elements->modelHead.push_back(header);
+
+    DEBUG("Added a new header (" + header.getId() + ") to the model.");
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::addState(const char* p_name, TAG p_tag, const Attributes& p_attributes)
+{
+    State l_currentState;
+    if( p_tag != TAG_STATE )
+    {
+        ERROR("Error - Unable to retrieve the state balise");
+        throw Exception::ParsingFileBaliseError<State>(p_name);
+    }
+
+    for(auto& attr: p_attributes)
+    {
+        l_currentState.setParam(attr.first, attr.second);
+    }
+
+    // State valide (tous les champs obligatoires sont renseignés)
+    if(!l_currentState.isValid())
+    {
+        ERROR("Error - Unable to retrieve the mandatory parameters for current state.");
+        throw Exception::ParsingFileError("Unable to retrive every mandatory parameters for current State.");
+    }
+
+    // Ajouter le state à la liste - sauf doublon (ID déjà existant)
+    stateId = model.elements->symbols.states.intern(l_currentState.getId());
+    if( stateId < model.elements->modelState.size() )
+    {
+        ERROR("Error - A state with ID (" + l_currentState.getId() + ") already exists." );
+        throw Exception::ParsingFileError("A state with ID (" + l_currentState.getId() + ") already exists.");
+    }
+    model.elements->modelState.push_back(l_currentState);
+    state = &model.elements->modelState.back();
+    DEBUG("Added a new State (" + l_currentState.getId() + ") to the model.");
+
+    // Add the first parsed state as start state
+    if(!model.curState && !model.nexState)
+    {
+        model.curState = state;
+        model.nexState = state;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::startBlock(const char* p_name, TAG p_tag)
+{
+    if( p_tag == TAG_OPERATIONS )
+    {
+        block     = BLOCK_OPERATIONS;
+        operation = Operation();
+    }
+    else if( p_tag == TAG_TRANSITIONS )
+    {
+        block = BLOCK_TRANSITIONS;
+    }
+    else if( p_tag == TAG_STATE_MESSAGES )
+    {
+        block = BLOCK_MESSAGES;
+    }
+    else
+    {
+        throw Exception::ParsingFileBaliseError<State>(p_name);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::addOperation(const char* p_name, TAG p_tag, const Attributes& p_attributes)
+{
+    // Mauvaise balise (<Op> attendue)
+    if( p_tag != TAG_OP )
+    {
+        throw Exception::ParsingFileBaliseError<Operation>(p_name);
+    }
+
+    // The variable is resolved by ModelInstance::checkIntegrity
+    for(auto& attr: p_attributes)
+    {
+        operation.setParam(attr.first, attr.second);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::endOperations()
+{
+    if(!operation.isValid())
+    {
+        ERROR("Error - Not enough informations for operation initialization.");
+        throw Exception::ParsingFileError("Not enough informations for operation initialization.");
+    }
+    state->addOperation(operation);
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::startTransit(const char* p_name, TAG p_tag, const Attributes& p_attributes)
+{
+    transition = nullptr;
+    destName.clear();
+
+    // On a soit <Loop> soit <Transit>
+    // Balise <Loop>
+    if(p_tag == TAG_LOOP)
+    {
+        transition = model.elements->arena.create<LoopTransition>();
+
+        transition->setDestState(state, stateId);
+        transition->setParam(StateTransition_format::dest, state->getId());
+
+        for(auto& attr: p_attributes)
+        {
+            transition->setParam(attr.first, attr.second);
+        }
+    }
+    // Balise <Transit>
+    else if(p_tag == TAG_TRANSIT)
+    {
+        for(auto& attr: p_attributes)
+        {
+            // Mauvais paramètre (dest_state attendu)
+            if( !parsingHelper::isEqual(attr.first, StateTransition_format::dest.c_str()) )
+            {
+                throw Exception::ParsingFileBaliseError<StateTransition_format>(p_name);
+            }
+            destName = attr.second;
+        }
+    }
+    else
+    {
+        ERROR("Error - Could not correctly parse the current transition.");
+        throw Exception::ParsingFileBaliseError<StateTransition_format>(p_name);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::addCondition(const char* p_name, TAG p_tag, const Attributes& p_attributes)
+{
+    // Var
+    if(p_tag == TAG_CONDITION)
+    {
+        transition = model.elements->arena.create<VarConditionTransition>();
+    }
+    // Delay
+    else if(p_tag == TAG_DELAY)
+    {
+        transition = model.elements->arena.create<DelayConditionTransition>();
+    }
+    else
+    {
+        throw Exception::UnimplementedElement<StateTransition_format>(p_name);
+    }
+    transition->setParam(StateTransition_format::dest, destName);
+
+    for(auto& attr: p_attributes)
+    {
+        transition->setParam(attr.first, attr.second);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::endTransition()
+{
+    if(!transition)
+    {
+        ERROR("Error - Unable to parse a Transition.");
+        throw Exception::ParsingFileError("Unable to parse a Transition.");
+    }
+    else if(!transition->isValid())
+    {
+        ERROR("Error - Not enough informations for operation initialization.");
+        throw Exception::ParsingFileError("Not enough informations for Transition initialization.");
+    }
+
+    state->addTransition(*transition);
+    transition = nullptr;
+    destName.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+void ConfLoader::addStateMesg(const char* p_name, TAG p_tag, const Attributes& p_attributes)
+{
+    // Mauvaise balise (<State_Mesg> attendue)
+    if( p_tag != TAG_STATE_MESG )
+    {
+        throw Exception::ParsingFileBaliseError<StateMessage_format>(p_name);
+    }
+
+    for(auto& attr: p_attributes)
+    {
+        // Pas le bon paramètre ("name" attendu)
+        if( !parsingHelper::isEqual(attr.first, StateMessage_format::name.c_str()) )
+        {
+            throw Exception::ParsingFileParamError<StateMessage_format>(attr.first);
+        }
+
+        // The message is resolved by ModelInstance::checkIntegrity
+        state->addMessageName(attr.second);
+    }
+}
+
+} // namespace ModGen
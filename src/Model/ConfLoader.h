@@ -0,0 +1,173 @@
+/*!
+ * @file   ConfLoader.h
+ * @brief  Contains the loader building a model from its
+ *         configuration file.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef CONFLOADER_MODELGENERATOR
+#define CONFLOADER_MODELGENERATOR
+
+#include <includes.h>
+
+#include "State.h"
+#include "Header.h"
+
+namespace ModGen {
+
+class ModelInstance;
+
+/**
+ * @brief The ConfLoader class builds the variables, messages, headers and
+ *        states of a model from the elements of its configuration file.
+ *        The elements are either read one by one from the file (streaming,
+ *        the memory used does not depend on the size of the file) or walked
+ *        in a document loaded by pugixml.
+ *        The elements are given their ID when they are defined (Cf.
+ *        ModelInstance::ModelSymbols). The references to states, headers,
+ *        messages and variables are kept by name: they are resolved by
+ *        ModelInstance::checkIntegrity, so the sections of the file can be
+ *        in any order.
+ */
+class ConfLoader
+{
+public:
+    /*!
+     * \brief Attributes the name and value of the attributes of an element
+     */
+    typedef std::vector< std::pair<const char*, const char*> > Attributes;
+
+    /*!
+     * \brief ConfLoader constructor
+     * \param p_model the model to build (cleared by the caller).
+     */
+    explicit ConfLoader(ModelInstance& p_model);
+
+    /*!
+     * \brief ~ConfLoader destructor
+     */
+    ~ConfLoader();
+
+    ConfLoader(const ConfLoader&)            = delete;
+    ConfLoader& operator=(const ConfLoader&) = delete;
+
+    /*!
+     * \brief loadFile builds the model in one pass over the file
+     *        (Cf. ConfReader).
+     * \param p_filePath the path of the configuration file.
+     */
+    void loadFile(const std::string& p_filePath);
+
+    /*!
+     * \brief loadDocument builds the model from a document
+     *        loaded by pugixml (sections walked in the order
+     *        variables, messages, headers and states).
+     * \param p_doc the configuration document.
+     */
+    void loadDocument(const pugi::xml_document& p_doc);
+
+
+private:
+    /**
+     * Enumerate of the sections of the configuration file.
+     */
+    typedef enum {
+        SECTION_NONE      = 0, /*!< Outside of a section (ignored) */
+        SECTION_VARIABLES = 1, /*!< Variables                      */
+        SECTION_MESSAGES  = 2, /*!< Messages                       */
+        SECTION_HEADERS   = 3, /*!< Headers                        */
+        SECTION_STATES    = 4  /*!< States                         */
+    } SECTION;
+
+    /**
+     * Enumerate of the tags of the configuration file (IDs of their
+     * names in the table of the tags, Cf. getTag).
+     */
+    typedef enum {
+        TAG_CONF           = 0,  /*!< Root of the file          */
+        TAG_VARIABLES      = 1,  /*!< Section of the variables  */
+        TAG_MESSAGES       = 2,  /*!< Section of the messages   */
+        TAG_HEADERS        = 3,  /*!< Section of the headers    */
+        TAG_STATES         = 4,  /*!< Section of the states     */
+        TAG_STATE          = 5,  /*!< State                     */
+        TAG_OPERATIONS     = 6,  /*!< Operations of a state     */
+        TAG_OP             = 7,  /*!< Operation                 */
+        TAG_TRANSITIONS    = 8,  /*!< Transitions of a state    */
+        TAG_TRANSIT        = 9,  /*!< Transition                */
+        TAG_LOOP           = 10, /*!< Loop                      */
+        TAG_CONDITION      = 11, /*!< Condition on a variable   */
+        TAG_DELAY          = 12, /*!< Condition on a delay      */
+        TAG_STATE_MESSAGES = 13, /*!< Messages of a state       */
+        TAG_STATE_MESG     = 14, /*!< Message of a state        */
+        TAG_UNKNOWN        = 15  /*!< Any other element         */
+    } TAG;
+
+    /**
+     * Enumerate of the blocks of a state.
+     */
+    typedef enum {
+        BLOCK_NONE        = 0, /*!< Outside of a block      */
+        BLOCK_OPERATIONS  = 1, /*!< Operations of the state */
+        BLOCK_TRANSITIONS = 2, /*!< Transitions             */
+        BLOCK_MESSAGES    = 3  /*!< Messages emitted        */
+    } BLOCK;
+
+    /*!
+     * \brief loadNode walks an element of a document and its children.
+     * \param p_node the element.
+     * \param p_depth the depth of the element (1 for the root).
+     */
+    void loadNode(const pugi::xml_node& p_node, std::size_t p_depth);
+
+    /*!
+     * \brief getTag looks up the name of an element
+     *        (once per element, instead of comparing it to every tag).
+     * \param p_name the name of the element.
+     * \return the tag of the element.
+     */
+    static TAG getTag(const char* p_name);
+
+    /*!
+     * \brief startElement handles a start tag.
+     * \param p_name the name of the element.
+     * \param p_attributes the attributes of the element.
+     * \param p_depth the depth of the element (1 for the root).
+     */
+    void startElement(const char* p_name, const Attributes& p_attributes, std::size_t p_depth);
+
+    /*!
+     * \brief endElement handles an end tag.
+     * \param p_depth the depth of the element (1 for the root).
+     */
+    void endElement(std::size_t p_depth);
+
+    void addVariable   (const Attributes& p_attributes);
+    void addMessage    (const Attributes& p_attributes);
+    void addField      (const char* p_name, const Attributes& p_attributes);
+    void addState      (const char* p_name, TAG p_tag, const Attributes& p_attributes);
+    void startBlock    (const char* p_name, TAG p_tag);
+    void addOperation  (const char* p_name, TAG p_tag, const Attributes& p_attributes);
+    void startTransit  (const char* p_name, TAG p_tag, const Attributes& p_attributes);
+    void addCondition  (const char* p_name, TAG p_tag, const Attributes& p_attributes);
+    void addStateMesg  (const char* p_name, TAG p_tag, const Attributes& p_attributes);
+    void endHeader     ();
+    void endOperations ();
+    void endTransition ();
+
+private:
+    ModelInstance&  model;      /*!< The model built                           */
+    bool            root;       /*!< Inside the root element of the model      */
+    SECTION         section;    /*!< Current section                           */
+    BLOCK           block;      /*!< Current block of the current state        */
+    Header          header;     /*!< Header being built                        */
+    State*          state;      /*!< State being built (in the model)          */
+    SymbolTable::ID stateId;    /*!< ID of the state being built               */
+    Operation       operation;  /*!< Operation being built                     */
+    Transition*     transition; /*!< Transition being built                    */
+    std::string     destName;   /*!< Destination of the transition being built */
+};
+
+} // namespace ModGen
+
+#endif // CONFLOADER_MODELGENERATOR
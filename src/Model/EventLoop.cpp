@@ -0,0 +1,209 @@
+/*!
+ * @file   EventLoop.cpp
+ * @brief  Implementations of the functions defined in \a EventLoop.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include "EventLoop.h"
+#include "CompiledModel.h"
+#include "Exception.h"
+#include "Logger.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+EventLoop::EventLoop() :
+    instances(),
+    due(),
+    ready(),
+    wheel(),
+    tick_us(DEFAULT_TICK_US),
+    poll_us(DEFAULT_POLL_US),
+    origin(),
+    stopped(false),
+    statistics()
+{}
+
+////////////////////////////////////////////////////////////////////////
+void EventLoop::setup(uint64_t p_tick_us, uint64_t p_poll_us)
+{
+    if(!p_tick_us)
+    {
+        ERROR("Error - The tick of the event loop must not be 0.");
+        throw Exception::UnimplementedElement<EventLoop>(0);
+    }
+
+    tick_us = p_tick_us;
+    poll_us = p_poll_us;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t EventLoop::add(CompiledModel& p_model, uint64_t p_start_us)
+{
+    instances.push_back(Instance{ &p_model, p_start_us, p_start_us, p_start_us });
+    return static_cast<uint32_t>(instances.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////
+void EventLoop::clear()
+{
+    instances.clear();
+    ready.clear();
+    wheel.setup(0, 0);
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t EventLoop::now() const
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(Clock::now() - origin).count());
+}
+
+////////////////////////////////////////////////////////////////////////
+void EventLoop::run(const Sender& p_sender, uint64_t p_duration_us)
+{
+    statistics = Statistics();
+    origin     = Clock::now();
+
+    // Every instance is due at its start
+    wheel.setup(instances.size(), 0);
+    ready.clear();
+    for(uint32_t i = 0; i < instances.size(); i++)
+    {
+        instances[i].last     = instances[i].start;
+        instances[i].deadline = instances[i].start;
+        if(instances[i].start)
+        {
+            wheel.schedule(i, toTick(instances[i].start));
+        }
+        else
+        {
+            ready.push_back(i);
+        }
+    }
+
+    while(!stopped.load(memory_order_relaxed))
+    {
+        uint64_t l_now = now();
+        if(p_duration_us && l_now >= p_duration_us)
+        {
+            break;
+        }
+
+        uint64_t l_next = wheel.getNextTick();
+        if(ready.empty() && l_next == TimingWheel::NEVER)
+        {
+            break;
+        }
+
+        // Sleeping until the first deadline (by slices to check for a stop)
+        if(ready.empty() && l_next > l_now / tick_us)
+        {
+            uint64_t l_wakeUp = min(l_next * tick_us, l_now + MAX_SLEEP_US);
+            if(p_duration_us)
+            {
+                l_wakeUp = min(l_wakeUp, p_duration_us);
+            }
+            this_thread::sleep_until(origin + chrono::microseconds(l_wakeUp));
+            continue;
+        }
+
+        // The instances due are collected first: running them schedules them again
+        due.swap(ready);
+        ready.clear();
+        wheel.advance(l_now / tick_us, [this](TimingWheel::ENTRY p_entry) { due.push_back(p_entry); });
+        if(due.empty())
+        {
+            continue;
+        }
+
+        uint64_t l_lateness = 0;
+        for(uint32_t l_index: due)
+        {
+            l_lateness = max(l_lateness, runInstance(l_index, p_sender));
+        }
+        record(l_lateness);
+    }
+
+    stopped.store(false);
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t EventLoop::runInstance(uint32_t p_index, const Sender& p_sender)
+{
+    Instance&      l_instance = instances[p_index];
+    CompiledModel& l_model    = *l_instance.model;
+    uint64_t       l_now      = now();
+
+    // A parked instance is checked without blocking the other ones;
+    // its deadlines restart once it is resumed (Cf. Scheduler::start)
+    if(l_model.isParked())
+    {
+        if(!l_model.park(0))
+        {
+            wheel.schedule(p_index, toTick(l_now + poll_us));
+            return 0;
+        }
+        l_instance.deadline = l_now;
+    }
+
+    // A state following another without delay is due from the run of that one
+    uint64_t l_due      = max(l_instance.deadline, l_instance.last);
+    uint64_t l_lateness = (l_now > l_due) ? l_now - l_due : 0;
+    l_instance.last     = l_now;
+
+    l_model.nextState();
+    p_sender(p_index, l_model);
+    uint64_t l_delay = l_model.step();
+    l_instance.deadline += l_delay;
+
+    // Late by more than one period: the deadlines missed are not run at once
+    // (Cf. Scheduler::LATE_CATCH_UP)
+    if(l_delay && l_instance.deadline + l_delay <= l_now)
+    {
+        l_instance.deadline = l_now;
+    }
+    statistics.steps++;
+
+    // The deadlines already passed (no delay, or late ones caught up, Cf.
+    // Scheduler::LATE_CATCH_UP) are run by the next batch, without sleeping
+    if(l_model.isParked())
+    {
+        wheel.schedule(p_index, toTick(l_now + poll_us));
+    }
+    else if(l_instance.deadline <= l_now)
+    {
+        ready.push_back(p_index);
+    }
+    else
+    {
+        wheel.schedule(p_index, toTick(l_instance.deadline));
+    }
+    return l_lateness;
+}
+
+////////////////////////////////////////////////////////////////////////
+void EventLoop::record(uint64_t p_lateness)
+{
+    statistics.ticks++;
+    statistics.sum_lateness += p_lateness;
+    statistics.max_lateness  = max(statistics.max_lateness, p_lateness);
+    if(p_lateness > tick_us)
+    {
+        statistics.late_ticks++;
+    }
+
+    uint32_t l_bucket = 0;
+    for(uint64_t l_value = p_lateness; l_value && l_bucket + 1 < LATENESS_BUCKETS; l_value >>= 1)
+    {
+        l_bucket++;
+    }
+    statistics.histogram[l_bucket]++;
+}
+
+} // namespace ModGen
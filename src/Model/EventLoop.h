@@ -0,0 +1,177 @@
+/*!
+ * @file   EventLoop.h
+ * @brief  Contains the loop running many compiled models
+ *         on a single thread.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef EVENTLOOP_MODELGENERATOR
+#define EVENTLOOP_MODELGENERATOR
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "TimingWheel.h"
+
+namespace ModGen {
+
+class CompiledModel;
+
+/*!
+ * \brief The EventLoop class multiplexes many instances of models
+ *        (Cf. CompiledModel) on the calling thread.
+ *
+ *        The deadline of every instance (end of the delay of its last transition,
+ *        on an absolute grid, Cf. Scheduler) is scheduled in a timing wheel (Cf.
+ *        TimingWheel) of one tick. The thread sleeps until the first deadline, then
+ *        runs every instance due in a batch: it goes into its next state, its
+ *        messages are given to the sender, and the deadline of its next state is
+ *        scheduled (or it is run by the next batch if that deadline has already
+ *        passed, i.e. transitions without delay). A parked instance (Cf. CompiledModel::park) is checked again
+ *        every poll period instead of blocking the thread.
+ *        The lateness of every batch (the highest lateness of the instances run)
+ *        is measured (Cf. Statistics).
+ *        The loop runs on the system clock only (not on a virtual clock, Cf.
+ *        TimeUtil::startVirtual).
+ */
+class EventLoop
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /*!
+     * \brief The function given an instance (its index and the instance) when it
+     *        goes into a state: it encodes the messages of the state with the
+     *        generators of the instance (Cf. CompiledModel::encodeMessage).
+     */
+    typedef std::function<void(uint32_t, CompiledModel&)> Sender;
+
+    static const uint64_t DEFAULT_TICK_US  = 100;    /*!< Default tick of the wheel (us)            */
+    static const uint64_t DEFAULT_POLL_US  = 1000;   /*!< Default poll of the parked instances (us) */
+    static const uint64_t MAX_SLEEP_US     = 100000; /*!< Longest sleep (us, checks for a stop)     */
+    static const uint32_t LATENESS_BUCKETS = 32;     /*!< Buckets of the lateness histogram         */
+
+    /*!
+     * \brief The Statistics struct holds the counters of a run.
+     */
+    struct Statistics
+    {
+        uint64_t ticks;                        /*!< Number of batches run                      */
+        uint64_t steps;                        /*!< Number of states run                       */
+        uint64_t late_ticks;                   /*!< Batches later than one tick                */
+        uint64_t max_lateness;                 /*!< Highest lateness of a batch (us)           */
+        uint64_t sum_lateness;                 /*!< Sum of the lateness of the batches (us)    */
+        uint64_t histogram[LATENESS_BUCKETS];  /*!< Batches by lateness: bucket b counts those
+                                                    in [2^(b-1), 2^b) us (0 us in bucket 0)     */
+    };
+
+    /*!
+     * \brief EventLoop default constructor (no instance)
+     */
+    EventLoop();
+
+    EventLoop(const EventLoop&)            = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /*!
+     * \brief setup sets the timing parameters.
+     * \param p_tick_us the tick of the wheel (us): the deadlines are rounded up to it.
+     * \param p_poll_us the period (us) at which the parked instances are checked.
+     */
+    void setup(uint64_t p_tick_us, uint64_t p_poll_us);
+
+    /*!
+     * \brief add adds an instance, run from its current state.
+     *        The model must outlive the loop (or be removed by clear).
+     * \param p_model the compiled model of the instance.
+     * \param p_start_us the time (us) from the beginning of the run at which
+     *        the instance starts (to spread the instances of a same model).
+     * \return the index of the instance (given to the sender).
+     */
+    uint32_t add(CompiledModel& p_model, uint64_t p_start_us = 0);
+
+    /*!
+     * \brief clear removes every instance.
+     */
+    void clear();
+
+    /*!
+     * \brief size
+     * \return the number of instances.
+     */
+    std::size_t size() const { return instances.size(); }
+
+    /*!
+     * \brief run runs the instances until stop is called or the duration is reached.
+     *        Every instance is run a first time at its start (Cf. add).
+     * \param p_sender the function given the messages of the instances.
+     * \param p_duration_us the duration (us) of the run, 0 for no limit.
+     */
+    void run(const Sender& p_sender, uint64_t p_duration_us);
+
+    /*!
+     * \brief stop makes run return (can be called from another thread
+     *        or from a signal handler).
+     */
+    void stop() { stopped.store(true); }
+
+    /*!
+     * \brief getStatistics
+     * \return the counters of the last run.
+     */
+    const Statistics& getStatistics() const { return statistics; }
+
+private:
+    /*!
+     * \brief The Instance struct is an instance run by the loop.
+     */
+    struct Instance
+    {
+        CompiledModel* model;    /*!< The compiled model                      */
+        uint64_t       start;    /*!< Start of the instance (us)              */
+        uint64_t       last;     /*!< Time of its last state (us)             */
+        uint64_t       deadline; /*!< Deadline of its next state (us)         */
+    };
+
+    /*!
+     * \brief now
+     * \return the time (us) since the beginning of the run.
+     */
+    uint64_t now() const;
+
+    /*!
+     * \brief toTick
+     * \return the first tick not before a time (us).
+     */
+    uint64_t toTick(uint64_t p_us) const { return (p_us + tick_us - 1) / tick_us; }
+
+    /*!
+     * \brief runInstance runs the next state of a due instance then schedules it.
+     * \return the lateness (us) of the instance.
+     */
+    uint64_t runInstance(uint32_t p_index, const Sender& p_sender);
+
+    /*!
+     * \brief record adds the lateness of a batch to the statistics.
+     */
+    void record(uint64_t p_lateness);
+
+private:
+    std::vector<Instance> instances;  /*!< Instances, by index                    */
+    std::vector<uint32_t> due;        /*!< Instances of the current batch         */
+    std::vector<uint32_t> ready;      /*!< Instances due for the next batch       */
+    TimingWheel           wheel;      /*!< Deadlines of the instances (ticks)     */
+    uint64_t              tick_us;    /*!< Tick of the wheel (us)                 */
+    uint64_t              poll_us;    /*!< Poll period of the parked instances    */
+    Clock::time_point     origin;     /*!< Beginning of the run                   */
+    std::atomic<bool>     stopped;    /*!< A stop has been requested              */
+    Statistics            statistics; /*!< Counters of the last run               */
+};
+
+} // namespace ModGen
+
+#endif // EVENTLOOP_MODELGENERATOR
@@ -7,6 +7,7 @@
 
 #include <bitset>
 #include <cmath>
+#include <cstring>
 #include <limits.h>
 
 #include "Logger.h"
@@ -18,6 +19,7 @@
 #include "Field_size.h"
 #include "Field_time.h"
 #include "Field_id.h"
+#include "ModelArena.h"
 
 namespace ModGen {
 
@@ -98,27 +100,130 @@ template <typename T> T FieldHelper::swap_endian(T p_value)
 }
 
 ////////////////////////////////////////////////////////////////////////
-Field* Field_Creator::Create(const string& p_name)
+uint64_t FieldHelper::reverseBits(uint64_t p_value, uint32_t p_size)
+{
+    uint64_t l_return = 0;
+    for(uint32_t i = 0; i < p_size; i++)
+    {
+        l_return = (l_return << 1) | ((p_value >> i) & 1);
+    }
+    return l_return;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t FieldHelper::toBigEndian(uint64_t p_value)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return p_value;
+#elif defined(__GNUC__)
+    return __builtin_bswap64(p_value);
+#else
+    return swap_endian<uint64_t>(p_value);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t FieldHelper::toBits(int64_t  p_value,
+                             bool     p_bigEndian,
+                             bool     p_swap,
+                             bool     p_invert,
+                             uint32_t p_size,
+                             uint64_t p_mask)
+{
+    // Change endianness if needed
+    if(p_bigEndian)
+    {
+        p_value = swap_endian<int64_t>(p_value);
+    }
+
+    // Swap the value by 16-bit words if needed
+    if(p_swap)
+    {
+        p_value = (p_value & 0x0000FFFF) << 16 | (p_value & 0xFFFF0000) >> 16;
+    }
+
+    // Only the 'size' lowest bits are sent (the value is troncated or filled with 0s)
+    uint64_t l_bits = static_cast<uint64_t>(p_value) & p_mask;
+
+    // Change bits order if "invert" (LSB sent first)
+    if(p_invert)
+    {
+        l_bits = reverseBits(l_bits, p_size);
+    }
+
+    return l_bits;
+}
+
+////////////////////////////////////////////////////////////////////////
+void FieldHelper::writeBits(const FieldLayout& p_layout,
+                            uint32_t           p_size,
+                            uint64_t           p_bits,
+                            uint8_t*           p_data,
+                            size_t             p_capacity)
+{
+    uint8_t* l_data = p_data + p_layout.offset;
+
+    // Byte-aligned field: copy its big endian representation
+    if(p_layout.aligned)
+    {
+        uint64_t l_word = toBigEndian(p_bits << (64 - p_size));
+        memcpy(l_data, &l_word, p_layout.bytes);
+        return;
+    }
+
+    // The field spans more than 64 bits (unaligned 58 to 64 bits fields):
+    // complete its first byte and write the rest from the next byte
+    uint32_t l_span = p_layout.span;
+    if(l_span > 64)
+    {
+        uint32_t l_rest = l_span - 8;
+        *l_data++ |= static_cast<uint8_t>(p_bits >> l_rest);
+        p_bits    &= (1ULL << l_rest) - 1;
+        l_span     = l_rest;
+    }
+
+    uint64_t l_word  = p_bits << (64 - l_span);
+    uint32_t l_bytes = (l_span + 7) / 8;
+
+    // A whole 64-bits word fits in the message: merge it at once
+    if(static_cast<size_t>(l_data - p_data) + 8 <= p_capacity)
+    {
+        uint64_t l_curr;
+        memcpy(&l_curr, l_data, 8);
+        l_curr |= toBigEndian(l_word);
+        memcpy(l_data, &l_curr, 8);
+    }
+    else
+    {
+        for(uint32_t i = 0; i < l_bytes; i++)
+        {
+            l_data[i] |= static_cast<uint8_t>(l_word >> (56 - 8*i));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+Field* Field_Creator::Create(const string& p_name, ModelArena& p_arena)
 {
     if     (p_name.compare(Field_format::balise)      == 0)
     {
         // DEBUG("Creating new simple Field");
-        return new Field;
+        return p_arena.create<Field>();
     }
     else if(p_name.compare(Field_size_format::balise) == 0)
     {
         // DEBUG("Creating new size Field");
-        return new Field_size;
+        return p_arena.create<Field_size>();
     }
     else if(p_name.compare(Field_time_format::balise) == 0)
     {
         // DEBUG("Creating new time Field");
-        return new Field_time;
+        return p_arena.create<Field_time>();
     }
     else if(p_name.compare(Field_id_format::balise)   == 0)
     {
         // DEBUG("Creating new id Field");
-        return new Field_id;
+        return p_arena.create<Field_id>();
     }
 
     throw Exception::ParsingFileParamError<Header>(p_name);
@@ -132,7 +237,8 @@ Field::Field():
     value(-1),
     endianness(_ENDIAN::_UNDEFINED),
     swap(false),
-    invert(false)
+    invert(false),
+    layout()
 {}
 
 ////////////////////////////////////////////////////////////////////////
@@ -143,7 +249,8 @@ Field::Field(const Field& p_other) :
     value(p_other.value),
     endianness(p_other.endianness),
     swap(p_other.swap),
-    invert(p_other.invert)
+    invert(p_other.invert),
+    layout(p_other.layout)
 {}
 
 ////////////////////////////////////////////////////////////////////////
@@ -156,6 +263,7 @@ Field& Field::operator = (const Field &p_other)
     endianness = p_other.endianness;
     swap       = p_other.swap;
     invert     = p_other.invert;
+    layout     = p_other.layout;
 
   return *this;
 }
@@ -261,80 +369,81 @@ string Field::getDesc() const
 }
 
 ////////////////////////////////////////////////////////////////////////
-void Field::addToMessage(vector<uint8_t>& p_mesg)
+void Field::compile(bool p_aligned)
 {
-    // Change endianness if needed
-    switch(endianness)
-    {
-        case _BIG_ENDIAN:
-        value = FieldHelper::swap_endian<int64_t>(value);
-        break;
-        case _LITTLE_ENDIAN:
-        break;
-        default:
-        throw Exception::UnimplementedElement<_ENDIAN>(_UNDEFINED);
-    }
-
-    // Swap the value by 16-bit words if needed
-    if(swap)
+    if(pos < 0 || size < 0 || size > 64)
     {
-        value = (value & 0x0000FFFF) << 16 | (value & 0xFFFF0000) >> 16;
+        ERROR("Error - The field which ID is " + name + " has an invalid position or size (max 64 bits).");
+        throw Exception::IntegrityCheckException<Field>("The field which ID is " + name + " has an invalid position or size (max 64 bits).");
     }
 
-    // vector<uint8_t> l_mesgBytes = FieldHelper::int32ToChar(value);
-    uint32_t          l_msbValue  = FieldHelper::getMSB(value);
-    int                   l_startInd  = static_cast<int>(l_msbValue);
-    int                   l_inv       = -1;
+    layout.offset  = static_cast<uint32_t>(pos) / 8;
+    layout.shift   = static_cast<uint32_t>(pos) % 8;
+    layout.span    = layout.shift + static_cast<uint32_t>(size);
+    layout.bytes   = (layout.span + 7) / 8;
+    layout.mask    = (size == 64) ? ~0ULL : ((1ULL << size) - 1);
+    layout.aligned = p_aligned && layout.shift == 0 && size % 8 == 0;
 
-    //FieldHelper::printBits(l_mesgBytes, "Value of the field " + name + ": ");
-
-    // Requiered size is over the specified value bit size representation
-    if( static_cast<uint32_t>(size) > l_msbValue )
+    // Requiered size differs from the specified value bit size representation
+    if(Logger::isDebugEnabled() && value != -1)
     {
-        if(Logger::isDebugEnabled())
+        uint32_t l_msbValue = FieldHelper::getMSB(value);
+        if( static_cast<uint32_t>(size) > l_msbValue )
         {
-        DEBUG("Field ID " + name + ": The specified size (" + to_string(size)
-             + " bits) is over the value (" + to_string(value)
-             + ") bits representation number ("+  to_string(l_msbValue) + " bits)" + "- the value has been filled "
-                                                                                     "with 0s to fit the specified size" );
+            DEBUG("Field ID " + name + ": The specified size (" + to_string(size)
+                 + " bits) is over the value (" + to_string(value)
+                 + ") bits representation number ("+  to_string(l_msbValue) + " bits)" + "- the value has been filled "
+                                                                                         "with 0s to fit the specified size" );
         }
-
-        l_startInd = size;
-    }
-    // Requiered size is under the specified value bit size representation (troncate)
-    else if (static_cast<uint32_t>(size) < l_msbValue )
-    {
-        if(Logger::isDebugEnabled())
+        else if (static_cast<uint32_t>(size) < l_msbValue )
         {
-        DEBUG("Field ID " + name + ": The specified size (" + to_string(size)
-             + " bits) is below the value ("+ to_string(value)
-             + ") bits representation number ("+  to_string(l_msbValue) + " bits) - the value will be troncated.");
+            DEBUG("Field ID " + name + ": The specified size (" + to_string(size)
+                 + " bits) is below the value ("+ to_string(value)
+                 + ") bits representation number ("+  to_string(l_msbValue) + " bits) - the value will be troncated.");
         }
-        l_startInd = size;
     }
+}
 
-    // Extend the message if necessary
-    uint32_t l_endPos = 1 + static_cast<uint32_t>(pos+size-1)/8;
-    while(p_mesg.size() < l_endPos)
+////////////////////////////////////////////////////////////////////////
+uint64_t Field::toBits(int64_t p_value) const
+{
+    if(endianness != _BIG_ENDIAN && endianness != _LITTLE_ENDIAN)
+    {
+        throw Exception::UnimplementedElement<_ENDIAN>(_UNDEFINED);
+    }
+
+    return FieldHelper::toBits(p_value, endianness == _BIG_ENDIAN, swap, invert,
+                               static_cast<uint32_t>(size), layout.mask);
+}
+
+////////////////////////////////////////////////////////////////////////
+void Field::encode(uint8_t* p_data, size_t p_capacity, uint32_t p_dataSize) const
+{
+    if(size == 0)
     {
-        p_mesg.push_back(0);
+        return;
     }
 
-    // Change bits order if "invert"
-    if(invert)
+    if(layout.offset + layout.bytes > p_capacity)
     {
-        l_startInd = -1;
-        l_inv      = 1;
+        ERROR("Error - The field which ID is " + name + " does not fit in the message.");
+        throw Exception::IntegrityCheckException<Field>("The field which ID is " + name + " does not fit in the message.");
     }
 
-    // Fill the bits with the specified value
-    for(uint32_t i = 0; i < static_cast<uint32_t>(size); i++)
+    FieldHelper::writeBits(layout, static_cast<uint32_t>(size), toBits(getValue(p_dataSize)), p_data, p_capacity);
+}
+
+////////////////////////////////////////////////////////////////////////
+void Field::addToMessage(vector<uint8_t>& p_mesg, uint32_t p_dataSize) const
+{
+    // Extend the message if necessary
+    uint32_t l_endPos = layout.offset + layout.bytes;
+    if(p_mesg.size() < l_endPos)
     {
-        uint8_t l_currBit = (value >> (l_startInd + l_inv*(i + 1)) ) & 1;
-        FieldHelper::addBin(l_currBit,
-                            static_cast<uint32_t>(pos)+i,
-                            p_mesg);
+        p_mesg.resize(l_endPos, 0);
     }
+
+    encode(p_mesg.data(), p_mesg.size(), p_dataSize);
 }
 
 ////////////////////////////////////////////////////////////////////////
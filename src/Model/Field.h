@@ -13,6 +13,22 @@
 
 namespace ModGen {
 
+class ModelArena;
+
+/**
+ * @brief The FieldLayout struct is the bit-packing plan of a \a Field,
+ *        precomputed once when the \a Header is compiled.
+ */
+struct FieldLayout
+{
+    uint32_t offset;  /*!< Index of the first byte touched by the field          */
+    uint32_t shift;   /*!< Position (bits) of the field in its first byte        */
+    uint32_t span;    /*!< Number of bits from the first byte start to field end */
+    uint32_t bytes;   /*!< Number of bytes touched by the field                  */
+    uint64_t mask;    /*!< Mask of the 'size' lowest bits of the value           */
+    bool     aligned; /*!< The field can be copied byte per byte (memcpy)        */
+};
+
 /**
  * @brief The FieldHelper struct contains utility
  *        functions to help transform a \a Field into
@@ -55,8 +71,60 @@ struct FieldHelper
                           const std::string&    p_optTitle = "");
 
     template <typename T> static T swap_endian(T p_value);
+
+    /*!
+     * \brief reverseBits reverses the order of the p_size lowest
+     *        bits of the specified value.
+     * \param p_value the value to reverse.
+     * \param p_size the number of significant bits of the value.
+     * \return the reversed value.
+     */
+    static uint64_t reverseBits(uint64_t p_value, uint32_t p_size);
+
+    /*!
+     * \brief toBigEndian converts a host 64-bits word to its
+     *        big endian (network) memory representation.
+     * \param p_value the value to convert.
+     * \return the converted value.
+     */
+    static uint64_t toBigEndian(uint64_t p_value);
+
+    /*!
+     * \brief toBits applies the endianness, swap and invert
+     *        transformations of a field to a value.
+     * \param p_value the value to transform.
+     * \param p_bigEndian the value is sent big endian.
+     * \param p_swap the 16-bits words of the value are swapped.
+     * \param p_invert the bits are sent LSB first.
+     * \param p_size the size (bits) of the field.
+     * \param p_mask the mask of the 'size' lowest bits (Cf. FieldLayout).
+     * \return the 'size' bits to write, MSB first.
+     */
+    static uint64_t toBits(int64_t  p_value,
+                           bool     p_bigEndian,
+                           bool     p_swap,
+                           bool     p_invert,
+                           uint32_t p_size,
+                           uint64_t p_mask);
+
+    /*!
+     * \brief writeBits writes the bits of a field into the specified
+     *        (zero-initialized where the field lies) header data.
+     * \param p_layout the bit-packing plan of the field.
+     * \param p_size the size (bits) of the field.
+     * \param p_bits the bits to write (Cf. toBits).
+     * \param p_data the header data to be completed.
+     * \param p_capacity the number of bytes available in p_data
+     *        (the field is known to fit in it).
+     */
+    static void writeBits(const FieldLayout& p_layout,
+                          uint32_t           p_size,
+                          uint64_t           p_bits,
+                          uint8_t*           p_data,
+                          std::size_t        p_capacity);
 };
 
+
 /**
  * @brief The Field class manages the data from a configuration
  *        file to create the fields of a header.
@@ -123,17 +191,89 @@ public:
      */
     const std::string& getId() const { return name; }
 
+    /*!
+     * \brief getPos
+     * \return the position (bits) of the field in the header.
+     */
+    int32_t getPos() const { return pos; }
+
+    /*!
+     * \brief getSize
+     * \return the size (bits) of the field.
+     */
+    int32_t getSize() const { return size; }
+
+    /*!
+     * \brief getEndian
+     * \return the endianness of the field.
+     */
+    _ENDIAN getEndian() const { return endianness; }
+
+    /*!
+     * \brief isSwapped
+     * \return true if the 16-bits words of the value are swapped.
+     */
+    bool isSwapped() const { return swap; }
+
+    /*!
+     * \brief isInverted
+     * \return true if the bits of the value are sent LSB first.
+     */
+    bool isInverted() const { return invert; }
+
+    /*!
+     * \brief getLayout
+     * \return the bit-packing plan of the field (Cf. compile).
+     */
+    const FieldLayout& getLayout() const { return layout; }
+
+    /*!
+     * \brief getValue
+     * \param p_dataSize the size (bytes) of the DATA part of the message.
+     * \return the value of the field to be sent, before any
+     *         endianness, swap or invert transformation.
+     */
+    virtual int64_t getValue(uint32_t /*p_dataSize*/) const { return value; }
+
+    /*!
+     * \brief isDynamic
+     * \return true if the value of the field changes from one message
+     *         to another (it cannot be cached in a frame template).
+     */
+    virtual bool isDynamic() const { return false; }
+
+    /*!
+     * \brief compile precomputes the bit-packing plan of the field.
+     *        Must be called before \a encode (Cf. Header::compile).
+     * \param p_aligned allows the byte-aligned (memcpy) fast path,
+     *        which is only valid if no other field overlaps this one.
+     */
+    void compile(bool p_aligned = true);
+
+    /*!
+     * \brief encode writes the current field value into the specified
+     *        (zero-initialized where the field lies) header data.
+     * \param p_data the header data to be completed.
+     * \param p_capacity the number of bytes available in p_data.
+     * \param p_dataSize the size (bytes) of the DATA part of the message.
+     */
+    void encode(uint8_t* p_data, std::size_t p_capacity, uint32_t p_dataSize) const;
+
     /*!
      * \brief addToMessage adds the current field to the specified message data.
      * \param p_mesg the message data to be completed.
+     * \param p_dataSize the size (bytes) of the DATA part of the message.
      */
-    virtual void addToMessage(std::vector<uint8_t>& p_mesg);
-
-    virtual void mesgDataSize(const uint32_t&) {}
+    void addToMessage(std::vector<uint8_t>& p_mesg, uint32_t p_dataSize = 0) const;
 
     virtual void updateHeaderSize(uint32_t& p_headerSize);
 
-    virtual void setHeaderSize(uint32_t&) {}
+    /*!
+     * \brief setHeaderSize gives the size of the compiled header
+     *        to the fields depending on it (Cf. Header::compile).
+     * \param p_headerSize the size (bits) of the header.
+     */
+    virtual void setHeaderSize(uint32_t /*p_headerSize*/) {}
 
 protected:
     std::string name;      /*!< The ID of the field               */
@@ -143,6 +283,15 @@ protected:
     _ENDIAN     endianness;/*!< Endianness of the field           */
     bool        swap;      /*!< Swapping of the data              */
     bool        invert;    /*!< Inversion of the data             */
+    FieldLayout layout;    /*!< Compiled bit-packing plan         */
+
+    /*!
+     * \brief toBits applies the endianness, swap and invert
+     *        transformations to the specified value.
+     * \param p_value the value to transform.
+     * \return the 'size' bits to write, MSB first.
+     */
+    uint64_t toBits(int64_t p_value) const;
 
     static std::map<_ENDIAN, std::string> 
             endianString; /*!< Endianness for std::string outputs */
@@ -161,16 +310,18 @@ private:
         value(p_value), 
         endianness(p_endian),
         swap(p_swap), 
-        invert(p_invert) {}
+        invert(p_invert),
+        layout() {}
 };
 
 /*!
  * \brief The Field_Creator class is a parameterized Factory method
  *        implementation used to create the possible \a Field of a \a Header
+ *        (in the arena of the model, which owns them).
  */
 class Field_Creator {
 public:
-    static Field* Create(const std::string& p_name);
+    static Field* Create(const std::string& p_name, ModelArena& p_arena);
 };
 
 } // namespace ModGen
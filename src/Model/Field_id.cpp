@@ -55,11 +55,4 @@ string Field_id::getDesc() const
            );
 }
 
-////////////////////////////////////////////////////////////////////////
-void Field_id::addToMessage(vector<uint8_t>& p_mesg)
-{
-    // TODO: Voir avec Anthony la méthode de calcul de l'ID numérique
-    Field::addToMessage(p_mesg);
-}
-
 } // namespace ModGen
\ No newline at end of file
@@ -39,8 +39,6 @@ public:
     virtual bool isValid() const;
 
     virtual std::string getDesc() const;
-
-    virtual void addToMessage(std::vector<uint8_t>& p_mesg);
 };
 
 } // namespace ModGen
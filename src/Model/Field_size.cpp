@@ -37,7 +37,8 @@ map<Field_size::FIELD_SIZE_PART, string> Field_size::partString = {
 Field_size::Field_size(const Field_size& p_other):
     Field(p_other),
     format(p_other.format),
-    size_part(p_other.size_part)
+    size_part(p_other.size_part),
+    header_size(p_other.header_size)
 {}
 
 ////////////////////////////////////////////////////////////////////////
@@ -45,7 +46,6 @@ Field_size::Field_size():
     Field(),
     format(SIZE_FORMAT_UNDEF),
     size_part(SIZE_PART_UNDEF),
-    mesg_data_size(0),
     header_size(0)
 {}
 
@@ -61,8 +61,8 @@ Field_size& Field_size::operator = (const Field_size &p_other)
     invert          = p_other.invert;
     format          = p_other.format;
     size_part       = p_other.size_part;
-    mesg_data_size  = p_other.mesg_data_size;
     header_size     = p_other.header_size;
+    layout          = p_other.layout;
 
   return *this;
 }
@@ -201,9 +201,9 @@ string Field_size::getDesc() const
 }
 
 ////////////////////////////////////////////////////////////////////////
-void Field_size::addToMessage(vector<uint8_t>& p_mesg)
+int64_t Field_size::getValue(uint32_t p_dataSize) const
 {
-    uint32_t l_mesgSize = 8 * mesg_data_size;
+    uint32_t l_mesgSize = 8 * p_dataSize;
 
     switch(size_part)
     {
@@ -223,30 +223,18 @@ void Field_size::addToMessage(vector<uint8_t>& p_mesg)
     switch(format)
     {
         case SIZE_FORMAT_U8:
-            value = static_cast<int32_t>(ceil(l_mesgSize/8.f));
-            // DEBUG("*****value = " + std::to_string(value));
-            break;
+            return static_cast<int32_t>(ceil(l_mesgSize/8.f));
         case SIZE_FORMAT_U16:
-            value =  static_cast<int32_t>(ceil(l_mesgSize/16.f));
-            break;
+            return static_cast<int32_t>(ceil(l_mesgSize/16.f));
         case SIZE_FORMAT_U32:
-            value =  static_cast<int32_t>(ceil(l_mesgSize/32.f));
-            break;
+            return static_cast<int32_t>(ceil(l_mesgSize/32.f));
         default:
             throw Exception::UnimplementedElement<FIELD_FORMAT>(SIZE_FORMAT_UNDEF);
     }
-
-    Field::addToMessage(p_mesg);
-}
-
-////////////////////////////////////////////////////////////////////////
-void Field_size::mesgDataSize(const uint32_t& p_sizeValue)
-{
-    mesg_data_size = p_sizeValue;
 }
 
 ////////////////////////////////////////////////////////////////////////
-void Field_size::setHeaderSize(uint32_t& p_headerSize)
+void Field_size::setHeaderSize(uint32_t p_headerSize)
 {
     header_size = p_headerSize;
 }
@@ -85,16 +85,13 @@ public:
      */
     virtual std::string getDesc() const;
 
-    virtual void addToMessage(std::vector<uint8_t>& p_mesg);
+    virtual int64_t getValue(uint32_t p_dataSize) const;
 
-    virtual void mesgDataSize(const uint32_t& p_sizeValue);
-
-    virtual void setHeaderSize(uint32_t& p_headerSize);
+    virtual void setHeaderSize(uint32_t p_headerSize);
 
 private:
     FIELD_FORMAT    format;         /*!< Unit used to evaluate the size value (8, 16 or 32 bits).  */
     FIELD_SIZE_PART size_part;      /*!< Part of the message used to compute the size              */
-    uint32_t        mesg_data_size; /*!< Size of the DATA (in bytes) in the message.               */
     uint32_t        header_size;    /*!< Size of the HEADER (in BITS) in the message.              */
 
     static std::map<FIELD_FORMAT, std::string>    
@@ -54,6 +54,7 @@ Field_time& Field_time::operator = (const Field_time &p_other)
     swap       = p_other.swap;
     invert     = p_other.invert;
     format     = p_other.format;
+    layout     = p_other.layout;
 
   return *this;
 }
@@ -169,24 +170,25 @@ void Field_time::setParam(const string& p_name, const string& p_value)
 }
 
 ////////////////////////////////////////////////////////////////////////
-void Field_time::addToMessage(vector<uint8_t>& p_mesg)
+int64_t Field_time::getValue(uint32_t) const
 {
-    switch(format)
+    return getTime(format);
+}
+
+////////////////////////////////////////////////////////////////////////
+int64_t Field_time::getTime(TIME_FORMAT p_format)
+{
+    switch(p_format)
     {
         case MILLISECONDS:
-            value = static_cast<int64_t>(TimeUtil::day_milliseconds());
-            break;
+            return static_cast<int64_t>(TimeUtil::day_milliseconds());
         case MICROSECONDS:
-            value = static_cast<int64_t>(TimeUtil::day_microseconds());
-            break;
+            return static_cast<int64_t>(TimeUtil::day_microseconds());
         case HHR_DIANE:
-            value = static_cast<int64_t>(TimeUtil::hhr_diane());
-            break;
+            return static_cast<int64_t>(TimeUtil::hhr_diane());
         default:
             throw Exception::UnimplementedElement<TIME_FORMAT>(_UNDEFINED);
     }
-
-    Field::addToMessage(p_mesg);
 }
 
 } // namespace ModGen
\ No newline at end of file
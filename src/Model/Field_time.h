@@ -55,7 +55,22 @@ public:
     void setParam(const std::string& p_name, 
                   const std::string& p_value);
 
-    virtual void addToMessage(std::vector<uint8_t>& p_mesg);
+    virtual int64_t getValue(uint32_t p_dataSize) const;
+
+    virtual bool isDynamic() const { return true; }
+
+    /*!
+     * \brief getFormat
+     * \return the format of the timestamp.
+     */
+    TIME_FORMAT getFormat() const { return format; }
+
+    /*!
+     * \brief getTime
+     * \param p_format the format of the timestamp.
+     * \return the current time in the specified format.
+     */
+    static int64_t getTime(TIME_FORMAT p_format);
 
 private:
     TIME_FORMAT format;
@@ -5,8 +5,10 @@
  * @date   17/07/2019
  */
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <cstring>
 #include <limits.h>
 
 #include "Logger.h"
@@ -23,7 +25,11 @@ using namespace std;
 ////////////////////////////////////////////////////////////////////////
 Header::Header() :
     name(),
-    fields(map<string, Field*>())
+    fields(map<string, Field*>()),
+    layout(),
+    static_layout(),
+    dynamic_layout(),
+    header_bits(0)
 {}
 
 ////////////////////////////////////////////////////////////////////////
@@ -74,8 +80,10 @@ string Header::getDesc() const
 }
 
 ////////////////////////////////////////////////////////////////////////
-void Header::addToMessage(vector<uint8_t>& p_mesg) const
+void Header::compile()
 {
+    layout.clear();
+    header_bits = 0;
     for(auto& l_fieldpair: fields)
     {
         if(!l_fieldpair.second)
@@ -83,36 +91,81 @@ void Header::addToMessage(vector<uint8_t>& p_mesg) const
             ERROR("The header which ID is " + name + " references a null Field.");
             throw Exception::IntegrityCheckException<Field>("The header which ID is " + name + " references a null Field." );
         }
-        l_fieldpair.second->addToMessage(p_mesg);
+        layout.push_back(l_fieldpair.second);
+        l_fieldpair.second->updateHeaderSize(header_bits);
     }
-}
 
-////////////////////////////////////////////////////////////////////////
-void Header::mesgSizeParams(const uint32_t& p_sizeValue)
-{
-    uint32_t l_headerSize = 0;
-    for(auto& l_fieldpair: fields)
+    // The size of the header is known: the size fields including it are static per message
+    for(auto& l_field: layout)
     {
-        if(!l_fieldpair.second)
+        l_field->setHeaderSize(header_bits);
+    }
+
+    stable_sort(layout.begin(), layout.end(),
+                [](const Field* p_1, const Field* p_2) { return p_1->getPos() < p_2->getPos(); });
+
+    // The byte-aligned fast path overwrites whole bytes:
+    // it is only allowed if no field overlaps another one.
+    bool l_overlap = false;
+    for(size_t i = 1; i < layout.size(); i++)
+    {
+        if(layout[i-1]->getPos() + layout[i-1]->getSize() > layout[i]->getPos())
         {
-            ERROR("The header which ID is " + name + " references a null Field.");
-            throw Exception::IntegrityCheckException<Field>("The header which ID is " + name + " references a null Field." );
+            l_overlap = true;
         }
-        l_fieldpair.second->mesgDataSize(p_sizeValue);
-        l_fieldpair.second->updateHeaderSize(l_headerSize);
     }
 
-    for(auto& l_fieldpair: fields)
+    static_layout.clear();
+    dynamic_layout.clear();
+    for(auto& l_field: layout)
     {
-        if(!l_fieldpair.second)
+        l_field->compile(!l_overlap);
+        if(l_field->isDynamic())
         {
-            ERROR("The header which ID is " + name + " references a null Field.");
-            throw Exception::IntegrityCheckException<Field>("The header which ID is " + name + " references a null Field." );
+            dynamic_layout.push_back(l_field);
         }
-        l_fieldpair.second->setHeaderSize(l_headerSize);
+        else
+        {
+            static_layout.push_back(l_field);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void Header::encode(uint8_t* p_data, size_t p_capacity, uint32_t p_dataSize) const
+{
+    for(auto& l_field: layout)
+    {
+        l_field->encode(p_data, p_capacity, p_dataSize);
     }
+}
 
-    //ERROR("HEADER SIZE = " + std::to_string(l_headerSize));
+////////////////////////////////////////////////////////////////////////
+void Header::encodeStatic(uint8_t* p_data, size_t p_capacity, uint32_t p_dataSize) const
+{
+    for(auto& l_field: static_layout)
+    {
+        l_field->encode(p_data, p_capacity, p_dataSize);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void Header::encodeDynamic(uint8_t* p_data, size_t p_capacity, uint32_t p_dataSize) const
+{
+    for(auto& l_field: dynamic_layout)
+    {
+        l_field->encode(p_data, p_capacity, p_dataSize);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void Header::addToMessage(vector<uint8_t>& p_mesg) const
+{
+    if(p_mesg.size() < getSize())
+    {
+        p_mesg.resize(getSize(), 0);
+    }
+    encode(p_mesg.data(), p_mesg.size(), static_cast<uint32_t>(p_mesg.size() - getSize()));
 }
 
 } // namespace ModGen
\ No newline at end of file
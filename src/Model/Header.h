@@ -60,17 +60,72 @@ public:
      */
     const std::string& getId() const { return name; }
 
+    /*!
+     * \brief compile builds the layout of the header: its fields sorted
+     *        by position with their bit-packing plan precomputed.
+     *        Called once by the model integrity check.
+     */
+    void compile();
+
+    /*!
+     * \brief getSize
+     * \return the size (bytes) of the compiled header.
+     */
+    uint32_t getSize() const { return (header_bits + 7) / 8; }
+
+    /*!
+     * \brief encode writes the header fields into the specified data,
+     *        whose first \a getSize() bytes must be zero-initialized.
+     * \param p_data the message data to complete.
+     * \param p_capacity the number of bytes available in p_data.
+     * \param p_dataSize the size (bytes) of the DATA part of the message.
+     */
+    void encode(uint8_t* p_data, std::size_t p_capacity, uint32_t p_dataSize) const;
+
+    /*!
+     * \brief encodeStatic writes the fields whose value never changes
+     *        (Cf. Field::isDynamic) - used to build frame templates.
+     * \param p_data the message data to complete.
+     * \param p_capacity the number of bytes available in p_data.
+     * \param p_dataSize the size (bytes) of the DATA part of the message.
+     */
+    void encodeStatic(uint8_t* p_data, std::size_t p_capacity, uint32_t p_dataSize) const;
+
+    /*!
+     * \brief encodeDynamic writes the fields whose value changes from
+     *        one message to another into a copy of a frame template.
+     * \param p_data the message data to patch.
+     * \param p_capacity the number of bytes available in p_data.
+     * \param p_dataSize the size (bytes) of the DATA part of the message.
+     */
+    void encodeDynamic(uint8_t* p_data, std::size_t p_capacity, uint32_t p_dataSize) const;
+
+    /*!
+     * \brief getDynamicFields
+     * \return the dynamic fields of the layout (Cf. Field::isDynamic).
+     */
+    const std::vector<Field*>& getDynamicFields() const { return dynamic_layout; }
+
+    /*!
+     * \brief hasDynamicFields
+     * \return true if at least one field of the header is dynamic.
+     */
+    bool hasDynamicFields() const { return !dynamic_layout.empty(); }
+
     /*!
      * \brief addToMessage Adds the Header data to the specified message
+     *        (the bytes following the header are its DATA part).
      * \param p_mesg the message to complete
      */
     void addToMessage(std::vector<uint8_t>& p_mesg) const;
 
-    void mesgSizeParams(const uint32_t& p_sizeValue);
-
 private:
-    std::string                   name;    /*!< The ID of the Header     */
-    std::map<std::string, Field*> fields;  /*!< The fields of the Header */
+    std::string                   name;           /*!< The ID of the Header                     */
+    std::map<std::string, Field*> fields;         /*!< The fields of the Header                 */
+    std::vector<Field*>           layout;         /*!< The fields sorted by position (compiled) */
+    std::vector<Field*>           static_layout;  /*!< The static fields of the layout          */
+    std::vector<Field*>           dynamic_layout; /*!< The dynamic fields of the layout         */
+    uint32_t                      header_bits;    /*!< Size (bits) of the header (compiled)     */
 };
 
 } // namespace ModGen
@@ -5,8 +5,7 @@
  * @date   17/07/2019
  */
 
-#include <stdlib.h>
-#include <time.h>
+#include <string.h>
 
 #include "Logger.h"
 #include "Message.h"
@@ -36,10 +35,11 @@ Message::Message() :
     dst_ip(),
     interface(),
     fill(MESG_FILL_UNSET),
-    mesgToSend(vector<uint8_t>())
-{
-    srand (static_cast<unsigned int>(time(nullptr)));
-}
+    seed(RandomGenerator::randomSeed()),
+    frame_template(),
+    header_size(0),
+    static_frame(false)
+{}
 
 ////////////////////////////////////////////////////////////////////////
 Message::~Message()
@@ -109,6 +109,10 @@ void Message::setParam(const string& p_name, const string& p_value)
     {
         interface = p_value;
     }
+    else if(p_name.compare(Messages_format::seed) == 0)
+    {
+        seed = stoull(p_value, nullptr, 0);
+    }
     else
     {
         throw Exception::ParsingFileParamError<Message>(p_name);
@@ -132,33 +136,104 @@ string Message::getDesc() const
 }
 
 ////////////////////////////////////////////////////////////////////////
-vector<uint8_t>& Message::createMessage()
+void Message::compile()
+{
+    // The size fields depend on the message: they are static per message
+    frame_template.clear();
+    uint32_t l_size = getEncodedSize();
+
+    frame_template.assign(l_size, 0);
+    header_ptr->encodeStatic(frame_template.data(), l_size, data_size);
+
+    header_size  = l_size - data_size;
+    static_frame = !header_ptr->hasDynamicFields() && fill == MESG_FILL_ZERO;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t Message::getEncodedSize() const
 {
-    mesgToSend.clear();
+    if(!frame_template.empty())
+    {
+        return static_cast<uint32_t>(frame_template.size());
+    }
+
     if(!header_ptr)
     {
         ERROR("Error - The message which ID is " + name + " references a null Header.");
         throw Exception::IntegrityCheckException<Header>("The message which ID is " + name + " references a null Header." );
     }
-    header_ptr->mesgSizeParams(data_size);
-    header_ptr->addToMessage(mesgToSend);
 
+    return header_ptr->getSize() + data_size;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t Message::encode(uint8_t* p_buffer, size_t p_capacity, RandomGenerator& p_random) const
+{
+    if(frame_template.empty())
+    {
+        ERROR("Error - The message which ID is " + name + " is not compiled.");
+        throw Exception::IntegrityCheckException<Message>("The message which ID is " + name + " is not compiled.");
+    }
+
+    uint32_t l_size = static_cast<uint32_t>(frame_template.size());
+    if(p_capacity < l_size)
+    {
+        ERROR("Error - The buffer is too small to encode the message which ID is " + name + ".");
+        throw Exception::BufferOverflow(l_size, p_capacity);
+    }
+
+    if(fill == MESG_FILL_RANDOM)
+    {
+        memcpy(p_buffer, frame_template.data(), header_size);
+        p_random.fill(p_buffer + header_size, data_size);
+    }
+    else
+    {
+        memcpy(p_buffer, frame_template.data(), l_size);
+    }
+
+    // The dynamic fields bits are zeroed in the template
+    header_ptr->encodeDynamic(p_buffer, l_size, data_size);
+
+    return l_size;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t Message::encodeFull(uint8_t* p_buffer, size_t p_capacity, RandomGenerator& p_random) const
+{
+    if(!header_ptr)
+    {
+        ERROR("Error - The message which ID is " + name + " references a null Header.");
+        throw Exception::IntegrityCheckException<Header>("The message which ID is " + name + " references a null Header." );
+    }
+
+    uint32_t l_size       = header_ptr->getSize() + data_size;
+    uint32_t l_headerSize = l_size - data_size;
+    if(p_capacity < l_size)
+    {
+        ERROR("Error - The buffer is too small to encode the message which ID is " + name + ".");
+        throw Exception::BufferOverflow(l_size, p_capacity);
+    }
+
+    memset(p_buffer, 0, l_headerSize);
+
+    uint8_t* l_data = p_buffer + l_headerSize;
     switch(fill)
     {
         case MESG_FILL_ZERO:
-            for(uint32_t i = 0; i < data_size; i++) { mesgToSend.push_back(0);                                        }
+            memset(l_data, 0, data_size);
             break;
         case MESG_FILL_RANDOM:
-            for(uint32_t i = 0; i < data_size; i++) { mesgToSend.push_back(static_cast<uint8_t>(rand() % 255)); }
+            p_random.fill(l_data, data_size);
             break;
         default:
-            ERROR("Error - createMessage Could not parse the filling method.");
+            ERROR("Error - encodeFull Could not parse the filling method.");
             throw Exception::UnimplementedElement<FILL_METHOD>(fill);
     }
 
-    //FieldHelper::printBits(mesgToSend, "Message " + name + ": ");
+    header_ptr->encode(p_buffer, l_size, data_size);
 
-    return mesgToSend;
+    return l_size;
 }
 
-} // namespace ModGen
\ No newline at end of file
+} // namespace ModGen
@@ -11,6 +11,8 @@
 
 #include <includes.h>
 
+#include "random_util.h"
+
 namespace ModGen {
 
 class Header;
@@ -80,17 +82,73 @@ public:
     const std::string& getHeaderName() const { return header; }
 
     /*!
-     * \brief createMessage
-     * \return the corresponding data to be sent.
+     * \brief compile pre-encodes the static part of the message (header
+     *        fields that never change and zero-filled DATA) into a frame
+     *        template. Must be called once the header is set and compiled.
+     */
+    void compile();
+
+    /*!
+     * \brief isStatic
+     * \return true if the compiled message never changes from one
+     *         emission to another (no dynamic field, DATA filled with zeros).
+     */
+    bool isStatic() const { return static_frame; }
+
+    /*!
+     * \brief getEncodedSize
+     * \return the exact size (bytes) of the message once encoded.
+     */
+     uint32_t getEncodedSize() const;
+
+    /*!
+     * \brief encode writes the compiled message into a caller-owned buffer
+     *        with the generator of the caller (Cf. MESG_FILL_RANDOM): the
+     *        message is not changed, and can be encoded by several threads.
+     *        Nothing is allocated: the buffer can be reused for every message.
+     * \param p_buffer the buffer to write the message to.
+     * \param p_capacity the size (bytes) of the buffer.
+     * \param p_random the generator of the DATA part.
+     * \return the number of bytes written (Cf. getEncodedSize).
+     * \throw Exception::BufferOverflow if the buffer is too small.
      */
-     std::vector<uint8_t> &createMessage();
+     uint32_t encode(uint8_t* p_buffer, std::size_t p_capacity, RandomGenerator& p_random) const;
+
+    /*!
+     * \brief encodeFull writes the message into a caller-owned buffer
+     *        encoding every field of the header (the frame template is not used).
+     * \param p_buffer the buffer to write the message to.
+     * \param p_capacity the size (bytes) of the buffer.
+     * \param p_random the generator of the DATA part.
+     * \return the number of bytes written (Cf. getEncodedSize).
+     * \throw Exception::BufferOverflow if the buffer is too small.
+     */
+     uint32_t encodeFull(uint8_t* p_buffer, std::size_t p_capacity, RandomGenerator& p_random) const;
 
      // getters
-     const std::string&  getSrcIP(void)   { return src_ip;   }
-     const std::string&  getDstIP(void)   { return dst_ip;   }
-     const std::string&  getIntface(void) { return interface;}
-     const uint32_t&     getSrcPort(void) { return src_port; }
-     const uint32_t&     getDstPort(void) { return dst_port; }
+     const std::string&  getSrcIP(void)      const { return src_ip;      }
+     const std::string&  getDstIP(void)      const { return dst_ip;      }
+     const std::string&  getIntface(void)    const { return interface;   }
+     const uint32_t&     getSrcPort(void)    const { return src_port;    }
+     const uint32_t&     getDstPort(void)    const { return dst_port;    }
+     FILL_METHOD         getFill(void)       const { return fill;        }
+     uint32_t            getDataSize(void)   const { return data_size;   }
+     uint32_t            getHeaderSize(void) const { return header_size; }
+     const Header*       getHeader(void)     const { return header_ptr;  }
+
+    /*!
+     * \brief getFrameTemplate
+     * \return the pre-encoded static part of the message (Cf. compile).
+     */
+     const std::vector<uint8_t>& getFrameTemplate() const { return frame_template; }
+
+    /*!
+     * \brief getSeed
+     * \return the seed of the generator of the DATA part - given by the "seed"
+     *         attribute, drawn once for the message otherwise: the instances
+     *         of the model seed their generators with it (Cf. ModelDefinition).
+     */
+     uint64_t getSeed() const { return seed; }
 
 private:
     std::string     name;       /*!< Identification of the message (two messages cannot have the same name)           */
@@ -105,9 +163,12 @@ private:
     std::string     interface;  /*!< Network interface to use to send the message                                     */
 
     FILL_METHOD     fill;       /*!< Method used to fill the DATA part of the message                                 */
+    uint64_t        seed;       /*!< Seed of the generator of the DATA part (MESG_FILL_RANDOM, Cf. getSeed)           */
 
     std::vector<uint8_t>
-                    mesgToSend; /*!< Byte arrauy of data representing the message to send (or not to send)            */
+                    frame_template; /*!< Pre-encoded static part of the message (Cf. compile)                         */
+    uint32_t        header_size;    /*!< Size (bytes) of the header part of the frame template                        */
+    bool            static_frame;   /*!< The frame template is sent as is (Cf. isStatic)                              */
 
     static std::map<FILL_METHOD, std::string>
                     fillString; /*!< Fill methods for string outputs                                                  */
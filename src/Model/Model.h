@@ -11,6 +11,8 @@
 
 #include <includes.h>
 
+#include "ModelInstance.h"
+
 /*!
  * \namespace ModGen is the base namespace
  *            of the <b>ModelGenerator</b> library.
@@ -34,7 +36,7 @@ class Message;
  *  \n
  *
  * \section Organisation Sources organisation
- * This software is implemented in seven folders - each linked to a particular aspect: \n
+ * This software is implemented in eight folders - each linked to a particular aspect: \n
  * <ul>
  * <li>\a <b>Conf</b>: Contains the XML balises names and attributes required to parse the configuration file.
  * <li>\a <b>dependencies</b>: Contains the dependencies of the library such as the library <b>pugixml</b>
@@ -42,6 +44,7 @@ class Message;
  * <li>\a <b>Exceptions</b>: Contains the implementation of the exception classes used by the library.
  * <li>\a <b>Logger</b>: Contains the implementations of the <em>Logger</em> class used to log informations and debugging messages.
  * <li>\a <b>Model</b>: Contains the classes and structures used to represent the finite-state automaton created by the library.
+ * <li>\a <b>Sender</b>: Contains the classes used to pack the messages of the automaton into frames to be sent.
  * <li>\a <b>include</b>: Contains the interface of the library - this directory should be include by any executable software
  *        willing to use the library.
  * <li>\a <b>Version</b>: Contains the version number of the library, which is updated on build by a <em>Python3 script</em>
@@ -50,7 +53,7 @@ class Message;
  *
  * \section How to use the library
  * This library should be linked against your project and the directory <em>[include]</em> included by the application.
- * The library functions are declared in five subnamespaces of the namespace <b>ModelGeneratorAPI</b>:
+ * The library functions are declared in six subnamespaces of the namespace <b>ModelGeneratorAPI</b>:
  * <ul>
  * <li>\a <b>VERSION</b>: Contains the functions to retrieve the library versions informations.
  * <li>\a <b>EXCEP</b>: Contains the functions relative to Exceptions handling.
@@ -58,6 +61,10 @@ class Message;
  * <li>\a <b>LOGS</b>: Contains the functions necessary to interract with the logs module.
  * <li>\a <b>MODEL</b>: Contains the functions that allow to setup and operate the Model representing
  *                      the finite-state automaton parsed from an XML configuration file.
+ *                      Several independent instances of the Model can be created in the same process
+ *                      (Cf. \a ModelInstance), each one being operated through its handle.
+ * <li>\a <b>SENDER</b>: Contains the functions that pack the messages of the Model into frames
+ *                       according to the sending method.
  * </ul>
  */
 
@@ -87,204 +94,111 @@ struct parsingHelper
  * @brief The Model class manages the data from a configuration
  *        file to create and run the corresponding finite state
  *        machine.
+ *        It is the default \a ModelInstance of the process (Cf. ModelInstance.h)
+ *        and only forwards its calls to it.
  */
 class Model
 {
 
 public:
-    /**
-     * Enumerate describing the possible states of the model.
-     */
-    typedef enum {
-        NOT_INITIALIZED   = 0, /*!< Not initialized                 */
-        INITIALIZED       = 1, /*!< Initialized but not running     */
-        RUNNING           = 2, /*!< Running                         */
-        STOPPED           = 3  /*!< Stopped                         */
-    } MODELSTATE;
-
-    /*!
-     * \brief ModelVar all the variables
-     *        (and their value) used by the model
-     */
-    typedef std::map<std::string, int>     ModelVar;
-
-    /*!
-     * \brief ModelMesg is a map linking
-     *        every message ID to the corresponding message.
-     */
-    typedef std::map<std::string, Message> ModelMesg;
-
-    /*!
-     * \brief ModelHead is a map linking
-     *       every header ID to the corresponding header.
-     */
-    typedef std::map<std::string, Header>  ModelHead;
-
-    /*!
-     * \brief ModelState is a map linking
-     *       every State ID to the corresponding State.
-     */
-    typedef std::map<std::string, State>   ModelState;
-
     /*!
      * \brief getState
      * \return the current state of the model.
      */
-    static const std::string& getStateString();
+    static const std::string& getStateString() { return getInstance().getStateString(); }
 
     /*!
      * \brief getVariables
-     * \return the model variables and their values.
+     * \return the values of the model variables (by ID).
      */
-    static const std::map<std::string, int>&     getVariables();
+    static ModelInstance::ModelVar&         getVariables() { return getInstance().getVariables(); }
 
     /*!
      * \brief getMessages
-     * \return the model messages.
+     * \return the model messages (by ID).
      */
-    static const std::map<std::string, Message>& getMessages();
+    static const ModelInstance::ModelMesg&  getMessages() { return getInstance().getMessages(); }
 
     /*!
      * \brief getHeaders
-     * \return the model headers.
+     * \return the model headers (by ID).
      */
-    static const std::map<std::string, Header>&  getHeaders();
+    static const ModelInstance::ModelHead&  getHeaders() { return getInstance().getHeaders(); }
 
     /*!
      * \brief getStates
-     * \return the model states.
+     * \return the model states (by ID).
      */
-    static const std::map<std::string, State>&   getStates();
+    static const ModelInstance::ModelState& getStates() { return getInstance().getStates(); }
+
+    /*!
+     * \brief getSymbols
+     * \return the IDs of the names of the model.
+     */
+    static const ModelInstance::ModelSymbols& getSymbols() { return getInstance().getSymbols(); }
 
 
     /**
      * @brief log Writes the complete model to the logs
      *        using the \a Logger (Cf. Logger.h)
      */
-    static void log();
+    static void log() { getInstance().log(); }
 
     /**
      * @brief setup sets the values of the model if existing
      * @param p_filePath the path of the configuration file
      */
-    static void setup(const std::string& p_filePath);
-
-    /**
-     * @brief nextState makes the Model go into its next State.
-     */
-    static void nextState(void) { getInstance().curState = getInstance().nexState; }
-
-    /**
-     * \brief getNextState returns the next state of the model
-     */
-    static State* getNextState();
+    static void setup(const std::string& p_filePath) { getInstance().setup(p_filePath); }
 
     /**
-     * \brief getNextState returns the current state of the model
-     */
-    static State* getCurrState();
-
-    static void setNextState(State* p_state) { getInstance().nexState = p_state; }
-
-    static void setCurrState(State* p_state) { getInstance().curState = p_state; }
-
-private:
-    /**
-     * Enumerate of the possible operations to perform
-     * on the model variables.
-     */
-    typedef enum {
-        ADD,    /*!< Addition       */
-        SUB,    /*!< Substraction   */
-        DEL     /*!< Suppresion     */
-    } OPERATION;
-
-    /**
-     * @brief Model Default constructor
-     * NB : Private because of singleton
-     */
-    Model();
-
-    /**
-     * @brief ~Model Default destructor
+     * @brief setCache sets the binary image of the model (Cf. ModelCache)
+     * @param p_cachePath the path of the image (empty to disable the cache)
      */
-    ~Model();
+    static void setCache(const std::string& p_cachePath) { getInstance().setCache(p_cachePath); }
 
     /**
-     * @brief getInstance returns the singleton instance of the model
-     * @return the unique instance of the model
+     * @brief nextState makes the Model go into its next State.
      */
-    static Model& getInstance();
+    static void nextState(void) { getInstance().nextState(); }
 
     /**
-     * @brief addVariable Add the desired variable with the specified value
-     *        to the model variables.
-     * @param p_name The name of the variable to be added.
-     * @param p_val The value to give to the variable.
+     * \brief getNextState returns the next state of the model
      */
-    static void addVariable(const std::string& p_name, int p_val);
+    static State* getNextState() { return getInstance().getNextState(); }
 
     /**
-     * @brief operateVariable Modify the specified variable.
-     * @param p_name The name of the variable to modify.
-     * @param p_operation The operation to perform.
-     * @param p_value The value of the second operande.
+     * \brief getNextState returns the current state of the model
      */
-    static void operateVariable(const std::string&  p_name,
-                                const OPERATION&    p_operation,
-                                int                 p_value);
+    static State* getCurrState() { return getInstance().getCurrState(); }
 
-    /**
-     * @brief initializeVariables Initializes the model variables
-     * @param p_doc XML configuration document loaded by the pugixml lib
-     */
-    static void initializeVariables(const pugi::xml_document& p_doc);
+    static void setNextState(State* p_state) { getInstance().setNextState(p_state); }
 
-    /**
-     * @brief initializeMessages Initializes the model messages
-     * @param p_doc XML configuration document loaded by the pugixml lib
-     */
-    static void initializeMessages(const pugi::xml_document& p_doc);
+    static void setCurrState(State* p_state) { getInstance().setCurrState(p_state); }
 
     /**
-     * @brief initializeHeaders Initializes the model headers
-     * @param p_doc XML configuration document loaded by the pugixml lib
+     * \brief getScheduler
+     * \return the scheduler waiting for the delays of the transitions.
      */
-    static void initializeHeaders(const pugi::xml_document& p_doc);
+    static Scheduler& getScheduler() { return getInstance().getScheduler(); }
 
     /**
-     * @brief initializeStates Initializes the model states
-     * @param p_doc XML configuration document loaded by the pugixml lib
+     * \brief getCompiled
+     * \return the model lowered to dense arrays (Cf. CompiledModel).
      */
-    static void initializeStates(const pugi::xml_document& p_doc);
+    static CompiledModel& getCompiled() { return getInstance().getCompiled(); }
 
     /**
-     * @brief checkIntegrity Performs model integrity verifications
-     *        after the configuration document has been parsed.
-     *        This function is needed because some parameters cannot be
-     *        checked at construction (especially when referencing structures
-     *        that were not parsed at that time).
+     * @brief getInstance returns the default instance of the model
+     * @return the default instance of the model
      */
-    static void checkIntegrity();
+    static ModelInstance& getInstance();
 
+private:
     /**
-     * \brief clear clears the data of the model
+     * @brief Model Default constructor
+     * NB : Private because only static
      */
-    static void clear();
-
-private:
-    std::string* confFile;        /*!< The file used for the configurations.   */
-    State *      curState;        /*!< Current state of the model.             */
-    State *      nexState;        /*!< Next state of the model.                */
-    MODELSTATE   currentStateStr; /*!< Current state string of the model.      */
-
-    ModelVar     modelVar;        /*!< Variables used by the model.            */
-    ModelMesg    modelMes;        /*!< Messages defined in the model.          */
-    ModelHead    modelHead;       /*!< Headers defined in the model.           */
-    ModelState   modelState;      /*!< States defined in the model.            */
-
-    static std::map<MODELSTATE, std::string>
-                 stateString;     /*!< States of the model for string outputs  */
+    Model() = delete;
 };
 
 } // namespace ModGen
@@ -0,0 +1,43 @@
+/*!
+ * @file   ModelArena.cpp
+ * @brief  Implementations of the functions defined in \a ModelArena.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include "ModelArena.h"
+
+namespace ModGen {
+
+using namespace std;
+
+static const size_t FIRST_BLOCK_SIZE = 16 * 1024; /*!< Size (bytes) of the first block (the next ones grow) */
+
+////////////////////////////////////////////////////////////////////////
+ModelArena::ModelArena() :
+    buffer(FIRST_BLOCK_SIZE),
+    destructors(nullptr),
+    objects(0)
+{}
+
+////////////////////////////////////////////////////////////////////////
+ModelArena::~ModelArena()
+{
+    release();
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelArena::release()
+{
+    // Most recent node first (a node may reference the previous ones)
+    for(Destructor* l_entry = destructors; l_entry; l_entry = l_entry->next)
+    {
+        l_entry->destroy(l_entry->node);
+    }
+
+    destructors = nullptr;
+    objects     = 0;
+    buffer.release();
+}
+
+} // namespace ModGen
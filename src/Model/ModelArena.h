@@ -0,0 +1,100 @@
+/*!
+ * @file   ModelArena.h
+ * @brief  Contains the arena owning the nodes of a model
+ *         (fields, transitions).
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef MODELARENA_MODELGENERATOR
+#define MODELARENA_MODELGENERATOR
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ModGen {
+
+/*!
+ * \brief The ModelArena class owns the nodes of a model: they are created
+ *        one after the other in large blocks (monotonic buffer) and are
+ *        never freed one by one.
+ *        Every node is destroyed (in the reverse order of creation) and
+ *        every block is freed in one shot by \a release, when the elements of
+ *        the model are freed (Cf. ModelInstance::ModelElements).
+ *        The headers and the states only reference the nodes.
+ */
+class ModelArena
+{
+public:
+    /*!
+     * \brief ModelArena constructor (no block allocated yet)
+     */
+    ModelArena();
+
+    /*!
+     * \brief ~ModelArena destructor (Cf. release)
+     */
+    ~ModelArena();
+
+    ModelArena(const ModelArena&)            = delete;
+    ModelArena& operator=(const ModelArena&) = delete;
+
+    /*!
+     * \brief create builds a node in the arena.
+     * \param p_args the parameters of the constructor of the node.
+     * \return the node (owned by the arena until \a release).
+     */
+    template<typename T, typename... Args>
+    T* create(Args&&... p_args)
+    {
+        void* l_place = buffer.allocate(sizeof(T), alignof(T));
+        T*    l_node  = new (l_place) T(std::forward<Args>(p_args)...);
+
+        if(!std::is_trivially_destructible<T>::value)
+        {
+            void* l_entry = buffer.allocate(sizeof(Destructor), alignof(Destructor));
+            destructors   = new (l_entry) Destructor{&destroy<T>, l_node, destructors};
+        }
+        objects++;
+        return l_node;
+    }
+
+    /*!
+     * \brief release destroys every node and frees every block.
+     *        NB : The nodes must not be referenced anymore.
+     */
+    void release();
+
+    /*!
+     * \brief getObjectsCount
+     * \return the number of nodes in the arena.
+     */
+    std::size_t getObjectsCount() const { return objects; }
+
+private:
+    /*!
+     * \brief The Destructor struct destroys a node on release
+     *        (created in the arena after the node).
+     */
+    struct Destructor
+    {
+        void      (*destroy)(void*); /*!< Destroys the node            */
+        void*       node;            /*!< The node                     */
+        Destructor* next;            /*!< Previously created node      */
+    };
+
+    template<typename T>
+    static void destroy(void* p_node) { static_cast<T*>(p_node)->~T(); }
+
+private:
+    std::pmr::monotonic_buffer_resource buffer;      /*!< The blocks of the nodes            */
+    Destructor*                         destructors; /*!< Last created node to be destroyed  */
+    std::size_t                         objects;     /*!< Number of nodes                    */
+};
+
+} // namespace ModGen
+
+#endif // MODELARENA_MODELGENERATOR
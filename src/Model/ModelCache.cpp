@@ -0,0 +1,372 @@
+/*!
+ * @file   ModelCache.cpp
+ * @brief  Implementations of the functions defined in \a ModelCache.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ModelCache.h"
+#include "Exception.h"
+#include "Logger.h"
+
+namespace ModGen {
+
+using namespace std;
+
+/*!
+ * \brief The CacheSection struct is the position of a section in an image.
+ */
+struct CacheSection
+{
+    uint64_t offset; /*!< Offset of the records             */
+    uint64_t count;  /*!< Number of records                 */
+    uint64_t size;   /*!< Size (bytes) of a record          */
+};
+
+/*!
+ * \brief The CacheHeader struct starts the binary image of a model.
+ */
+struct CacheHeader
+{
+    char         magic[8];   /*!< ModelCache::MAGIC                                  */
+    uint32_t     version;    /*!< ModelCache::VERSION                                */
+    uint32_t     byteOrder;  /*!< ModelCache::ORDER_MARK (in the host order)         */
+    uint64_t     sourceHash; /*!< Hash of the configuration file (FNV-1a)            */
+    uint64_t     sourceSize; /*!< Size (bytes) of the configuration file             */
+    int64_t      sourceTime; /*!< Modification time (ns) of the file (0 if unknown)  */
+    uint64_t     imageSize;  /*!< Size (bytes) of the image                          */
+    CacheSection sections[ModelCache::SECTIONS_COUNT]; /*!< Sections of the image    */
+};
+
+const char*    ModelCache::MAGIC      = "MGCACHE";
+const uint32_t ModelCache::VERSION    = 2;
+const uint32_t ModelCache::ORDER_MARK = 0x01020304;
+const int64_t  ModelCache::RACY_NS    = 2000000000;
+
+static const size_t ALIGNMENT = 8; /*!< Alignment of the sections of the image */
+
+////////////////////////////////////////////////////////////////////////
+static uint64_t align(uint64_t p_offset)
+{
+    return (p_offset + ALIGNMENT - 1) & ~static_cast<uint64_t>(ALIGNMENT - 1);
+}
+
+////////////////////////////////////////////////////////////////////////
+static bool getSource(const string& p_sourcePath, uint64_t& p_size, int64_t& p_time)
+{
+    error_code l_error;
+    p_size = filesystem::file_size(p_sourcePath, l_error);
+    if(l_error)
+    {
+        return false;
+    }
+
+    auto l_time = filesystem::last_write_time(p_sourcePath, l_error);
+    if(l_error)
+    {
+        return false;
+    }
+
+    // A time which could be that of another change of the file is not used (0)
+    auto l_age = filesystem::file_time_type::clock::now() - l_time;
+    p_time     = chrono::duration_cast<chrono::nanoseconds>(l_time.time_since_epoch()).count();
+    if(chrono::duration_cast<chrono::nanoseconds>(l_age).count() < ModelCache::RACY_NS)
+    {
+        p_time = 0;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+ModelCache::ModelCache() :
+    newSections(SECTIONS_COUNT),
+#ifdef _WIN32
+    copy(),
+#endif
+    image(nullptr),
+    imageSize(0),
+    header(nullptr)
+{}
+
+////////////////////////////////////////////////////////////////////////
+ModelCache::~ModelCache()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t ModelCache::hashFile(const string& p_filePath, uint64_t& p_size)
+{
+    FILE* l_file = fopen(p_filePath.c_str(), "rb");
+    if(!l_file)
+    {
+        ERROR("Error - Unable to open the configuration file " + p_filePath + ".");
+        throw Exception::ParsingFileError("Unable to open the configuration file " + p_filePath + ".");
+    }
+
+    uint64_t      l_hash = 14695981039346656037ull;
+    unsigned char l_block[65536];
+    size_t        l_read = 0;
+
+    p_size = 0;
+    while((l_read = fread(l_block, 1, sizeof(l_block), l_file)) > 0)
+    {
+        for(size_t i = 0; i < l_read; i++)
+        {
+            l_hash = (l_hash ^ l_block[i]) * 1099511628211ull;
+        }
+        p_size += l_read;
+    }
+    fclose(l_file);
+
+    return l_hash;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelCache::addSection(SECTION p_section, const void* p_records, size_t p_count, size_t p_size)
+{
+    NewSection& l_section = newSections[p_section];
+    const char* l_records = static_cast<const char*>(p_records);
+    l_section.bytes.assign(l_records, l_records + p_count * p_size);
+    l_section.count = p_count;
+    l_section.size  = p_size;
+}
+
+////////////////////////////////////////////////////////////////////////
+const void* ModelCache::getSection(SECTION p_section, size_t p_size, size_t& p_count) const
+{
+    p_count = 0;
+    if(!header || header->sections[p_section].size != p_size)
+    {
+        return nullptr;
+    }
+
+    p_count = static_cast<size_t>(header->sections[p_section].count);
+    return static_cast<const char*>(image) + header->sections[p_section].offset;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ModelCache::save(const string& p_cachePath, const string& p_sourcePath) const
+{
+    CacheHeader l_header;
+    memset(&l_header, 0, sizeof(l_header));
+    memcpy(l_header.magic, MAGIC, strlen(MAGIC) + 1);
+    l_header.version    = VERSION;
+    l_header.byteOrder  = ORDER_MARK;
+    l_header.sourceHash = hashFile(p_sourcePath, l_header.sourceSize);
+
+    uint64_t l_size = 0;
+    if(!getSource(p_sourcePath, l_size, l_header.sourceTime) || l_size != l_header.sourceSize)
+    {
+        // Changed while hashed: the time is not recorded
+        l_header.sourceTime = 0;
+    }
+
+    uint64_t l_offset = align(sizeof(l_header));
+    for(size_t i = 0; i < SECTIONS_COUNT; i++)
+    {
+        l_header.sections[i].offset = l_offset;
+        l_header.sections[i].count  = newSections[i].count;
+        l_header.sections[i].size   = newSections[i].size;
+        l_offset = align(l_offset + newSections[i].bytes.size());
+    }
+    l_header.imageSize = l_offset;
+
+    vector<char> l_image(l_header.imageSize, 0);
+    memcpy(l_image.data(), &l_header, sizeof(l_header));
+    for(size_t i = 0; i < SECTIONS_COUNT; i++)
+    {
+        if(!newSections[i].bytes.empty())
+        {
+            memcpy(l_image.data() + l_header.sections[i].offset, newSections[i].bytes.data(), newSections[i].bytes.size());
+        }
+    }
+
+    // The image is renamed once complete: a model being started never reads half of it
+    string l_tmpPath = p_cachePath + ".tmp" + to_string(getpid());
+    FILE*  l_file    = fopen(l_tmpPath.c_str(), "wb");
+    if(!l_file)
+    {
+        ERROR("Error - Unable to create the model cache " + p_cachePath + ".");
+        return false;
+    }
+
+    bool l_ok = (fwrite(l_image.data(), 1, l_image.size(), l_file) == l_image.size());
+    l_ok      = (fclose(l_file) == 0) && l_ok;
+    l_ok      = l_ok && (rename(l_tmpPath.c_str(), p_cachePath.c_str()) == 0);
+    if(!l_ok)
+    {
+        remove(l_tmpPath.c_str());
+        ERROR("Error - Unable to write the model cache " + p_cachePath + ".");
+        return false;
+    }
+
+    DEBUG("Model cache written to " + p_cachePath);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ModelCache::open(const string& p_cachePath, const string& p_sourcePath)
+{
+    close();
+
+    // The loader reports a missing configuration file
+    uint64_t l_sourceSize = 0;
+    int64_t  l_sourceTime = 0;
+    if(!getSource(p_sourcePath, l_sourceSize, l_sourceTime))
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    // No mapping: the image is read in memory (aligned as the sections of the image)
+    FILE* l_file = fopen(p_cachePath.c_str(), "rb");
+    if(!l_file)
+    {
+        return false;
+    }
+
+    long l_size = -1;
+    if(fseek(l_file, 0, SEEK_END) == 0)
+    {
+        l_size = ftell(l_file);
+    }
+    if(l_size < static_cast<long>(sizeof(CacheHeader)) || fseek(l_file, 0, SEEK_SET) != 0)
+    {
+        fclose(l_file);
+        return false;
+    }
+
+    copy.assign((static_cast<size_t>(l_size) + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    bool l_read = (fread(copy.data(), 1, static_cast<size_t>(l_size), l_file) == static_cast<size_t>(l_size));
+    fclose(l_file);
+    if(!l_read)
+    {
+        copy.clear();
+        return false;
+    }
+
+    imageSize = static_cast<size_t>(l_size);
+    image     = copy.data();
+#else
+    int l_file = ::open(p_cachePath.c_str(), O_RDONLY);
+    if(l_file < 0)
+    {
+        return false;
+    }
+
+    struct stat l_stat;
+    if(fstat(l_file, &l_stat) != 0 || static_cast<size_t>(l_stat.st_size) < sizeof(CacheHeader))
+    {
+        ::close(l_file);
+        return false;
+    }
+
+    imageSize = static_cast<size_t>(l_stat.st_size);
+    image     = mmap(nullptr, imageSize, PROT_READ, MAP_PRIVATE, l_file, 0);
+    ::close(l_file);
+    if(image == MAP_FAILED)
+    {
+        image = nullptr;
+        return false;
+    }
+#endif
+
+    const CacheHeader* l_header = static_cast<const CacheHeader*>(image);
+
+    // Every section must lie in the image
+    bool l_valid = strncmp(l_header->magic, MAGIC, sizeof(l_header->magic)) == 0 &&
+                   l_header->version   == VERSION                            &&
+                   l_header->byteOrder == ORDER_MARK                         &&
+                   l_header->imageSize == imageSize;
+    for(size_t i = 0; l_valid && i < SECTIONS_COUNT; i++)
+    {
+        const CacheSection& l_section = l_header->sections[i];
+        l_valid = l_section.offset == align(l_section.offset)                  &&
+                  l_section.offset >= sizeof(CacheHeader)                      &&
+                  l_section.offset <= imageSize                                &&
+                  (l_section.count == 0 || (l_section.size > 0 &&
+                   l_section.count <= (imageSize - l_section.offset) / l_section.size));
+    }
+
+    if(!l_valid)
+    {
+        INFO("The model cache " + p_cachePath + " is not valid - it will be rebuilt.");
+        close();
+        return false;
+    }
+
+    // The file is only hashed if it was touched since the image was checked
+    bool l_upToDate = (l_header->sourceSize == l_sourceSize);
+    if(l_upToDate && (l_header->sourceTime == 0 || l_header->sourceTime != l_sourceTime))
+    {
+        uint64_t l_size = 0;
+        l_upToDate = (hashFile(p_sourcePath, l_size) == l_header->sourceHash && l_size == l_sourceSize);
+        if(l_upToDate && l_sourceTime != 0)
+        {
+            record(p_cachePath, l_sourceTime);
+        }
+    }
+
+    if(!l_upToDate)
+    {
+        INFO("The model cache " + p_cachePath + " is out of date - it will be rebuilt.");
+        close();
+        return false;
+    }
+
+    header = l_header;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelCache::record(const string& p_cachePath, int64_t p_sourceTime)
+{
+    // Only the time is written: the image mapped is not changed otherwise
+    FILE* l_file = fopen(p_cachePath.c_str(), "r+b");
+    if(!l_file)
+    {
+        return;
+    }
+
+    if(fseek(l_file, static_cast<long>(offsetof(CacheHeader, sourceTime)), SEEK_SET) == 0)
+    {
+        fwrite(&p_sourceTime, sizeof(p_sourceTime), 1, l_file);
+    }
+    fclose(l_file);
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelCache::close()
+{
+    if(image)
+    {
+#ifdef _WIN32
+        copy.clear();
+#else
+        munmap(image, imageSize);
+#endif
+    }
+
+    image     = nullptr;
+    imageSize = 0;
+    header    = nullptr;
+}
+
+} // namespace ModGen
@@ -0,0 +1,182 @@
+/*!
+ * @file   ModelCache.h
+ * @brief  Contains the binary image of a compiled model, mapped
+ *         instead of loading its configuration file when it is up to date.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef MODELCACHE_MODELGENERATOR
+#define MODELCACHE_MODELGENERATOR
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ModGen {
+
+struct CacheHeader;
+
+/*!
+ * \brief The ModelCache class is the binary image of a compiled model: the
+ *        records of its \a ModelDefinition (states, operations, transitions,
+ *        messages with their frame templates and dynamic fields, routes, strings
+ *        and the initial runtime block), each in a section of the image.
+ *        Every position in the image is an offset from its start: the image is
+ *        mapped in memory (mmap - read on Windows) and its records used in place,
+ *        without parsing, checking or compiling the model again.
+ *
+ *        It is only used if it has the version of the library and was built from
+ *        the configuration file: the size and modification time of the file are
+ *        compared first, the file is only hashed when its time changed (a hash
+ *        matching again records the new time in the image).
+ *        NB : A time too close to the building of the image is not recorded
+ *             (the file could change again within the resolution of the clock):
+ *             the file is hashed until the image is checked again later.
+ */
+class ModelCache
+{
+public:
+    /*!
+     * Enumerate of the sections of an image (Cf. ModelDefinition::save).
+     */
+    typedef enum {
+        SECTION_LAYOUT      = 0,  /*!< Start state and layout of the block */
+        SECTION_STATES      = 1,  /*!< CompiledState records               */
+        SECTION_OPERATIONS  = 2,  /*!< CompiledOperation records           */
+        SECTION_TRANSITIONS = 3,  /*!< CompiledTransition records          */
+        SECTION_SENDS       = 4,  /*!< Messages sent by the states         */
+        SECTION_MESSAGES    = 5,  /*!< CompiledMessage records             */
+        SECTION_FIELDS      = 6,  /*!< CompiledField records               */
+        SECTION_ROUTES      = 7,  /*!< CompiledRoute records               */
+        SECTION_FRAMES      = 8,  /*!< Frame templates of the messages     */
+        SECTION_STRINGS     = 9,  /*!< Names, addresses and interfaces     */
+        SECTION_VARIABLES   = 10, /*!< Names of the variables              */
+        SECTION_WATCHES     = 11, /*!< CompiledWatch records               */
+        SECTION_DEPENDENTS  = 12, /*!< Conditions reading the watches      */
+        SECTION_BLOCK       = 13, /*!< Initial runtime block               */
+        SECTIONS_COUNT      = 14  /*!< Number of sections                  */
+    } SECTION;
+
+    static const char*    MAGIC;      /*!< First bytes of an image                          */
+    static const uint32_t VERSION;    /*!< Version of the format of the image               */
+    static const uint32_t ORDER_MARK; /*!< Read in another order on a foreign host          */
+    static const int64_t  RACY_NS;    /*!< Age (ns) of a modification time to be recorded   */
+
+    /*!
+     * \brief ModelCache constructor (empty image)
+     */
+    ModelCache();
+
+    /*!
+     * \brief ~ModelCache destructor (unmaps the image)
+     */
+    ~ModelCache();
+
+    ModelCache(const ModelCache&)            = delete;
+    ModelCache& operator=(const ModelCache&) = delete;
+
+    /*!
+     * \brief hashFile computes the hash of a file (64 bits FNV-1a).
+     * \param p_filePath the path of the file.
+     * \param p_size the size (bytes) of the file.
+     * \return the hash of the file.
+     * NB : Throws a ParsingFileError if the file cannot be read.
+     */
+    static uint64_t hashFile(const std::string& p_filePath, uint64_t& p_size);
+
+    /*!
+     * \brief addSection copies records into a section of the image being built.
+     * \param p_section the section.
+     * \param p_records the records (plain data).
+     * \param p_count the number of records.
+     */
+    template<typename T>
+    void addSection(SECTION p_section, const T* p_records, std::size_t p_count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "The records of an image are plain data");
+        addSection(p_section, p_records, p_count, sizeof(T));
+    }
+
+    /*!
+     * \brief getSection
+     * \param p_section the section.
+     * \param p_count the number of records of the section.
+     * \return the records of the section in the mapped image, nullptr
+     *         if they are not records of this type (size).
+     */
+    template<typename T>
+    const T* getSection(SECTION p_section, std::size_t& p_count) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "The records of an image are plain data");
+        return static_cast<const T*>(getSection(p_section, sizeof(T), p_count));
+    }
+
+    /*!
+     * \brief save writes the image built (written to a temporary
+     *        file first, renamed once complete).
+     * \param p_cachePath the path of the image.
+     * \param p_sourcePath the path of the configuration file.
+     * \return false if the image could not be written.
+     */
+    bool save(const std::string& p_cachePath, const std::string& p_sourcePath) const;
+
+    /*!
+     * \brief open maps an image in memory (reads it on Windows).
+     * \param p_cachePath the path of the image.
+     * \param p_sourcePath the path of the configuration file.
+     * \return false if the image does not exist, is not valid or is out
+     *         of date (another version or another configuration file).
+     */
+    bool open(const std::string& p_cachePath, const std::string& p_sourcePath);
+
+private:
+    /*!
+     * \brief addSection copies records into a section of the image being built.
+     */
+    void addSection(SECTION p_section, const void* p_records, std::size_t p_count, std::size_t p_size);
+
+    /*!
+     * \brief getSection
+     * \return the records of a section in the mapped image (Cf. getSection).
+     */
+    const void* getSection(SECTION p_section, std::size_t p_size, std::size_t& p_count) const;
+
+    /*!
+     * \brief record writes the modification time of the configuration file
+     *        into an image (checked up to date by its hash).
+     * \param p_cachePath the path of the image.
+     * \param p_sourceTime the modification time (ns) of the file.
+     */
+    static void record(const std::string& p_cachePath, int64_t p_sourceTime);
+
+    /*!
+     * \brief close unmaps (or frees) the image.
+     */
+    void close();
+
+private:
+    /*!
+     * \brief The NewSection struct is a section of the image being built.
+     */
+    struct NewSection
+    {
+        std::vector<char> bytes; /*!< The records             */
+        std::size_t       count; /*!< Number of records       */
+        std::size_t       size;  /*!< Size (bytes) of records */
+    };
+
+    std::vector<NewSection> newSections; /*!< Sections of the image being built   */
+#ifdef _WIN32
+    std::vector<uint64_t>   copy;        /*!< The image read (no mapping)         */
+#endif
+
+    void*                   image;       /*!< The mapped image                    */
+    std::size_t             imageSize;   /*!< Size (bytes) of the mapping         */
+    const CacheHeader*      header;      /*!< Header of the mapped image          */
+};
+
+} // namespace ModGen
+
+#endif // MODELCACHE_MODELGENERATOR
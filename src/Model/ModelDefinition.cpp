@@ -0,0 +1,662 @@
+/*!
+ * @file   ModelDefinition.cpp
+ * @brief  Implementations of the functions defined in \a ModelDefinition.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include "ModelDefinition.h"
+#include "ModelInstance.h"
+#include "State.h"
+#include "Message.h"
+#include "Header.h"
+#include "Field_time.h"
+#include "Exception.h"
+#include "Logger.h"
+#include "random_util.h"
+#include "ModelCache.h"
+
+#include <cstring>
+#include <map>
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+ModelDefinition::ModelDefinition() :
+    states(),
+    operations(),
+    transitions(),
+    sends(),
+    messages(),
+    fields(),
+    route_records(),
+    frames(),
+    strings(),
+    variables(),
+    routes(),
+    watches(),
+    dependents(),
+    block(),
+    start(0),
+    variables_count(0),
+    values_offset(0),
+    versions_offset(0),
+    counters_offset(0),
+    watches_offset(0),
+    randoms_offset(0),
+    image()
+{}
+
+////////////////////////////////////////////////////////////////////////
+void ModelDefinition::compile(ModelInstance& p_model)
+{
+    clear();
+
+    // The variables and states are indexed by their ID
+    const ModelInstance::ModelState& l_modelStates = p_model.getStates();
+    const VariableStore&             l_vars        = p_model.getVariables();
+
+    // A message sent by several states, or a route used by several
+    // messages, is compiled once
+    map<const Message*, uint32_t> l_compiledMessages;
+    map<string, uint32_t>         l_compiledRoutes;
+    vector<uint64_t>              l_seeds;
+
+    // The records are built, then owned by the definition (Cf. Records)
+    vector<CompiledState>      l_states;
+    vector<CompiledOperation>  l_operations;
+    vector<CompiledTransition> l_transitions;
+    vector<uint32_t>           l_sends;
+    vector<CompiledMessage>    l_messages;
+    vector<CompiledField>      l_fields;
+    vector<CompiledRoute>      l_routes;
+    vector<uint8_t>            l_frames;
+    vector<char>               l_strings;
+    vector<uint32_t>           l_variables;
+    vector<CompiledWatch>      l_watches;
+    vector<uint32_t>           l_dependents;
+    vector<uint32_t>           l_block;
+
+    uint32_t l_counters = 0;
+    for(SymbolTable::ID l_id = 0; l_id < l_modelStates.size(); l_id++)
+    {
+        // The getters of the state are not const
+        State& l_state = const_cast<State&>(l_modelStates[l_id]);
+
+        CompiledState l_compiled;
+        l_compiled.name     = addString(l_strings, l_state.getId());
+        l_compiled.op_begin = static_cast<uint32_t>(l_operations.size());
+        for(auto& l_op: l_state.getOperations())
+        {
+            CompiledOperation l_record;
+            l_record.var   = l_op.getVarId();
+            l_record.value = l_op.getValue();
+            switch(l_op.getOperande())
+            {
+            case Operation::OP_ADD:    l_record.kind = OPER_ADD;    break;
+            case Operation::OP_SUB:    l_record.kind = OPER_SUB;    break;
+            case Operation::OP_ASSIGN: l_record.kind = OPER_ASSIGN; break;
+            case Operation::OP_DEL:    l_record.kind = OPER_RESET;  break;
+            default:
+                ERROR("Error - Unable to compile the operation on " + l_op.getVar() + ".");
+                throw Exception::UnimplementedElement<Operation::OPERANDE>(l_op.getOperande());
+            }
+            l_operations.push_back(l_record);
+        }
+        l_compiled.op_end = static_cast<uint32_t>(l_operations.size());
+
+        l_compiled.mesg_begin = static_cast<uint32_t>(l_sends.size());
+        for(size_t i = 0; i < l_state.getMessagesCount(); i++)
+        {
+            const Message& l_message = l_state.getMessage(i);
+            auto           l_known   = l_compiledMessages.find(&l_message);
+            if(l_known != l_compiledMessages.end())
+            {
+                l_sends.push_back(l_known->second);
+                continue;
+            }
+
+            // The frame template holds the static fields (Cf. Message::compile)
+            const vector<uint8_t>& l_frame = l_message.getFrameTemplate();
+            if(l_frame.empty())
+            {
+                ERROR("Error - The message which ID is " + l_message.getId() + " is not compiled.");
+                throw Exception::IntegrityCheckException<Message>("The message which ID is " + l_message.getId() + " is not compiled.");
+            }
+
+            CompiledMessage l_record;
+            l_record.name        = addString(l_strings, l_message.getId());
+            l_record.frame       = static_cast<uint32_t>(l_frames.size());
+            l_record.size        = static_cast<uint32_t>(l_frame.size());
+            l_record.header_size = l_message.getHeaderSize();
+            l_record.random      = NO_RANDOM;
+            l_frames.insert(l_frames.end(), l_frame.begin(), l_frame.end());
+
+            switch(l_message.getFill())
+            {
+            case Message::MESG_FILL_ZERO:
+                break;
+            case Message::MESG_FILL_RANDOM:
+                // The generators follow the watches in the block
+                l_record.random = static_cast<uint32_t>(l_seeds.size() * RandomGenerator::STATE_WORDS);
+                l_seeds.push_back(l_message.getSeed());
+                break;
+            default:
+                ERROR("Error - Unable to compile the filling method of the message which ID is " + l_message.getId() + ".");
+                throw Exception::UnimplementedElement<Message::FILL_METHOD>(l_message.getFill());
+            }
+
+            // The timestamps are the only dynamic fields
+            l_record.field_begin = static_cast<uint32_t>(l_fields.size());
+            for(auto l_field: l_message.getHeader()->getDynamicFields())
+            {
+                auto l_time = dynamic_cast<const Field_time*>(l_field);
+                if(!l_time)
+                {
+                    ERROR("Error - Unable to compile the dynamic field which ID is " + l_field->getId() + ".");
+                    throw Exception::IntegrityCheckException<ModelDefinition>(l_field->getId());
+                }
+                if(l_field->getSize() == 0)
+                {
+                    continue;
+                }
+                if(l_field->getEndian() != Field::_BIG_ENDIAN && l_field->getEndian() != Field::_LITTLE_ENDIAN)
+                {
+                    throw Exception::UnimplementedElement<Field::_ENDIAN>(l_field->getEndian());
+                }
+
+                CompiledField l_compiledField;
+                l_compiledField.layout = l_field->getLayout();
+                l_compiledField.size   = static_cast<uint32_t>(l_field->getSize());
+                l_compiledField.format = l_time->getFormat();
+                l_compiledField.flags  = (l_field->getEndian() == Field::_BIG_ENDIAN ? FIELD_BIG_ENDIAN : 0)
+                                       | (l_field->isSwapped()                       ? FIELD_SWAP       : 0)
+                                       | (l_field->isInverted()                      ? FIELD_INVERT     : 0);
+                l_fields.push_back(l_compiledField);
+            }
+            l_record.field_end = static_cast<uint32_t>(l_fields.size());
+
+            string l_route = l_message.getSrcIP() + ':' + to_string(l_message.getSrcPort()) + '>'
+                           + l_message.getDstIP() + ':' + to_string(l_message.getDstPort()) + '@'
+                           + l_message.getIntface();
+            auto l_knownRoute = l_compiledRoutes.find(l_route);
+            if(l_knownRoute == l_compiledRoutes.end())
+            {
+                CompiledRoute l_compiledRoute;
+                l_compiledRoute.src_ip    = addString(l_strings, l_message.getSrcIP());
+                l_compiledRoute.dst_ip    = addString(l_strings, l_message.getDstIP());
+                l_compiledRoute.interface = addString(l_strings, l_message.getIntface());
+                l_compiledRoute.src_port  = l_message.getSrcPort();
+                l_compiledRoute.dst_port  = l_message.getDstPort();
+                l_knownRoute = l_compiledRoutes.emplace(l_route, static_cast<uint32_t>(l_routes.size())).first;
+                l_routes.push_back(l_compiledRoute);
+            }
+            l_record.route = l_knownRoute->second;
+
+            l_compiledMessages.emplace(&l_message, static_cast<uint32_t>(l_messages.size()));
+            l_sends.push_back(static_cast<uint32_t>(l_messages.size()));
+            l_messages.push_back(l_record);
+        }
+        l_compiled.mesg_end = static_cast<uint32_t>(l_sends.size());
+
+        l_compiled.trans_begin = static_cast<uint32_t>(l_transitions.size());
+        for(auto l_trans: l_state.getTransitions())
+        {
+            if(!l_trans || l_trans->getDestId() >= l_modelStates.size())
+            {
+                ERROR("Error - The State which ID's " + l_state.getId() + " references an invalid Transition.");
+                throw Exception::IntegrityCheckException<ModelDefinition>(l_state.getId());
+            }
+
+            CompiledTransition l_record;
+            l_record.kind  = TRANS_ALWAYS;
+            l_record.dest  = l_trans->getDestId();
+            l_record.slot  = 0;
+            l_record.value = 0;
+            l_record.delay = l_trans->getDelay();
+
+            if(auto l_loop = dynamic_cast<LoopTransition*>(l_trans))
+            {
+                // Same counters as the object graph (Cf. ModelInstance::getLoopCounter)
+                l_record.kind  = TRANS_LOOP;
+                l_record.slot  = l_loop->getCounter();
+                l_record.value = l_loop->getTimes();
+                l_counters     = max(l_counters, l_record.slot + 1);
+            }
+            else if(auto l_cond = dynamic_cast<VarConditionTransition*>(l_trans))
+            {
+                if(!l_cond->isDefault())
+                {
+                    switch(l_cond->getOperande())
+                    {
+                    case VarConditionTransition::OP_OVER:  l_record.kind = TRANS_OVER;  break;
+                    case VarConditionTransition::OP_UNDER: l_record.kind = TRANS_UNDER; break;
+                    case VarConditionTransition::OP_EQUAL: l_record.kind = TRANS_EQUAL; break;
+                    default:
+                        throw Exception::UnimplementedElement<VarConditionTransition::OPERANDE>(l_cond->getOperande());
+                    }
+                    l_record.slot  = l_cond->getVarId();
+                    l_record.value = l_cond->getValue();
+                }
+            }
+            l_transitions.push_back(l_record);
+        }
+        l_compiled.trans_end = static_cast<uint32_t>(l_transitions.size());
+
+        // Dependency index: the conditions of the state, by variable read
+        l_compiled.watch_begin = static_cast<uint32_t>(l_watches.size());
+        uint32_t l_conditions  = 0;
+        for(uint32_t i = l_compiled.trans_begin; i < l_compiled.trans_end; i++)
+        {
+            if(l_transitions[i].kind < TRANS_OVER)
+            {
+                continue;
+            }
+            l_conditions++;
+
+            bool l_known = false;
+            for(uint32_t w = l_compiled.watch_begin; w < l_watches.size() && !l_known; w++)
+            {
+                l_known = (l_watches[w].var == l_transitions[i].slot);
+            }
+            if(l_known)
+            {
+                continue;
+            }
+
+            CompiledWatch l_watch;
+            l_watch.var       = l_transitions[i].slot;
+            l_watch.dep_begin = static_cast<uint32_t>(l_dependents.size());
+            for(uint32_t d = i; d < l_compiled.trans_end; d++)
+            {
+                if(l_transitions[d].kind >= TRANS_OVER && l_transitions[d].slot == l_watch.var)
+                {
+                    l_dependents.push_back(d);
+                }
+            }
+            l_watch.dep_end = static_cast<uint32_t>(l_dependents.size());
+            l_watches.push_back(l_watch);
+        }
+
+        // The variables are checked on every step: the conditions are only
+        // cached when there are several of them per variable. A waiting state
+        // keeps its index to wait for its variables.
+        uint32_t l_read    = static_cast<uint32_t>(l_watches.size()) - l_compiled.watch_begin;
+        bool     l_indexed = (l_conditions >= INDEXED_CONDITIONS && l_conditions >= 2 * l_read);
+        if(!l_indexed && !l_state.isWaiting())
+        {
+            if(l_read)
+            {
+                l_dependents.resize(l_watches[l_compiled.watch_begin].dep_begin);
+            }
+            l_watches.resize(l_compiled.watch_begin);
+        }
+        l_compiled.watch_end = static_cast<uint32_t>(l_watches.size());
+
+        l_compiled.flags   = (l_state.isWaiting() ? STATE_WAIT    : 0)
+                           | (l_state.isResent()  ? STATE_RESEND  : 0)
+                           | (l_indexed           ? STATE_INDEXED : 0);
+        l_compiled.timeout = l_state.getWaitTimeout();
+
+        l_states.push_back(l_compiled);
+    }
+
+    // Layout of the runtime block: cached conditions (one bit per transition),
+    // values and versions of the variables, loop counters, versions of the watches,
+    // generators of the messages
+    variables_count = static_cast<uint32_t>(l_vars.size());
+    values_offset   = static_cast<uint32_t>((l_transitions.size() + 31) / 32);
+    versions_offset = values_offset   + variables_count;
+    counters_offset = versions_offset + variables_count;
+    watches_offset  = counters_offset + l_counters;
+    randoms_offset  = watches_offset  + static_cast<uint32_t>(l_watches.size());
+    l_block.assign(randoms_offset + l_seeds.size() * RandomGenerator::STATE_WORDS, 0);
+
+    for(auto& l_message: l_messages)
+    {
+        if(l_message.random != NO_RANDOM)
+        {
+            l_message.random += randoms_offset;
+            RandomGenerator(l_seeds[(l_message.random - randoms_offset) / RandomGenerator::STATE_WORDS])
+                .save(&l_block[l_message.random]);
+        }
+    }
+
+    // The transitions which are not conditions are always candidates
+    // (the conditions are evaluated by the instances, Cf. CompiledModel::reset)
+    for(uint32_t i = 0; i < l_transitions.size(); i++)
+    {
+        if(l_transitions[i].kind < TRANS_OVER)
+        {
+            l_block[i / 32] |= uint32_t(1) << (i % 32);
+        }
+    }
+    for(SymbolTable::ID i = 0; i < variables_count; i++)
+    {
+        l_block[values_offset + i] = static_cast<uint32_t>(l_vars.getInitial(i));
+        l_variables.push_back(addString(l_strings, p_model.getSymbols().variables.getName(i)));
+    }
+
+    if(!l_states.empty())
+    {
+        start = p_model.getSymbols().states.find(p_model.getCurrState()->getId());
+    }
+
+    states.assign(move(l_states));
+    operations.assign(move(l_operations));
+    transitions.assign(move(l_transitions));
+    sends.assign(move(l_sends));
+    messages.assign(move(l_messages));
+    fields.assign(move(l_fields));
+    route_records.assign(move(l_routes));
+    frames.assign(move(l_frames));
+    strings.assign(move(l_strings));
+    variables.assign(move(l_variables));
+    watches.assign(move(l_watches));
+    dependents.assign(move(l_dependents));
+    block.assign(move(l_block));
+    bindRoutes();
+
+    DEBUG("Model compiled - " + to_string(states.size())      + " state(s), "
+                              + to_string(transitions.size()) + " transition(s), "
+                              + to_string(messages.size())    + " message(s), "
+                              + to_string(block.size() * sizeof(uint32_t)) + " byte(s) per instance.");
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t ModelDefinition::encode(uint32_t p_mesg, uint8_t* p_buffer, size_t p_capacity, uint32_t* p_block) const
+{
+    const CompiledMessage& l_mesg = messages[p_mesg];
+    if(p_capacity < l_mesg.size)
+    {
+        ERROR("Error - The buffer is too small to encode the message which ID is " + string(strings.data() + l_mesg.name) + ".");
+        throw Exception::BufferOverflow(l_mesg.size, p_capacity);
+    }
+
+    const uint8_t* l_frame = frames.data() + l_mesg.frame;
+    if(l_mesg.random != NO_RANDOM)
+    {
+        // The generator is a copy of the instance's one, written back once used
+        RandomGenerator l_random(p_block + l_mesg.random);
+        memcpy(p_buffer, l_frame, l_mesg.header_size);
+        l_random.fill(p_buffer + l_mesg.header_size, l_mesg.size - l_mesg.header_size);
+        l_random.save(p_block + l_mesg.random);
+    }
+    else
+    {
+        memcpy(p_buffer, l_frame, l_mesg.size);
+    }
+
+    // The dynamic fields bits are zeroed in the template
+    for(uint32_t i = l_mesg.field_begin; i < l_mesg.field_end; i++)
+    {
+        const CompiledField& l_field = fields[i];
+        uint64_t l_bits = FieldHelper::toBits(Field_time::getTime(static_cast<Field_time::TIME_FORMAT>(l_field.format)),
+                                              l_field.flags & FIELD_BIG_ENDIAN,
+                                              l_field.flags & FIELD_SWAP,
+                                              l_field.flags & FIELD_INVERT,
+                                              l_field.size,
+                                              l_field.layout.mask);
+        FieldHelper::writeBits(l_field.layout, l_field.size, l_bits, p_buffer, l_mesg.size);
+    }
+
+    return l_mesg.size;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelDefinition::save(ModelCache& p_cache) const
+{
+    uint32_t l_layout[LAYOUT_WORDS];
+    l_layout[LAYOUT_START]     = start;
+    l_layout[LAYOUT_VARIABLES] = variables_count;
+    l_layout[LAYOUT_VALUES]    = values_offset;
+    l_layout[LAYOUT_VERSIONS]  = versions_offset;
+    l_layout[LAYOUT_COUNTERS]  = counters_offset;
+    l_layout[LAYOUT_WATCHES]   = watches_offset;
+    l_layout[LAYOUT_RANDOMS]   = randoms_offset;
+
+    p_cache.addSection(ModelCache::SECTION_LAYOUT,      l_layout,             LAYOUT_WORDS);
+    p_cache.addSection(ModelCache::SECTION_STATES,      states.data(),        states.size());
+    p_cache.addSection(ModelCache::SECTION_OPERATIONS,  operations.data(),    operations.size());
+    p_cache.addSection(ModelCache::SECTION_TRANSITIONS, transitions.data(),   transitions.size());
+    p_cache.addSection(ModelCache::SECTION_SENDS,       sends.data(),         sends.size());
+    p_cache.addSection(ModelCache::SECTION_MESSAGES,    messages.data(),      messages.size());
+    p_cache.addSection(ModelCache::SECTION_FIELDS,      fields.data(),        fields.size());
+    p_cache.addSection(ModelCache::SECTION_ROUTES,      route_records.data(), route_records.size());
+    p_cache.addSection(ModelCache::SECTION_FRAMES,      frames.data(),        frames.size());
+    p_cache.addSection(ModelCache::SECTION_STRINGS,     strings.data(),       strings.size());
+    p_cache.addSection(ModelCache::SECTION_VARIABLES,   variables.data(),     variables.size());
+    p_cache.addSection(ModelCache::SECTION_WATCHES,     watches.data(),       watches.size());
+    p_cache.addSection(ModelCache::SECTION_DEPENDENTS,  dependents.data(),    dependents.size());
+    p_cache.addSection(ModelCache::SECTION_BLOCK,       block.data(),         block.size());
+}
+
+////////////////////////////////////////////////////////////////////////
+template<typename T>
+static bool viewSection(const ModelCache& p_cache, ModelCache::SECTION p_section, Records<T>& p_records)
+{
+    size_t   l_count   = 0;
+    const T* l_records = p_cache.getSection<T>(p_section, l_count);
+    p_records.view(l_records, l_count);
+    return l_records != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ModelDefinition::load(shared_ptr<const ModelCache> p_image)
+{
+    clear();
+
+    size_t          l_words  = 0;
+    const uint32_t* l_layout = p_image->getSection<uint32_t>(ModelCache::SECTION_LAYOUT, l_words);
+
+    // The records are used in place: the image is kept with them
+    bool l_valid = l_layout && l_words == LAYOUT_WORDS                                      &&
+                   viewSection(*p_image, ModelCache::SECTION_STATES,      states)           &&
+                   viewSection(*p_image, ModelCache::SECTION_OPERATIONS,  operations)       &&
+                   viewSection(*p_image, ModelCache::SECTION_TRANSITIONS, transitions)      &&
+                   viewSection(*p_image, ModelCache::SECTION_SENDS,       sends)            &&
+                   viewSection(*p_image, ModelCache::SECTION_MESSAGES,    messages)         &&
+                   viewSection(*p_image, ModelCache::SECTION_FIELDS,      fields)           &&
+                   viewSection(*p_image, ModelCache::SECTION_ROUTES,      route_records)    &&
+                   viewSection(*p_image, ModelCache::SECTION_FRAMES,      frames)           &&
+                   viewSection(*p_image, ModelCache::SECTION_STRINGS,     strings)          &&
+                   viewSection(*p_image, ModelCache::SECTION_VARIABLES,   variables)        &&
+                   viewSection(*p_image, ModelCache::SECTION_WATCHES,     watches)          &&
+                   viewSection(*p_image, ModelCache::SECTION_DEPENDENTS,  dependents)       &&
+                   viewSection(*p_image, ModelCache::SECTION_BLOCK,       block);
+    if(l_valid)
+    {
+        start           = l_layout[LAYOUT_START];
+        variables_count = l_layout[LAYOUT_VARIABLES];
+        values_offset   = l_layout[LAYOUT_VALUES];
+        versions_offset = l_layout[LAYOUT_VERSIONS];
+        counters_offset = l_layout[LAYOUT_COUNTERS];
+        watches_offset  = l_layout[LAYOUT_WATCHES];
+        randoms_offset  = l_layout[LAYOUT_RANDOMS];
+        image           = move(p_image);
+        l_valid         = check();
+    }
+
+    if(!l_valid)
+    {
+        clear();
+        return false;
+    }
+
+    bindRoutes();
+
+    DEBUG("Model loaded from its image - " + to_string(states.size())      + " state(s), "
+                                           + to_string(transitions.size()) + " transition(s), "
+                                           + to_string(messages.size())    + " message(s).");
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ModelDefinition::check() const
+{
+    // Every string is terminated
+    auto l_string = [this](uint32_t p_offset) { return p_offset < strings.size(); };
+    if(!strings.empty() && strings[strings.size() - 1] != '\0')
+    {
+        return false;
+    }
+
+    // Layout of the runtime block (Cf. compile)
+    uint32_t l_counters = watches_offset - counters_offset;
+    if(values_offset   != (transitions.size() + 31) / 32          ||
+       versions_offset != values_offset   + variables_count       ||
+       counters_offset != versions_offset + variables_count       ||
+       watches_offset  <  counters_offset                         ||
+       randoms_offset  != watches_offset  + watches.size()        ||
+       block.size()    <  randoms_offset                          ||
+       (block.size() - randoms_offset) % RandomGenerator::STATE_WORDS != 0 ||
+       variables.size() != variables_count                        ||
+       (states.empty() ? start != 0 : start >= states.size()))
+    {
+        return false;
+    }
+
+    for(auto& l_var: variables)
+    {
+        if(!l_string(l_var)) { return false; }
+    }
+
+    for(auto& l_state: states)
+    {
+        if(!l_string(l_state.name)                                                 ||
+           l_state.op_begin    > l_state.op_end    || l_state.op_end    > operations.size()  ||
+           l_state.mesg_begin  > l_state.mesg_end  || l_state.mesg_end  > sends.size()       ||
+           l_state.trans_begin > l_state.trans_end || l_state.trans_end > transitions.size() ||
+           l_state.watch_begin > l_state.watch_end || l_state.watch_end > watches.size())
+        {
+            return false;
+        }
+    }
+
+    for(auto& l_op: operations)
+    {
+        if(l_op.var >= variables_count || l_op.kind > OPER_RESET) { return false; }
+    }
+
+    for(auto& l_trans: transitions)
+    {
+        uint32_t l_slots = (l_trans.kind == TRANS_LOOP) ? l_counters : variables_count;
+        if(l_trans.kind > TRANS_EQUAL || l_trans.dest >= states.size() ||
+           (l_trans.kind != TRANS_ALWAYS && l_trans.slot >= l_slots))
+        {
+            return false;
+        }
+    }
+
+    for(auto& l_send: sends)
+    {
+        if(l_send >= messages.size()) { return false; }
+    }
+
+    for(auto& l_mesg: messages)
+    {
+        if(!l_string(l_mesg.name)                                                       ||
+           l_mesg.frame > frames.size() || l_mesg.size > frames.size() - l_mesg.frame   ||
+           l_mesg.header_size > l_mesg.size                                             ||
+           l_mesg.field_begin > l_mesg.field_end || l_mesg.field_end > fields.size()    ||
+           l_mesg.route >= route_records.size()                                         ||
+           (l_mesg.random != NO_RANDOM && (l_mesg.random < randoms_offset ||
+                                           uint64_t(l_mesg.random) + RandomGenerator::STATE_WORDS > block.size())))
+        {
+            return false;
+        }
+
+        // The dynamic fields are written in the message
+        for(uint32_t i = l_mesg.field_begin; i < l_mesg.field_end; i++)
+        {
+            const FieldLayout& l_layout = fields[i].layout;
+            if(l_layout.offset > l_mesg.size || l_layout.bytes > l_mesg.size - l_layout.offset)
+            {
+                return false;
+            }
+        }
+    }
+
+    for(auto& l_route: route_records)
+    {
+        if(!l_string(l_route.src_ip) || !l_string(l_route.dst_ip) || !l_string(l_route.interface))
+        {
+            return false;
+        }
+    }
+
+    for(auto& l_watch: watches)
+    {
+        if(l_watch.var >= variables_count ||
+           l_watch.dep_begin > l_watch.dep_end || l_watch.dep_end > dependents.size())
+        {
+            return false;
+        }
+    }
+
+    for(auto& l_dep: dependents)
+    {
+        if(l_dep >= transitions.size()) { return false; }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t ModelDefinition::addString(vector<char>& p_strings, const string& p_string)
+{
+    uint32_t l_offset = static_cast<uint32_t>(p_strings.size());
+    p_strings.insert(p_strings.end(), p_string.begin(), p_string.end());
+    p_strings.push_back('\0');
+    return l_offset;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelDefinition::bindRoutes()
+{
+    routes.clear();
+    for(auto& l_record: route_records)
+    {
+        Route l_route;
+        l_route.src_ip    = strings.data() + l_record.src_ip;
+        l_route.dst_ip    = strings.data() + l_record.dst_ip;
+        l_route.interface = strings.data() + l_record.interface;
+        l_route.src_port  = l_record.src_port;
+        l_route.dst_port  = l_record.dst_port;
+        routes.push_back(l_route);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelDefinition::clear()
+{
+    states.clear();
+    operations.clear();
+    transitions.clear();
+    sends.clear();
+    messages.clear();
+    fields.clear();
+    route_records.clear();
+    frames.clear();
+    strings.clear();
+    variables.clear();
+    routes.clear();
+    watches.clear();
+    dependents.clear();
+    block.clear();
+
+    start           = 0;
+    variables_count = 0;
+    values_offset   = 0;
+    versions_offset = 0;
+    counters_offset = 0;
+    watches_offset  = 0;
+    randoms_offset  = 0;
+
+    // The views are dropped before the image
+    image.reset();
+}
+
+} // namespace ModGen
@@ -0,0 +1,516 @@
+/*!
+ * @file   ModelDefinition.h
+ * @brief  Contains the immutable part of a compiled model,
+ *         shared by all the instances of the model.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef MODELDEFINITION_MODELGENERATOR
+#define MODELDEFINITION_MODELGENERATOR
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Field.h"
+#include "SymbolTable.h"
+
+namespace ModGen {
+
+class ModelInstance;
+class ModelCache;
+
+/*!
+ * \brief The Records class is a read-only array of records of a definition:
+ *        either owned (compiled) or viewed in place in a mapped image.
+ */
+template<typename T>
+class Records
+{
+public:
+    Records() : owned(), items(nullptr), count(0) {}
+
+    // The views point to the owned records
+    Records(const Records&)            = delete;
+    Records& operator=(const Records&) = delete;
+
+    /*!
+     * \brief assign takes the ownership of compiled records.
+     */
+    void assign(std::vector<T>&& p_records) { owned = std::move(p_records); items = owned.data(); count = owned.size(); }
+
+    /*!
+     * \brief view points to records owned by someone else (Cf. ModelCache).
+     */
+    void view(const T* p_items, std::size_t p_count) { owned.clear(); items = p_items; count = p_count; }
+
+    /*!
+     * \brief clear drops the records.
+     */
+    void clear() { owned.clear(); items = nullptr; count = 0; }
+
+    const T&    operator[](std::size_t p_index) const { return items[p_index]; }
+    const T*    data()  const { return items;          }
+    const T*    begin() const { return items;          }
+    const T*    end()   const { return items + count;  }
+    std::size_t size()  const { return count;          }
+    bool        empty() const { return count == 0;     }
+
+private:
+    std::vector<T> owned; /*!< The compiled records (empty for a view) */
+    const T*       items; /*!< The records                             */
+    std::size_t    count; /*!< Number of records                       */
+};
+
+/*!
+ * \brief The ModelDefinition class is the finite state machine of a
+ *        \a ModelInstance lowered to dense arrays (Cf. compile).
+ *
+ *        The states, operations, transitions and variables are referenced
+ *        by their ID (Cf. ModelInstance::ModelSymbols): running a state is a loop over contiguous records,
+ *        without any map lookup, virtual call or null pointer check.
+ *
+ *        The messages are lowered to their frame templates, the dynamic fields
+ *        of their headers and their routes: the definition does not reference
+ *        the elements of the model, which can be reloaded or freed.
+ *
+ *        The definition is never changed once compiled: it is shared (read only)
+ *        by any number of instances, run by any number of threads (Cf. CompiledModel).
+ *        It also gives the layout of the runtime state of an instance - a block of
+ *        words holding the cached conditions, the variables, the loop counters,
+ *        the versions of the variables read by the states and the generators of
+ *        the DATA parts of the messages - and its initial image: a new instance
+ *        is a copy of that image.
+ *
+ *        The records are plain data referencing each other by index: they are
+ *        saved as they are in a binary image, which is mapped and used in place
+ *        instead of compiling the model again (Cf. save, load).
+ */
+class ModelDefinition
+{
+public:
+    /*!
+     * Enumerate of the kinds of compiled transitions.
+     */
+    typedef enum {
+        TRANS_ALWAYS = 0, /*!< Always made (delay or default condition) */
+        TRANS_LOOP   = 1, /*!< Made until the loop counter reaches value */
+        TRANS_OVER   = 2, /*!< Made if variable > value                  */
+        TRANS_UNDER  = 3, /*!< Made if variable < value                  */
+        TRANS_EQUAL  = 4  /*!< Made if variable == value                 */
+    } TRANSITION_KIND;
+
+    /*!
+     * Enumerate of the compiled operations on the variables.
+     */
+    typedef enum {
+        OPER_ADD    = 0, /*!< variable += value                         */
+        OPER_SUB    = 1, /*!< variable -= value                         */
+        OPER_ASSIGN = 2, /*!< variable  = value                         */
+        OPER_RESET  = 3  /*!< variable  = 0 (deleted variables)         */
+    } OPERATION_KIND;
+
+    /*!
+     * Enumerate of the flags of the compiled states.
+     */
+    typedef enum {
+        STATE_WAIT    = 1, /*!< Parked while its conditions are false    */
+        STATE_RESEND  = 2, /*!< Messages sent again when it is resumed   */
+        STATE_INDEXED = 4  /*!< Conditions cached (Cf. CompiledWatch)    */
+    } STATE_FLAG;
+
+    /*!
+     * Enumerate of the flags of the compiled fields.
+     */
+    typedef enum {
+        FIELD_BIG_ENDIAN = 1, /*!< Sent big endian (Cf. FieldHelper::toBits) */
+        FIELD_SWAP       = 2, /*!< 16-bits words swapped                      */
+        FIELD_INVERT     = 4  /*!< Sent LSB first                             */
+    } FIELD_FLAG;
+
+    static const uint32_t INDEXED_CONDITIONS = 8; /*!< Conditions of a state from which they are cached
+                                                       (if there are two per variable read at least)  */
+    static const uint32_t NO_RANDOM = UINT32_MAX; /*!< The DATA part of a message is zeros (no generator) */
+
+    /*!
+     * \brief The CompiledState struct holds the ranges of the
+     *        records of a state (begin included, end excluded).
+     */
+    struct CompiledState
+    {
+        uint32_t name;        /*!< Name ID of the state (in strings)     */
+        uint32_t op_begin;    /*!< First operation of the state          */
+        uint32_t op_end;      /*!< End of the operations                 */
+        uint32_t mesg_begin;  /*!< First message sent (in sends)         */
+        uint32_t mesg_end;    /*!< End of the messages sent              */
+        uint32_t trans_begin; /*!< First transition of the state         */
+        uint32_t trans_end;   /*!< End of the transitions                */
+        uint32_t watch_begin; /*!< First variable read by the state      */
+        uint32_t watch_end;   /*!< End of the variables read             */
+        uint32_t flags;       /*!< STATE_FLAG(s)                         */
+        uint64_t timeout;     /*!< Maximum park (us), 0 for no limit     */
+    };
+
+    /*!
+     * \brief The CompiledWatch struct is a variable read by the conditions
+     *        of a state, with the range of these conditions (in \a dependents).
+     *        The version of the variable when they were last evaluated is
+     *        in the runtime block of the instances (Cf. getWatchesOffset).
+     */
+    struct CompiledWatch
+    {
+        uint32_t var;       /*!< Index of the variable                        */
+        uint32_t dep_begin; /*!< First condition reading the variable         */
+        uint32_t dep_end;   /*!< End of the conditions                        */
+    };
+
+    /*!
+     * \brief The CompiledOperation struct is an operation on a variable.
+     */
+    struct CompiledOperation
+    {
+        uint32_t var;   /*!< Index of the operated variable   */
+        int32_t  value; /*!< Value of the operation           */
+        uint32_t kind;  /*!< OPERATION_KIND                   */
+    };
+
+    /*!
+     * \brief The CompiledTransition struct is a transition tagged by its kind.
+     */
+    struct CompiledTransition
+    {
+        uint32_t kind;  /*!< TRANSITION_KIND                                   */
+        uint32_t dest;  /*!< Index of the destination state                    */
+        uint32_t slot;  /*!< Index of the variable (or of the loop counter)    */
+        int32_t  value; /*!< Tested value (or number of times to loop)         */
+        uint64_t delay; /*!< Delay (us) to wait when the transition is made    */
+    };
+
+    /*!
+     * \brief The CompiledMessage struct is a message lowered to its frame
+     *        template: only its dynamic fields and its DATA part are encoded
+     *        on every emission. A message sent by several states is compiled once.
+     */
+    struct CompiledMessage
+    {
+        uint32_t name;        /*!< ID of the message (in strings)                              */
+        uint32_t frame;       /*!< First byte of its frame template (in frames)                */
+        uint32_t size;        /*!< Size (bytes) of the encoded message                         */
+        uint32_t header_size; /*!< Size (bytes) of the header part                             */
+        uint32_t random;      /*!< First word of its generator in the block (or NO_RANDOM)     */
+        uint32_t field_begin; /*!< First dynamic field of the message                          */
+        uint32_t field_end;   /*!< End of the dynamic fields                                   */
+        uint32_t route;       /*!< Index of its route                                          */
+    };
+
+    /*!
+     * \brief The CompiledField struct is a dynamic field of a header
+     *        (a timestamp, Cf. Field_time) with its bit-packing plan.
+     */
+    struct CompiledField
+    {
+        FieldLayout layout;   /*!< Bit-packing plan of the field (Cf. Field::compile) */
+        uint32_t    size;     /*!< Size (bits) of the field                          */
+        uint32_t    format;   /*!< Format of the timestamp (Field_time::TIME_FORMAT) */
+        uint32_t    flags;    /*!< FIELD_FLAG(s)                                     */
+    };
+
+    /*!
+     * \brief The CompiledRoute struct is the addressing of messages
+     *        (the addresses and the interface are in strings).
+     */
+    struct CompiledRoute
+    {
+        uint32_t src_ip;      /*!< Source IP address                 */
+        uint32_t dst_ip;      /*!< Destination IP address            */
+        uint32_t interface;   /*!< Network interface                 */
+        uint32_t src_port;    /*!< Source port                       */
+        uint32_t dst_port;    /*!< Destination port                  */
+    };
+
+    /*!
+     * \brief The Route struct is the addressing of messages, as used by the
+     *        senders (Cf. UdpSender). The routes of a definition are unique:
+     *        they can be compared by address.
+     */
+    struct Route
+    {
+        const char* src_ip;    /*!< Source IP address                 */
+        const char* dst_ip;    /*!< Destination IP address            */
+        const char* interface; /*!< Network interface (empty if none) */
+        uint32_t    src_port;  /*!< Source port                       */
+        uint32_t    dst_port;  /*!< Destination port                  */
+    };
+
+    /*!
+     * \brief ModelDefinition default constructor (no state)
+     */
+    ModelDefinition();
+
+    // The routes point to the strings of the definition
+    ModelDefinition(const ModelDefinition&)            = delete;
+    ModelDefinition& operator=(const ModelDefinition&) = delete;
+
+    /*!
+     * \brief compile lowers the object graph of a model to the arrays.
+     *        The model must have passed its integrity checks. Nothing of the
+     *        model is referenced once compiled.
+     * \param p_model the model to compile.
+     */
+    void compile(ModelInstance& p_model);
+
+    /*!
+     * \brief save adds the records to a binary image (Cf. ModelCache::save).
+     * \param p_cache the image being built.
+     */
+    void save(ModelCache& p_cache) const;
+
+    /*!
+     * \brief load points the records to a mapped image, used in place (kept mapped
+     *        as long as the definition is). Every index of the records is checked.
+     * \param p_image the image (opened, Cf. ModelCache::open).
+     * \return false if the image does not hold a valid definition.
+     */
+    bool load(std::shared_ptr<const ModelCache> p_image);
+
+    /*!
+     * \brief clear drops every compiled record.
+     */
+    void clear();
+
+    /*!
+     * \brief getStateName
+     * \param p_state the index of a state.
+     * \return the name of the state.
+     */
+    std::string_view getStateName(uint32_t p_state) const { return strings.data() + states[p_state].name; }
+
+    /*!
+     * \brief getVariableName
+     * \param p_var the ID of a variable.
+     * \return the name of the variable.
+     */
+    std::string_view getVariableName(uint32_t p_var) const { return strings.data() + variables[p_var]; }
+
+    /*!
+     * \brief getMessageName
+     * \param p_mesg the index of a message.
+     * \return the ID of the message.
+     */
+    std::string_view getMessageName(uint32_t p_mesg) const { return strings.data() + messages[p_mesg].name; }
+
+    /*!
+     * \brief getMessagesCount
+     * \param p_state the index of a state.
+     * \return the number of messages sent by the state.
+     */
+    std::size_t getMessagesCount(uint32_t p_state) const { return states[p_state].mesg_end - states[p_state].mesg_begin; }
+
+    /*!
+     * \brief getMessage
+     * \param p_state the index of a state.
+     * \param p_index the index of a message of the state (Cf. getMessagesCount).
+     * \return the index of the message.
+     */
+    uint32_t getMessage(uint32_t p_state, std::size_t p_index) const { return sends[states[p_state].mesg_begin + p_index]; }
+
+    /*!
+     * \brief getMessageSize
+     * \param p_mesg the index of a message.
+     * \return the size (bytes) of the encoded message.
+     */
+    uint32_t getMessageSize(uint32_t p_mesg) const { return messages[p_mesg].size; }
+
+    /*!
+     * \brief getRoute
+     * \param p_mesg the index of a message.
+     * \return the addressing of the message.
+     */
+    const Route& getRoute(uint32_t p_mesg) const { return routes[messages[p_mesg].route]; }
+
+    /*!
+     * \brief getRoutes
+     * \return the routes of the messages (Cf. getRoutesCount).
+     */
+    const Route* getRoutes() const { return routes.data(); }
+
+    /*!
+     * \brief getRoutesCount
+     * \return the number of distinct routes of the messages.
+     */
+    std::size_t getRoutesCount() const { return routes.size(); }
+
+    /*!
+     * \brief encode writes a message into a caller-owned buffer: its frame
+     *        template, its DATA part and its dynamic fields. The definition is not
+     *        changed: the generator of the DATA part is in the runtime block of the
+     *        instance encoding the message (Cf. CompiledModel::encodeMessage).
+     * \param p_mesg the index of the message.
+     * \param p_buffer the buffer to write the message to.
+     * \param p_capacity the size (bytes) of the buffer.
+     * \param p_block the runtime block of the instance.
+     * \return the number of bytes written (Cf. getMessageSize).
+     * \throw Exception::BufferOverflow if the buffer is too small.
+     */
+    uint32_t encode(uint32_t p_mesg, uint8_t* p_buffer, std::size_t p_capacity, uint32_t* p_block) const;
+
+    /*!
+     * \brief getMessagesTotal
+     * \return the number of compiled messages (Cf. getRandomOffset).
+     */
+    std::size_t getMessagesTotal() const { return messages.size(); }
+
+    /*!
+     * \brief getRandomOffset
+     * \param p_mesg the index of a message.
+     * \return the first word of the generator of the DATA part of
+     *         the message in the block, NO_RANDOM if it has none.
+     */
+    uint32_t getRandomOffset(uint32_t p_mesg) const { return messages[p_mesg].random; }
+
+    /*!
+     * \brief isIndexed
+     * \param p_state the index of a state.
+     * \return true if the conditions of the state are cached (Cf. STATE_INDEXED).
+     */
+    bool isIndexed(uint32_t p_state) const { return states[p_state].flags & STATE_INDEXED; }
+
+    /*!
+     * \brief getStatesCount
+     * \return the number of compiled states.
+     */
+    std::size_t getStatesCount() const { return states.size(); }
+
+    /*!
+     * \brief getTransitionsCount
+     * \return the number of compiled transitions.
+     */
+    std::size_t getTransitionsCount() const { return transitions.size(); }
+
+    /*!
+     * \brief getVariablesCount
+     * \return the number of variables of the model.
+     */
+    std::size_t getVariablesCount() const { return variables_count; }
+
+    /*!
+     * \brief getStart
+     * \return the index of the start state.
+     */
+    uint32_t getStart() const { return start; }
+
+    /*!
+     * \brief getBlock
+     * \return the initial image of the runtime block of an instance
+     *         (Cf. getBlockSize).
+     */
+    const uint32_t* getBlock() const { return block.data(); }
+
+    /*!
+     * \brief getBlockSize
+     * \return the number of words of the runtime block of an instance.
+     */
+    std::size_t getBlockSize() const { return block.size(); }
+
+    /*!
+     * \brief getValuesOffset
+     * \return the first word of the values of the variables, by ID
+     *         (the cached conditions come first, one bit per transition).
+     */
+    uint32_t getValuesOffset() const { return values_offset; }
+
+    /*!
+     * \brief getVersionsOffset
+     * \return the first word of the versions of the variables, by ID.
+     */
+    uint32_t getVersionsOffset() const { return versions_offset; }
+
+    /*!
+     * \brief getCountersOffset
+     * \return the first word of the counters of the loop transitions.
+     */
+    uint32_t getCountersOffset() const { return counters_offset; }
+
+    /*!
+     * \brief getWatchesOffset
+     * \return the first word of the versions of the variables read
+     *         by the states, by watch (Cf. CompiledWatch).
+     */
+    uint32_t getWatchesOffset() const { return watches_offset; }
+
+    /*!
+     * \brief getRandomsOffset
+     * \return the first word of the generators of the DATA parts of the messages
+     *         (RandomGenerator::STATE_WORDS per message filled with random values).
+     */
+    uint32_t getRandomsOffset() const { return randoms_offset; }
+
+private:
+    /*!
+     * NB : The instances run the records.
+     */
+    friend class CompiledModel;
+
+    /*!
+     * Enumerate of the words of the LAYOUT section of an image.
+     */
+    typedef enum {
+        LAYOUT_START     = 0, /*!< start           */
+        LAYOUT_VARIABLES = 1, /*!< variables_count */
+        LAYOUT_VALUES    = 2, /*!< values_offset   */
+        LAYOUT_VERSIONS  = 3, /*!< versions_offset */
+        LAYOUT_COUNTERS  = 4, /*!< counters_offset */
+        LAYOUT_WATCHES   = 5, /*!< watches_offset  */
+        LAYOUT_RANDOMS   = 6, /*!< randoms_offset  */
+        LAYOUT_WORDS     = 7  /*!< Number of words */
+    } LAYOUT;
+
+    /*!
+     * \brief addString copies a string (null-terminated) into a pool of strings.
+     * \return the offset of the string.
+     */
+    static uint32_t addString(std::vector<char>& p_strings, const std::string& p_string);
+
+    /*!
+     * \brief check verifies that every index of the records is in range
+     *        (the records of an image are not trusted).
+     * \return false if a record references something out of range.
+     */
+    bool check() const;
+
+    /*!
+     * \brief bindRoutes points the routes to their strings.
+     */
+    void bindRoutes();
+
+    Records<CompiledState>          states;          /*!< States, by index                       */
+    Records<CompiledOperation>      operations;      /*!< Operations of every state              */
+    Records<CompiledTransition>     transitions;     /*!< Transitions of every state             */
+    Records<uint32_t>               sends;           /*!< Messages sent by every state           */
+    Records<CompiledMessage>        messages;        /*!< Messages, by index                     */
+    Records<CompiledField>          fields;          /*!< Dynamic fields of every message        */
+    Records<CompiledRoute>          route_records;   /*!< Addressing of the messages             */
+    Records<uint8_t>                frames;          /*!< Frame templates of every message       */
+    Records<char>                   strings;         /*!< Names, addresses and interfaces        */
+    Records<uint32_t>               variables;       /*!< Names of the variables, by ID          */
+    std::vector<Route>              routes;          /*!< Routes (pointing to strings)           */
+    Records<CompiledWatch>          watches;         /*!< Variables read by every state          */
+    Records<uint32_t>               dependents;      /*!< Conditions reading every watch         */
+    Records<uint32_t>               block;           /*!< Initial runtime block of an instance   */
+    uint32_t                        start;           /*!< Index of the start state               */
+    uint32_t                        variables_count; /*!< Number of variables                    */
+    uint32_t                        values_offset;   /*!< Values of the variables (block)        */
+    uint32_t                        versions_offset; /*!< Versions of the variables (block)      */
+    uint32_t                        counters_offset; /*!< Loop counters (block)                  */
+    uint32_t                        watches_offset;  /*!< Versions of the watches (block)        */
+    uint32_t                        randoms_offset;  /*!< Generators of the messages (block)     */
+    std::shared_ptr<const ModelCache>
+                                    image;           /*!< Image holding the records (if loaded)  */
+};
+
+} // namespace ModGen
+
+#endif // MODELDEFINITION_MODELGENERATOR
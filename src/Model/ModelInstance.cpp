@@ -0,0 +1,555 @@
+/*!
+ * @file   ModelInstance.cpp
+ * @brief  Implementations of the functions defined in \a ModelInstance.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <errno.h>
+#include <chrono>
+#include <limits>
+
+#include "Logger.h"
+#include "ModelInstance.h"
+#include "Model.h"
+#include "Exception.h"
+#include "Conf_format.h"
+#include "Message.h"
+#include "Header.h"
+#include "State.h"
+#include "Field.h"
+#include "ConfLoader.h"
+#include "ModelCache.h"
+
+namespace ModGen {
+
+using namespace std;
+
+map<ModelInstance::MODELSTATE, string> ModelInstance::stateString = {
+    {ModelInstance::NOT_INITIALIZED, "Model not initialized"},
+    {ModelInstance::INITIALIZED,     "Model initialized"    },
+    {ModelInstance::RUNNING,         "Model running"        },
+    {ModelInstance::STOPPED,         "Model stopped"        }
+};
+
+////////////////////////////////////////////////////////////////////////
+ModelInstance::ModelInstance() :
+    confFile(nullptr),
+    cacheFile(),
+    curState(nullptr),
+    nexState(nullptr),
+    resumed(false),
+    loaded(true),
+    currentStateStr(NOT_INITIALIZED),
+    elements(new ModelElements()),
+    modelVar(),
+    loops(),
+    scheduler(),
+    definition(),
+    compiled(),
+    setupTimes()
+{}
+
+////////////////////////////////////////////////////////////////////////
+ModelInstance::~ModelInstance()
+{
+    if(confFile)
+    {
+        delete confFile;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+State* ModelInstance::getNextState()
+{
+    loadElements();
+    if(!nexState)
+    {
+        ERROR("Error - Unable to run the model - no valid state found.");
+        throw Exception::IntegrityCheckException<ModelInstance>("Unable to run the model - no valid state found.");
+    }
+
+    return nexState;
+}
+
+////////////////////////////////////////////////////////////////////////
+State* ModelInstance::getCurrState()
+{
+    loadElements();
+    if(!curState)
+    {
+        ERROR("Error - Unable to run the model - no valid state found.");
+        throw Exception::IntegrityCheckException<ModelInstance>("Unable to run the model - no valid state found.");
+    }
+
+    return curState;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ModelInstance::isSent()
+{
+    return !resumed || getCurrState()->isResent();
+}
+
+////////////////////////////////////////////////////////////////////////
+const string& ModelInstance::getStateString()
+{
+    return stateString.at(currentStateStr);
+}
+
+////////////////////////////////////////////////////////////////////////
+ModelInstance::ModelVar& ModelInstance::getVariables()
+{
+    return modelVar;
+}
+
+////////////////////////////////////////////////////////////////////////
+const ModelInstance::ModelMesg& ModelInstance::getMessages()
+{
+    loadElements();
+    return elements->modelMes;
+}
+
+////////////////////////////////////////////////////////////////////////
+const ModelInstance::ModelHead& ModelInstance::getHeaders()
+{
+    loadElements();
+    return elements->modelHead;
+}
+
+////////////////////////////////////////////////////////////////////////
+const ModelInstance::ModelState& ModelInstance::getStates()
+{
+    loadElements();
+    return elements->modelState;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelInstance::log()
+{
+    string l_return = "\n\t\t------ VARIABLES ------\n";
+    for(size_t i = 0; i < modelVar.size(); i++)
+    {
+        l_return += elements->symbols.variables.getName(i) + " " + to_string(modelVar.get(i));
+    }
+
+    // Set up from its image: the compiled states are logged (the elements are not loaded for it)
+    if(!loaded)
+    {
+        l_return += "\n\t\t------ STATES ------\n";
+        for(uint32_t i = 0; i < definition->getStatesCount(); i++)
+        {
+            l_return += string(definition->getStateName(i)) + " :";
+            for(size_t j = 0; j < definition->getMessagesCount(i); j++)
+            {
+                l_return += " " + string(definition->getMessageName(definition->getMessage(i, j)));
+            }
+            l_return += "\n";
+        }
+
+        INFO(l_return);
+        return;
+    }
+    l_return += "\n\t\t------ MESSAGES ------\n";
+
+    for(auto& t : getMessages() )
+    {
+        l_return += t.getDesc();
+    }
+    l_return += "\n\t\t------ HEADERS ------\n";
+
+    for(auto& t : getHeaders() )
+    {
+        l_return += t.getDesc();
+    }
+
+    l_return += "\n\t\t------ STATES ------\n";
+    for(auto& t : getStates() )
+    {
+        l_return += t.getDesc();
+    }
+
+    INFO(l_return);
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelInstance::addVariable(const string& p_name, int p_val)
+{
+    SymbolTable::ID l_id = elements->symbols.variables.intern(p_name);
+    if(!loaded && l_id >= modelVar.size())
+    {
+        // The variables of a model set up from its image are already built
+        ERROR("Error - The variable " + p_name + " is not in the image of the model.");
+        throw Exception::IntegrityCheckException<ModelInstance>("The variable " + p_name + " is not in the image of the model.");
+    }
+    else if(l_id == modelVar.size())
+    {
+        modelVar.add(p_val);
+    }
+    else
+    {
+        modelVar.setInitial(l_id, p_val);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelInstance::operateVariable(const string&    p_name,
+                            const OPERATION& p_operation,
+                            int              p_value)
+{
+    SymbolTable::ID l_id = elements->symbols.variables.find(p_name);
+    if(l_id == SymbolTable::NONE)
+    {
+        ERROR("Error - Trying to operate undefined model variable (" + p_name + ").");
+        throw Exception::ParsingFileError("Trying to operate undefined model variable (" + p_name + ").");
+    }
+
+    // The variables are referenced by ID: a deleted variable is reset
+    switch(p_operation)
+    {
+        case ADD: modelVar.add(l_id,  p_value); break;
+        case SUB: modelVar.add(l_id, -p_value); break;
+        case DEL: modelVar.set(l_id,  0);       break;
+        //default:
+        //    throw Exception::UnimplementedElement<OPERATION>(p_operation);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelInstance::checkIntegrity()
+{
+    // The references are resolved by ID (one lookup in the table per
+    // name): the checks stay linear in the number of transitions
+    uint32_t l_loops = 0;
+    for(SymbolTable::ID i = 0; i < elements->modelState.size(); i++)
+    {
+        State& l_state = elements->modelState[i];
+        l_state.setIndex(i);
+
+        // Parcourt toutes les transitions de l'état
+        // pour mettre à jour l'état de destination
+        for(auto& l_transitions: l_state.getTransitions())
+        {
+            // The loops were bound to their state by the loader
+            auto& l_destStateName = l_transitions->getDestStateName();
+            if(l_transitions->getDestState() && l_transitions->getDestState()->getId() == l_destStateName)
+            {
+                continue;
+            }
+
+            auto l_dest = elements->symbols.states.find(l_destStateName);
+            if(l_dest == SymbolTable::NONE)
+            {
+                ERROR("Error - Model error - Integrity check failed.");
+                throw Exception::IntegrityCheckException<Transition>(l_destStateName);
+            }
+            l_transitions->setDestState(&elements->modelState[l_dest], l_dest);
+        }
+
+        // Resolves the variables of the operations and the messages
+        // of the state (referenced by name when the file was loaded)
+        for(auto& l_operation: l_state.getOperations())
+        {
+            auto l_var = elements->symbols.variables.find(l_operation.getVar());
+            if(l_var == SymbolTable::NONE)
+            {
+                ERROR("Error - Model error - Integrity check failed.");
+                throw Exception::UnimplementedElement<Variables_format>(l_operation.getVar());
+            }
+            l_operation.setVariable(l_var, modelVar);
+        }
+
+        for(auto& l_messageName: l_state.getMessageNames())
+        {
+            auto l_message = elements->symbols.messages.find(l_messageName);
+            if(l_message == SymbolTable::NONE)
+            {
+                ERROR("Error - Model error - Integrity check failed.");
+                throw Exception::UnimplementedElement<StateMessage_format>(l_messageName);
+            }
+            l_state.addMessage(&elements->modelMes[l_message]);
+        }
+
+        // Parcourt toutes les transitions de l'état
+        // pour mettre à jour la variable sur laquelle elles opèrent
+        for(auto& l_transitions: l_state.getTransitions())
+        {
+            auto  l_varName = l_transitions->getVar();
+            if(l_varName.empty())
+            {
+                continue;
+            }
+
+            auto l_var = elements->symbols.variables.find(l_varName);
+            if(l_var == SymbolTable::NONE)
+            {
+                ERROR("Error - Model error - Integrity check failed.");
+                throw Exception::IntegrityCheckException<Transition>(l_varName);
+            }
+            l_transitions->setVar(l_var, modelVar);
+        }
+
+        // The counters of the loops are kept by the model (Cf. getLoopCounter)
+        for(auto& l_transitions: l_state.getTransitions())
+        {
+            if(auto l_loop = dynamic_cast<LoopTransition*>(l_transitions))
+            {
+                l_loop->setCounter(l_loops++);
+            }
+        }
+
+        // A waiting state is only woken up by the variables it tests
+        if(l_state.isWaiting())
+        {
+            for(auto& l_transitions: l_state.getTransitions())
+            {
+                auto l_condition = dynamic_cast<VarConditionTransition*>(l_transitions);
+                if(!l_condition || l_condition->isDefault())
+                {
+                    ERROR("Error - The waiting State which ID's " + l_state.getId() + " has a Transition which does not test a variable.");
+                    throw Exception::IntegrityCheckException<State>(l_state.getId());
+                }
+            }
+        }
+    }
+
+    // Compile la disposition des champs de chaque Header
+    for(auto& l_headers: elements->modelHead )
+    {
+        l_headers.compile();
+    }
+
+    // Parcourt tous les messages du modèle
+    // pour mettre à jour le Header qu'ils référencent
+    for(auto& l_messages: elements->modelMes )
+    {
+        auto& l_messageHeaderName = l_messages.getHeaderName();
+        auto  l_header            = elements->symbols.headers.find(l_messageHeaderName);
+        if(l_header == SymbolTable::NONE)
+        {
+            ERROR("Error - Model error - Integrity check failed.");
+            throw Exception::IntegrityCheckException<Message>(l_messageHeaderName);
+        }
+        l_messages.setHeader(&elements->modelHead[l_header]);
+        l_messages.compile();
+    }
+    loops.assign(l_loops, 0);
+
+    DEBUG("Model Integrity successfully checked.");
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelInstance::clear()
+{
+    if(curState)
+    {
+        curState = nullptr;
+    }
+
+    if(nexState)
+    {
+        nexState = nullptr;
+    }
+    resumed = false;
+    loaded  = true;
+
+    modelVar.clear();
+    loops.clear();
+    scheduler.reset();
+    compiled.clear();
+    definition.reset();
+
+    // The definitions compiled from the elements do not reference them
+    elements.reset(new ModelElements());
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ModelInstance::internImage()
+{
+    // The IDs are those of the model compiled (order of the first intern)
+    for(uint32_t i = 0; i < definition->getVariablesCount(); i++)
+    {
+        if(elements->symbols.variables.intern(definition->getVariableName(i)) != i)
+        {
+            return false;
+        }
+    }
+    for(uint32_t i = 0; i < definition->getStatesCount(); i++)
+    {
+        if(elements->symbols.states.intern(definition->getStateName(i)) != i)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelInstance::loadElements()
+{
+    if(loaded)
+    {
+        return;
+    }
+
+    DEBUG("Loading the elements of the model from " + *confFile);
+    try
+    {
+        // The variables and states are already known: they keep their IDs
+        ConfLoader(*this).loadFile(*confFile);
+        checkIntegrity();
+
+        bool l_same = (elements->modelState.size() == definition->getStatesCount());
+        for(uint32_t i = 0; l_same && i < definition->getStatesCount(); i++)
+        {
+            l_same = (elements->modelState[i].getId() == definition->getStateName(i));
+        }
+        if(!l_same)
+        {
+            ERROR("Error - The configuration file " + *confFile + " changed since the model was set up from its image.");
+            throw Exception::IntegrityCheckException<ModelInstance>("The configuration file " + *confFile + " changed since the model was set up from its image.");
+        }
+    }
+    catch(...)
+    {
+        // Loaded again on the next use
+        curState = nullptr;
+        nexState = nullptr;
+        elements.reset(new ModelElements());
+        internImage();
+        throw;
+    }
+
+    loaded = true;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t ModelInstance::getMessageSize(size_t p_index)
+{
+    // The state checks the index (and reports it)
+    getCurrState()->getMessage(p_index);
+    return definition->getMessageSize(definition->getMessage(getCurrState()->getIndex(), p_index));
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t ModelInstance::encodeMessage(size_t p_index, uint8_t* p_buffer, size_t p_capacity)
+{
+    // The state checks the index (and reports it)
+    getCurrState()->getMessage(p_index);
+    return compiled.encodeMessage(getCurrState()->getIndex(), p_index, p_buffer, p_capacity);
+}
+
+////////////////////////////////////////////////////////////////////////
+vector<vector<uint8_t>> ModelInstance::encodeMessages()
+{
+    vector<vector<uint8_t>> l_messages(getCurrState()->getMessagesCount());
+    for(size_t i = 0; i < l_messages.size(); i++)
+    {
+        l_messages[i].resize(getMessageSize(i));
+        encodeMessage(i, l_messages[i].data(), l_messages[i].size());
+    }
+    return l_messages;
+}
+
+////////////////////////////////////////////////////////////////////////
+void ModelInstance::setup(const string& p_filePath, LOADER p_loader)
+{
+    currentStateStr = NOT_INITIALIZED;
+    clear();
+
+    if(confFile)
+    {
+        delete confFile;
+    }
+    confFile = new string(p_filePath);
+
+    if(!confFile)
+    {
+        ERROR("Error - Could not create the required pointer to the configuration file.");
+        throw Exception::ParsingFileError("Could not create the required pointer to the configuration file.");
+    }
+
+    DEBUG("Configuration file set to " + *confFile);
+
+    auto l_start = chrono::steady_clock::now();
+    auto l_since = [&l_start]()
+    {
+        auto l_now = chrono::steady_clock::now();
+        auto l_us  = chrono::duration_cast<chrono::microseconds>(l_now - l_start).count();
+        l_start    = l_now;
+        return static_cast<uint64_t>(l_us);
+    };
+
+    // The compiled model is mapped from its image, used in place
+    auto l_image = make_shared<ModelCache>();
+    if(!cacheFile.empty() && l_image->open(cacheFile, *confFile))
+    {
+        definition = make_shared<ModelDefinition>();
+        loaded     = !definition->load(move(l_image)) || !internImage();
+        if(loaded)
+        {
+            INFO("The model cache " + cacheFile + " is not valid - it will be rebuilt.");
+            definition.reset();
+            elements.reset(new ModelElements());
+        }
+    }
+
+    if(!loaded)
+    {
+        // The variables start with the values of the image
+        for(uint32_t i = 0; i < definition->getVariablesCount(); i++)
+        {
+            modelVar.add(static_cast<int32_t>(definition->getBlock()[definition->getValuesOffset() + i]));
+        }
+        modelVar.reset();
+
+        setupTimes.load_us    = l_since();
+        setupTimes.check_us   = 0;
+        setupTimes.compile_us = 0;
+        DEBUG("Model loaded from the cache " + cacheFile);
+    }
+    else
+    {
+        ConfLoader l_loader(*this);
+        if(p_loader == STREAM_LOADER)
+        {
+            l_loader.loadFile(*confFile);
+        }
+        else
+        {
+            pugi::xml_document	   l_doc;
+            pugi::xml_parse_result l_result = l_doc.load_file(confFile->c_str());
+
+            if (!l_result)
+            {
+                ERROR("Error - Configuration file parsing failed (position " + to_string(l_result.offset) + ").");
+                throw Exception::ParsingFileError(l_result.description(), l_result.offset);
+            }
+
+            l_loader.loadDocument(l_doc);
+        }
+
+        setupTimes.load_us    = l_since();
+        modelVar.reset();           // Every variable is known: their array is built
+        checkIntegrity();           // Controles finaux d'intégrité du modele
+        setupTimes.check_us   = l_since();
+        definition = make_shared<ModelDefinition>();
+        definition->compile(*this); // Mise à plat du modele pour son execution
+        setupTimes.compile_us = l_since();
+
+        // Only a validated model is cached
+        if(!cacheFile.empty())
+        {
+            ModelCache l_cache;
+            definition->save(l_cache);
+            l_cache.save(cacheFile, *confFile);
+        }
+    }
+    compiled.setup(definition, &modelVar);
+
+    currentStateStr = INITIALIZED;
+    DEBUG("Configuration file parsed successfully.");
+}
+
+} // namespace ModGen
\ No newline at end of file
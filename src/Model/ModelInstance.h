@@ -0,0 +1,386 @@
+/*!
+ * @file   ModelInstance.h
+ * @brief  Contains an instance of the finite state machine
+ *         modelling the system.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef MODELINSTANCE_MODELGENERATOR
+#define MODELINSTANCE_MODELGENERATOR
+
+#include <deque>
+#include <includes.h>
+
+#include "Scheduler.h"
+#include "CompiledModel.h"
+#include "ModelDefinition.h"
+#include "ModelArena.h"
+#include "SymbolTable.h"
+#include "VariableStore.h"
+
+namespace ModGen {
+
+class Header;
+class State;
+class Message;
+
+/**
+ * @brief The ModelInstance class owns the data parsed from a configuration
+ *        file and the runtime state of the corresponding finite state
+ *        machine.
+ *        Several instances can be created (and run on separate threads)
+ *        in the same process - one per simulated device.
+ *        NB : The \a Model class is the default instance of the process.
+ */
+class ModelInstance
+{
+
+public:
+    /**
+     * Enumerate describing the possible states of the model.
+     */
+    typedef enum {
+        NOT_INITIALIZED   = 0, /*!< Not initialized                 */
+        INITIALIZED       = 1, /*!< Initialized but not running     */
+        RUNNING           = 2, /*!< Running                         */
+        STOPPED           = 3  /*!< Stopped                         */
+    } MODELSTATE;
+
+    /*!
+     * \brief ModelVar the values of the variables used by the model,
+     *        by variable ID (Cf. ModelSymbols) - shared with the threads
+     *        driving the variables from outside the model.
+     */
+    typedef VariableStore       ModelVar;
+
+    /*!
+     * \brief ModelMesg the messages of the model, by message ID.
+     */
+    typedef std::deque<Message> ModelMesg;
+
+    /*!
+     * \brief ModelHead the headers of the model, by header ID.
+     */
+    typedef std::deque<Header>  ModelHead;
+
+    /*!
+     * \brief ModelState the states of the model, by State ID.
+     */
+    typedef std::deque<State>   ModelState;
+
+    /*!
+     * \brief The ModelSymbols struct holds the IDs of the names of the model:
+     *        the elements are stored and referenced by ID, the names are
+     *        only kept for the diagnostics.
+     *        NB : The containers never move their elements (deque): the
+     *             elements reference each other by address once resolved.
+     */
+    struct ModelSymbols
+    {
+        SymbolTable variables; /*!< IDs of the variables */
+        SymbolTable messages;  /*!< IDs of the messages  */
+        SymbolTable headers;   /*!< IDs of the headers   */
+        SymbolTable states;    /*!< IDs of the states    */
+    };
+
+    /*!
+     * \brief The ModelElements struct owns the elements of the model, which
+     *        reference each other by address. The definitions compiled from
+     *        them do not reference them (Cf. getDefinition).
+     *        NB : The arena is destroyed last (the elements reference its nodes).
+     */
+    struct ModelElements
+    {
+        ModelArena   arena;      /*!< Fields and transitions of the model. */
+        ModelSymbols symbols;    /*!< IDs of the names of the model.       */
+        ModelMesg    modelMes;   /*!< Messages defined in the model.       */
+        ModelHead    modelHead;  /*!< Headers defined in the model.        */
+        ModelState   modelState; /*!< States defined in the model.         */
+    };
+
+    /**
+     * @brief ModelInstance Default constructor
+     */
+    ModelInstance();
+
+    /**
+     * @brief ~ModelInstance Default destructor
+     */
+    ~ModelInstance();
+
+    /**
+     * NB : Not copyable because the states, messages and transitions
+     *      reference each other by address.
+     */
+    ModelInstance(const ModelInstance&)            = delete;
+    ModelInstance& operator=(const ModelInstance&) = delete;
+
+    /*!
+     * \brief getState
+     * \return the current state of the model.
+     */
+    const std::string& getStateString();
+
+    /*!
+     * \brief getVariables
+     * \return the values of the model variables (by ID), which
+     *         can be read and written from any thread.
+     */
+    ModelVar&           getVariables();
+
+    /*!
+     * \brief getMessages
+     * \return the model messages (by ID).
+     */
+    const ModelMesg&    getMessages();
+
+    /*!
+     * \brief getHeaders
+     * \return the model headers (by ID).
+     */
+    const ModelHead&    getHeaders();
+
+    /*!
+     * \brief getStates
+     * \return the model states (by ID).
+     */
+    const ModelState&   getStates();
+
+    /*!
+     * \brief getSymbols
+     * \return the IDs of the names of the model.
+     *         NB : Once set up from its image (Cf. setCache), only the variables
+     *              and the states are known until the elements are loaded.
+     */
+    const ModelSymbols& getSymbols() const { return elements->symbols; }
+
+    /**
+     * @brief log Writes the complete model to the logs
+     *        using the \a Logger (Cf. Logger.h)
+     */
+    void log();
+
+    /**
+     * Enumerate of the loaders of the configuration file.
+     */
+    typedef enum {
+        STREAM_LOADER = 0, /*!< One pass over the file (Cf. ConfReader)  */
+        DOM_LOADER    = 1  /*!< Whole file loaded by pugixml first       */
+    } LOADER;
+
+    /**
+     * @brief setup sets the values of the model if existing
+     * @param p_filePath the path of the configuration file
+     * @param p_loader the loader of the configuration file
+     */
+    void setup(const std::string& p_filePath, LOADER p_loader = STREAM_LOADER);
+
+    /*!
+     * \brief The SetupTimes struct holds the durations of the steps of setup.
+     */
+    typedef struct {
+        uint64_t load_us;    /*!< Configuration file (or image) loaded  */
+        uint64_t check_us;   /*!< References resolved (checkIntegrity) */
+        uint64_t compile_us; /*!< Model compiled (Cf. ModelDefinition)  */
+    } SetupTimes;
+
+    /**
+     * @brief getSetupTimes
+     * @return the durations of the steps of the last setup.
+     */
+    const SetupTimes& getSetupTimes() const { return setupTimes; }
+
+    /**
+     * @brief setCache sets the binary image of the compiled model (Cf. ModelCache),
+     *        mapped by setup instead of loading the configuration file when it
+     *        is up to date - (re)built by setup otherwise.
+     *        NB : The definition and the variables are then set up from the image:
+     *             the elements (states, messages, headers) are only loaded from the
+     *             configuration file when they are first used (Cf. getStates,
+     *             getCurrState, log).
+     * @param p_cachePath the path of the image (empty to disable the cache)
+     */
+    void setCache(const std::string& p_cachePath) { cacheFile = p_cachePath; }
+
+    /**
+     * @brief nextState makes the Model go into its next State.
+     */
+    void nextState(void) { loadElements(); curState = nexState; }
+
+    /**
+     * \brief getNextState returns the next state of the model
+     */
+    State* getNextState();
+
+    /**
+     * \brief getNextState returns the current state of the model
+     */
+    State* getCurrState();
+
+    void setNextState(State* p_state) { nexState = p_state; }
+
+    void setCurrState(State* p_state) { curState = p_state; }
+
+    /**
+     * \brief setResumed marks the current state as run again after a wait,
+     *        without having been left (Cf. State::runTransitions).
+     */
+    void setResumed(bool p_resumed) { resumed = p_resumed; }
+
+    /**
+     * \brief isResumed
+     * \return true if the current state is run again after a wait without having
+     *         been left: its operations are not run again, and its messages are
+     *         only sent again if it is resent (Cf. State::isResent, isSent).
+     */
+    bool isResumed() const { return resumed; }
+
+    /**
+     * \brief isSent
+     * \return true if the messages of the current state are to be sent.
+     */
+    bool isSent();
+
+    /**
+     * \brief getLoopCounter
+     * \param p_counter the index of the counter of a loop (Cf. LoopTransition::getCounter).
+     * \return the counter of the loop, for the states of the model: the loops
+     *         of the model keep no runtime state (Cf. CompiledModel).
+     */
+    int32_t& getLoopCounter(uint32_t p_counter) { return loops[p_counter]; }
+
+    /**
+     * \brief getMessageSize
+     * \param p_index the index of a message of the current state.
+     * \return the size (bytes) of the encoded message.
+     */
+    uint32_t getMessageSize(std::size_t p_index);
+
+    /**
+     * \brief encodeMessage encodes a message of the current state into a
+     *        caller-owned buffer, with the generators of the model (Cf.
+     *        CompiledModel::encodeMessage).
+     * \param p_index the index of a message of the current state.
+     * \param p_buffer the buffer to write the message to.
+     * \param p_capacity the size (bytes) of the buffer.
+     * \return the number of bytes written.
+     */
+    uint32_t encodeMessage(std::size_t p_index, uint8_t* p_buffer, std::size_t p_capacity);
+
+    /**
+     * \brief encodeMessages
+     * \return the encoded messages of the current state.
+     */
+    std::vector<std::vector<uint8_t>> encodeMessages();
+
+    /**
+     * \brief getScheduler
+     * \return the scheduler waiting for the delays of the transitions.
+     */
+    Scheduler& getScheduler() { return scheduler; }
+
+    /**
+     * \brief getCompiled
+     * \return the instance of the compiled model run with the variables
+     *         of the model (compiled by setup).
+     */
+    CompiledModel& getCompiled() { return compiled; }
+
+    /**
+     * \brief getDefinition
+     * \return the model lowered to dense arrays (compiled by setup), to run
+     *         other instances of it (Cf. CompiledModel). The definition does
+     *         not reference the elements: it stays valid after a reload.
+     */
+    std::shared_ptr<const ModelDefinition> getDefinition() const { return definition; }
+
+private:
+    /**
+     * Enumerate of the possible operations to perform
+     * on the model variables.
+     */
+    typedef enum {
+        ADD,    /*!< Addition       */
+        SUB,    /*!< Substraction   */
+        DEL     /*!< Suppresion     */
+    } OPERATION;
+
+    /**
+     * @brief addVariable Add the desired variable with the specified value
+     *        to the model variables (while the model is loaded).
+     * @param p_name The name of the variable to be added.
+     * @param p_val The value to give to the variable.
+     */
+    void addVariable(const std::string& p_name, int p_val);
+
+    /**
+     * @brief operateVariable Modify the specified variable.
+     * @param p_name The name of the variable to modify.
+     * @param p_operation The operation to perform.
+     * @param p_value The value of the second operande.
+     */
+    void operateVariable(const std::string&  p_name,
+                         const OPERATION&    p_operation,
+                         int                 p_value);
+
+    /**
+     * @brief checkIntegrity Performs model integrity verifications
+     *        after the configuration document has been parsed.
+     *        This function is needed because some parameters cannot be
+     *        checked at construction (especially when referencing structures
+     *        that were not parsed at that time).
+     */
+    void checkIntegrity();
+
+    /**
+     * \brief clear clears the data of the model.
+     */
+    void clear();
+
+    /**
+     * \brief internImage interns the names of the variables and states
+     *        of a definition loaded from an image.
+     * \return false if the names are not unique.
+     */
+    bool internImage();
+
+    /**
+     * \brief loadElements loads the elements of a model set up from its image
+     *        from the configuration file (once, when they are first used).
+     *        The variables keep their values.
+     */
+    void loadElements();
+
+    /**
+     * NB : The loader fills the variables, messages, headers and states.
+     */
+    friend class ConfLoader;
+
+private:
+    std::string*  confFile;        /*!< The file used for the configurations.   */
+    std::string   cacheFile;       /*!< The binary image of the model (if any). */
+    State *       curState;        /*!< Current state of the model.             */
+    State *       nexState;        /*!< Next state of the model.                */
+    bool          resumed;         /*!< Current state run again after a wait.   */
+    bool          loaded;          /*!< Elements loaded (Cf. loadElements).     */
+    MODELSTATE    currentStateStr; /*!< Current state string of the model.      */
+
+    std::unique_ptr<ModelElements>
+                  elements;        /*!< Elements defined in the model.          */
+    ModelVar      modelVar;        /*!< Variables used by the model.            */
+    std::vector<int32_t>
+                  loops;           /*!< Counters of the loops of the model.     */
+    Scheduler     scheduler;       /*!< Deadlines of the delays of the model.   */
+    std::shared_ptr<ModelDefinition>
+                  definition;      /*!< The model lowered to dense arrays.      */
+    CompiledModel compiled;        /*!< Its instance run with modelVar.         */
+    SetupTimes    setupTimes;      /*!< Durations of the steps of setup.        */
+
+    static std::map<MODELSTATE, std::string>
+                  stateString;     /*!< States of the model for string outputs  */
+};
+
+} // namespace ModGen
+
+#endif // MODELINSTANCE_MODELGENERATOR
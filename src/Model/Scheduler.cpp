@@ -0,0 +1,168 @@
+/*!
+ * @file   Scheduler.cpp
+ * @brief  Implementations of the functions defined in \a Scheduler.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "Scheduler.h"
+#include "Exception.h"
+#include "Logger.h"
+#include "time_util.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+Scheduler::Scheduler() :
+    deadline(),
+    started(false),
+    spin_us(0),
+    policy(LATE_CATCH_UP),
+    late_count(0),
+    max_lateness(0)
+{}
+
+////////////////////////////////////////////////////////////////////////
+void Scheduler::setup(uint64_t p_spin_us, int32_t p_policy)
+{
+    if(p_policy < LATE_CATCH_UP || p_policy > LATE_REBASE)
+    {
+        ERROR("Error - Unknown late deadline policy " + to_string(p_policy) + ".");
+        throw Exception::UnimplementedElement<LATE_POLICY>(p_policy);
+    }
+
+    spin_us = p_spin_us;
+    policy  = static_cast<LATE_POLICY>(p_policy);
+}
+
+////////////////////////////////////////////////////////////////////////
+void Scheduler::start()
+{
+    deadline = Clock::now();
+    started  = true;
+}
+
+////////////////////////////////////////////////////////////////////////
+void Scheduler::reset()
+{
+    started      = false;
+    late_count   = 0;
+    max_lateness = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+void Scheduler::wait(uint64_t p_delay_us)
+{
+    if(next(p_delay_us))
+    {
+        sleepUntil(deadline);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void Scheduler::wait(uint64_t p_delay_us, const function<uint64_t()>& p_wakeUp)
+{
+    if(!next(p_delay_us))
+    {
+        return;
+    }
+
+    // The wake-ups before the deadline are not spent spinning
+    for(uint64_t l_sleep = p_wakeUp(); ; l_sleep = p_wakeUp())
+    {
+        TimePoint l_now  = Clock::now();
+        uint64_t  l_left = (deadline > l_now) ? static_cast<uint64_t>(
+                               chrono::duration_cast<chrono::microseconds>(deadline - l_now).count()) : 0;
+        if(l_sleep >= l_left)
+        {
+            break;
+        }
+        this_thread::sleep_until(l_now + chrono::microseconds(l_sleep));
+    }
+
+    sleepUntil(deadline);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool Scheduler::next(uint64_t p_delay_us)
+{
+    if(!started)
+    {
+        start();
+    }
+
+    if(!p_delay_us)
+    {
+        return false;
+    }
+
+    // Virtual time: jump straight to the deadline (Cf. TimeUtil::startVirtual)
+    if(TimeUtil::isVirtual())
+    {
+        TimeUtil::advanceVirtual(p_delay_us);
+        return false;
+    }
+
+    chrono::microseconds l_delay(p_delay_us);
+    TimePoint            l_now = Clock::now();
+
+    deadline += l_delay;
+    if(deadline <= l_now)
+    {
+        uint64_t l_lateness = static_cast<uint64_t>(
+                    chrono::duration_cast<chrono::microseconds>(l_now - deadline).count());
+        late_count++;
+        max_lateness = max(max_lateness, l_lateness);
+
+        switch(policy)
+        {
+        case LATE_CATCH_UP:
+            // Late by more than one period (Ex/ the model was held by a long
+            // phase without delay): the missed deadlines are not sent at once
+            if(l_lateness >= p_delay_us)
+            {
+                deadline = l_now;
+            }
+            return false;
+        case LATE_SKIP:
+            deadline += l_delay * (l_lateness / p_delay_us + 1);
+            break;
+        case LATE_REBASE:
+            deadline = l_now;
+            return false;
+        default:
+            throw Exception::UnimplementedElement<LATE_POLICY>(policy);
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+void Scheduler::sleepUntil(const TimePoint& p_deadline) const
+{
+    if(!spin_us)
+    {
+        this_thread::sleep_until(p_deadline);
+        return;
+    }
+
+    // The wake-up latency is absorbed by the spinning tail
+    TimePoint l_wakeUp = p_deadline - chrono::microseconds(spin_us);
+    if(Clock::now() < l_wakeUp)
+    {
+        this_thread::sleep_until(l_wakeUp);
+    }
+    while(Clock::now() < p_deadline)
+    {
+        // Spinning
+    }
+}
+
+} // namespace ModGen
@@ -0,0 +1,121 @@
+/*!
+ * @file   Scheduler.h
+ * @brief  Contains the scheduler used to wait for the
+ *         delays of the transitions of the finite state machine.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef SCHEDULER_MODELGENERATOR
+#define SCHEDULER_MODELGENERATOR
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace ModGen {
+
+/*!
+ * \brief The Scheduler class waits for the delays of the transitions
+ *        (Cf. Transition::getDelay) on absolute deadlines.
+ *
+ *        Every delay is added to the previous deadline instead of the current
+ *        time: the time spent encoding, logging or waking up is not accumulated.
+ *        The last microseconds before a deadline can be spent spinning instead
+ *        of sleeping to compensate the wake-up latency of the system.
+ *        When the thread runs on a virtual clock (Cf. TimeUtil::startVirtual),
+ *        the delays advance the clock instead of being waited.
+ */
+class Scheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef Clock::time_point         TimePoint;
+
+    /*!
+     * Enumerate of the behaviours when a deadline has already passed.
+     */
+    typedef enum {
+        LATE_CATCH_UP = 0, /*!< Do not wait: the next delays are shortened to catch up
+                                (up to one period, from now beyond)                      */
+        LATE_SKIP     = 1, /*!< Wait for the next deadline of the grid (periods dropped)  */
+        LATE_REBASE   = 2  /*!< Do not wait: the deadlines are counted from now           */
+    } LATE_POLICY;
+
+    /*!
+     * \brief Scheduler default constructor
+     */
+    Scheduler();
+
+    /*!
+     * \brief setup sets the scheduling parameters.
+     * \param p_spin_us the time (us) spent spinning before every deadline (0 to only sleep).
+     * \param p_policy the behaviour when a deadline has already passed (Cf. LATE_POLICY).
+     */
+    void setup(uint64_t p_spin_us, int32_t p_policy);
+
+    /*!
+     * \brief start sets the time base of the deadlines to now.
+     *        (Called on the first wait if needed).
+     */
+    void start();
+
+    /*!
+     * \brief reset drops the time base and the statistics.
+     */
+    void reset();
+
+    /*!
+     * \brief wait waits until the next deadline.
+     * \param p_delay_us the delay (us) between the previous deadline and the next one.
+     */
+    void wait(uint64_t p_delay_us);
+
+    /*!
+     * \brief wait waits until the next deadline, waking up on the way when
+     *        a function asks for it (Ex/ to send the frames whose timeout
+     *        expires, Cf. FrameAggregator::getTimeLeft).
+     * \param p_delay_us the delay (us) between the previous deadline and the next one.
+     * \param p_wakeUp the function called before sleeping and on every wake-up,
+     *        returning the time (us) to sleep before calling it again (a time
+     *        beyond the deadline to sleep until the deadline).
+     */
+    void wait(uint64_t p_delay_us, const std::function<uint64_t()>& p_wakeUp);
+
+    /*!
+     * \brief getLateCount
+     * \return the number of deadlines which had already passed.
+     */
+    uint64_t getLateCount() const { return late_count; }
+
+    /*!
+     * \brief getMaxLateness
+     * \return the highest lateness (us) observed on a deadline.
+     */
+    uint64_t getMaxLateness() const { return max_lateness; }
+
+private:
+    /*!
+     * \brief next moves the deadline by a delay (Cf. LATE_POLICY).
+     * \param p_delay_us the delay (us) between the previous deadline and the next one.
+     * \return true if the deadline is to be waited.
+     */
+    bool next(uint64_t p_delay_us);
+
+    /*!
+     * \brief sleepUntil sleeps then spins until the deadline.
+     */
+    void sleepUntil(const TimePoint& p_deadline) const;
+
+private:
+    TimePoint   deadline;     /*!< The last deadline                         */
+    bool        started;      /*!< The time base has been set                */
+    uint64_t    spin_us;      /*!< Time (us) spent spinning before deadlines */
+    LATE_POLICY policy;       /*!< Behaviour on late deadlines               */
+    uint64_t    late_count;   /*!< Number of late deadlines                  */
+    uint64_t    max_lateness; /*!< Highest lateness (us)                     */
+};
+
+} // namespace ModGen
+
+#endif // SCHEDULER_MODELGENERATOR
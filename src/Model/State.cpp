@@ -12,7 +12,7 @@
 #include "Message.h"
 #include "time_util.h"
 #include "Model.h"
-#include <thread>
+#include "VariableStore.h"
 
 namespace ModGen {
 
@@ -36,7 +36,8 @@ map<Operation::OPERANDE, string> Operation::operandeString = {
 ////////////////////////////////////////////////////////////////////////
 Operation::Operation():
     var_name(),
-    var(nullptr),
+    var_id(SymbolTable::NONE),
+    vars(nullptr),
     operande(OP_UNKNOWN),
     value(-1)
 {}
@@ -48,7 +49,7 @@ Operation::~Operation()
 ////////////////////////////////////////////////////////////////////////
 void Operation::run()
 {
-    if(!var)
+    if(!vars)
     {
         throw Exception::UnimplementedElement<Operation>(var_name);
     }
@@ -56,17 +57,17 @@ void Operation::run()
     switch (operande)
     {
     case OP_ADD:
-        *var += value;
+        vars->add(var_id, value);
         break;
     case OP_SUB:
-        *var -= value;
+        vars->add(var_id, -value);
         break;
     case OP_DEL:
-        delete var;
-        var = nullptr;
+        // The variable is still referenced by ID: it is reset
+        vars->set(var_id, 0);
         break;
     case OP_ASSIGN:
-        *var = value;
+        vars->set(var_id, value);
         break;
     default:
         throw Exception::UnimplementedElement<OPERANDE>(operande);
@@ -76,8 +77,8 @@ void Operation::run()
 ////////////////////////////////////////////////////////////////////////
 bool Operation::isValid() const
 {
+    // The variable is set by ModelInstance::checkIntegrity
     return ( !var_name.empty()      &&
-             var                    &&
              operande != OP_UNKNOWN);
 }
 
@@ -133,9 +134,10 @@ void Operation::setParam(const string& p_name, const string& p_value)
 LoopTransition::LoopTransition():
     delay(-1),
     times(-1),
-    cur_cmpt(0)
+    counter(0)
 {
     dest_state = nullptr;
+    dest_id    = SymbolTable::NONE;
     dest_name  = "";
 }
 
@@ -187,35 +189,34 @@ void LoopTransition::setParam(const string &p_name,
 }
 
 ////////////////////////////////////////////////////////////////////////
-bool LoopTransition::run()
+bool LoopTransition::run(ModelInstance& p_model)
 {
     // Par défaut, la boucle est vérifiée
-    bool l_return = true;
-    cur_cmpt ++;
+    bool     l_return = true;
+    int32_t& l_cmpt   = p_model.getLoopCounter(counter);
+    l_cmpt ++;
 
     // Si on arrive a la fin de la boucle, on n'effectue pas d'iteration supplémentaire
-    if( cur_cmpt == times )
+    if( l_cmpt == times )
     {
-        cur_cmpt = 0;
+        l_cmpt   = 0;
         l_return = false;
     }
-    else
-    {
-        std::this_thread::sleep_for(std::chrono::microseconds(delay));
-    }
 
     return l_return;
 }
 
 ////////////////////////////////////////////////////////////////////////
 VarConditionTransition::VarConditionTransition():
-    var(nullptr),
+    vars(nullptr),
+    var_id(SymbolTable::NONE),
     var_name(),
     value(-1),
     operande(UNKNOWN),
     defaut(false)
 {
     dest_state = nullptr;
+    dest_id    = SymbolTable::NONE;
     dest_name  = "";
 }
 
@@ -291,7 +292,7 @@ void VarConditionTransition::setParam(const string &p_name,
 }
 
 ////////////////////////////////////////////////////////////////////////
-bool VarConditionTransition::run()
+bool VarConditionTransition::run(ModelInstance&)
 {
     // Always execute a default condition
     if(defaut)
@@ -299,16 +300,17 @@ bool VarConditionTransition::run()
         return true;
     }
 
-    if(!var)
+    if(!vars)
     {
         throw Exception::IntegrityCheckException<VarConditionTransition>("The var condition is pointing to a null model variable");
     }
 
+    int32_t l_var = vars->get(var_id);
     switch(operande)
     {
-    case OP_OVER:  return (*var > value);
-    case OP_UNDER: return (*var < value);
-    case OP_EQUAL: return (*var == value);
+    case OP_OVER:  return (l_var > value);
+    case OP_UNDER: return (l_var < value);
+    case OP_EQUAL: return (l_var == value);
     default:
         throw Exception::UnimplementedElement<OPERANDE>(operande);
     }
@@ -319,7 +321,8 @@ DelayConditionTransition::DelayConditionTransition():
     delay_value(-1)
 {
     dest_state = nullptr;
-    dest_name = "";
+    dest_id    = SymbolTable::NONE;
+    dest_name  = "";
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -360,15 +363,19 @@ void DelayConditionTransition::setParam(const string &p_name,
 }
 
 ////////////////////////////////////////////////////////////////////////
-bool DelayConditionTransition::run()
+bool DelayConditionTransition::run(ModelInstance&)
 {
-    std::this_thread::sleep_for(std::chrono::microseconds(delay_value));
+    // The delay is waited by the Scheduler of the model
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////
 State::State() :
-    name()
+    name(),
+    index(SymbolTable::NONE),
+    wait(false),
+    wait_timeout(0),
+    resend(true)
 {}
 
 ////////////////////////////////////////////////////////////////////////
@@ -390,6 +397,26 @@ void State::setParam(const string& p_name, const string& p_value)
     {
         name    = p_value;
     }
+    else if(p_name.compare(State_format::wait) == 0 || p_name.compare(State_format::resend) == 0)
+    {
+        bool& l_flag = (p_name.compare(State_format::wait) == 0) ? wait : resend;
+        if(p_value.compare("TRUE") == 0)
+        {
+            l_flag = true;
+        }
+        else if(p_value.compare("FALSE") == 0)
+        {
+            l_flag = false;
+        }
+        else
+        {
+            throw Exception::UnimplementedElement<bool>(p_value);
+        }
+    }
+    else if(p_name.compare(State_format::timeout) == 0)
+    {
+        wait_timeout = static_cast<uint64_t>(stoull(p_value));
+    }
     else
     {
         throw Exception::ParsingFileParamError<State>(p_name);
@@ -401,6 +428,12 @@ string State::getDesc() const
 {
     string l_return = "State " + name + "\n";
 
+    if(wait)
+    {
+        l_return += "\tWaits for its variables (timeout " + to_string(wait_timeout) + " us, "
+                  + (resend ? "messages sent again" : "messages not sent again") + ")\n";
+    }
+
     if(!operations.empty())
     {
         l_return += "\tOperations:\n";
@@ -435,21 +468,24 @@ string State::getDesc() const
 }
 
 ////////////////////////////////////////////////////////////////////////
-vector<vector<uint8_t> > State::getMessages(void)
+Message& State::getMessage(size_t p_index)
 {
-    // Build the message(s) to send
-    vector< vector<uint8_t> > l_mesgToSend(0);
-    for(auto& l_mesg: messages)
+    if(p_index >= messages.size())
     {
-        if(!l_mesg)
-        {
-            ERROR("The Message which ID's " + name + " references a null Message.");
-            throw Exception::IntegrityCheckException<Message>("The Message which ID's " + name + " references a null Message.");
-        }
-        l_mesgToSend.push_back(l_mesg->createMessage());
+        string l_error = "The state which ID is " + name + " has no message at index " + to_string(p_index)
+                       + " (" + to_string(messages.size()) + " message(s)).";
+        ERROR("Error - " + l_error);
+        throw Exception::IntegrityCheckException<State>(l_error);
     }
 
-    return l_mesgToSend;
+    if(!messages[p_index])
+    {
+        string l_error = "The message at index " + to_string(p_index) + " of the state which ID is " + name + " is null.";
+        ERROR("Error - " + l_error);
+        throw Exception::IntegrityCheckException<State>(l_error);
+    }
+
+    return *messages[p_index];
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -545,22 +581,75 @@ void State::runOperations()
 ////////////////////////////////////////////////////////////////////////
 void State::runTransitions()
 {
-    for(auto& l_trans: transitions)
+    runTransitions(Model::getInstance());
+}
+
+////////////////////////////////////////////////////////////////////////
+void State::runTransitions(ModelInstance& p_model)
+{
+    // A waiting state tests only variables (Cf. ModelInstance::checkIntegrity):
+    // their versions are read before the tests so that no change is missed
+    VariableStore&          l_vars = p_model.getVariables();
+    vector<SymbolTable::ID> l_ids;
+    vector<uint32_t>        l_versions;
+    if(wait)
+    {
+        for(auto& l_trans: transitions)
+        {
+            l_ids.push_back(static_cast<VarConditionTransition*>(l_trans)->getVarId());
+        }
+        l_versions.resize(l_ids.size());
+    }
+
+    VariableStore::TimePoint l_deadline = wait_timeout ? chrono::steady_clock::now() + chrono::microseconds(wait_timeout)
+                                                       : VariableStore::TimePoint::max();
+    do
     {
-        if(!l_trans)
+        for(size_t i = 0; i < l_ids.size(); i++)
+        {
+            l_versions[i] = l_vars.getVersion(l_ids[i]);
+        }
+
+        for(auto& l_trans: transitions)
         {
-            ERROR("The State which ID's " + name + " references a null Transition.");
-            throw Exception::IntegrityCheckException<State>("The State which ID's " + name + " references a null Transition.");
+            if(!l_trans)
+            {
+                ERROR("The State which ID's " + name + " references a null Transition.");
+                throw Exception::IntegrityCheckException<State>("The State which ID's " + name + " references a null Transition.");
+            }
+
+            if(l_trans->run(p_model))
+            {
+                p_model.setCurrState(p_model.getNextState());
+                p_model.setNextState(l_trans->getDestState());
+                p_model.setResumed(false);
+                p_model.getScheduler().wait(l_trans->getDelay());
+                return;
+            }
         }
 
-        if(l_trans->run())
+        // Virtual time: the timeout advances the clock instead of being waited
+        if(wait && wait_timeout && TimeUtil::isVirtual())
         {
-            Model::setCurrState(Model::getNextState());
-            Model::setNextState(l_trans->getDestState());
+            TimeUtil::advanceVirtual(wait_timeout);
+            p_model.setResumed(true);
             return;
         }
     }
+    while(wait && l_vars.wait(l_deadline, [&]()
+    {
+        for(size_t i = 0; i < l_ids.size(); i++)
+        {
+            if(l_vars.getVersion(l_ids[i]) != l_versions[i])
+            {
+                return true;
+            }
+        }
+        return false;
+    }));
 
+    // The state is run again once its timeout is reached
+    p_model.setResumed(wait);
 }
 
 } // namespace ModGen
\ No newline at end of file
@@ -11,10 +11,14 @@
 
 #include <includes.h>
 
+#include "SymbolTable.h"
+
 namespace ModGen {
 
 class State;
+class ModelInstance;
 class Message;
+class VariableStore;
 
 /*!
  * \brief The Transition class is the base abstract class
@@ -49,11 +53,18 @@ public:
      */
     State* getDestState() const {return dest_state; }
 
+    /*!
+     * \brief getDestId
+     * \return the ID of the destination state (Cf. ModelInstance::ModelSymbols).
+     */
+    SymbolTable::ID getDestId() const { return dest_id; }
+
     /*!
      * \brief setDestState sets the destination state of the transition
      * \param p_state
+     * \param p_id the ID of the state.
      */
-    void setDestState(State* p_state) { dest_state = p_state; }
+    void setDestState(State* p_state, SymbolTable::ID p_id) { dest_state = p_state; dest_id = p_id; }
 
     /*!
      * \brief getDestStateName returns the name ID of the destination
@@ -68,17 +79,27 @@ public:
      */
     virtual std::string getVar() { return ""; }
 
-    virtual void setVar(int&) { /* DUMMY */ }
+    virtual void setVar(SymbolTable::ID, VariableStore&) { /* DUMMY */ }
 
     /*!
      * \brief run
+     * \param p_model the instance of the model running the transition
+     *        (which holds its runtime state, Ex/ the loop counters).
      * \return true if the transition is to be made, false otherwise.
      */
-    virtual bool run() = 0;
+    virtual bool run(ModelInstance& p_model) = 0;
+
+    /*!
+     * \brief getDelay
+     * \return the delay (us) to wait before the transition is made
+     *         (Cf. Scheduler). The transitions do not wait by themselves.
+     */
+    virtual uint64_t getDelay() const { return 0; }
 
 protected:
-    State*      dest_state;  /*!< The destination state of the transition */
-    std::string dest_name;   /*!< The name of the destination state       */
+    State*          dest_state;  /*!< The destination state of the transition */
+    SymbolTable::ID dest_id;     /*!< The ID of the destination state         */
+    std::string     dest_name;   /*!< The name of the destination state       */
 };
 
 /*!
@@ -98,12 +119,34 @@ public:
 
     virtual void setParam(const std::string& p_name, const std::string& p_value);
 
-    virtual bool run();
+    virtual bool run(ModelInstance& p_model);
+
+    virtual uint64_t getDelay() const { return static_cast<uint64_t>(delay); }
+
+    /*!
+     * \brief getTimes
+     * \return the number of times to loop.
+     */
+    int32_t getTimes() const { return times; }
+
+    /*!
+     * \brief getCounter
+     * \return the index of the counter of the loop in the runtime
+     *         state of the instances (Cf. ModelInstance::getLoopCounter).
+     */
+    uint32_t getCounter() const { return counter; }
+
+    /*!
+     * \brief setCounter sets the index of the counter of the loop
+     *        (Cf. ModelInstance::checkIntegrity).
+     * \param p_counter the index of the counter.
+     */
+    void setCounter(uint32_t p_counter) { counter = p_counter; }
 
 private:
-    int32_t delay;      /*!< Delay in microseconds between each loop */
-    int32_t times;      /*!< The number of times to loop             */
-    int32_t cur_cmpt;   /*!< The current iteration of the loop       */
+    int32_t  delay;     /*!< Delay in microseconds between each loop */
+    int32_t  times;     /*!< The number of times to loop             */
+    uint32_t counter;   /*!< Index of the counter of the loop        */
 };
 
 /*!
@@ -134,18 +177,43 @@ public:
 
     virtual void setParam(const std::string& p_name, const std::string& p_value);
 
-    virtual void setVar(int& p_var) { var = &p_var; }
+    virtual void setVar(SymbolTable::ID p_id, VariableStore& p_vars) { var_id = p_id; vars = &p_vars; }
 
     virtual std::string getVar() { return var_name; }
 
-    virtual bool run();
+    /*!
+     * \brief getVarId
+     * \return the ID of the tested variable (Cf. ModelInstance::ModelSymbols).
+     */
+    SymbolTable::ID getVarId() const { return var_id; }
+
+    virtual bool run(ModelInstance& p_model);
+
+    /*!
+     * \brief getOperande
+     * \return the test performed on the variable.
+     */
+    OPERANDE getOperande() const { return operande; }
+
+    /*!
+     * \brief getValue
+     * \return the value to test the variable with.
+     */
+    int32_t getValue() const { return value; }
+
+    /*!
+     * \brief isDefault
+     * \return true if the condition is always verified.
+     */
+    bool isDefault() const { return defaut; }
 
 private:
-    int32_t*     var;        /*!< The variable to be tested                 */
-    std::string  var_name;   /*!< The variable name                         */
-    int32_t      value;      /*!< The value to test the variable with       */
-    OPERANDE     operande;   /*!< The performed test                        */
-    bool         defaut;     /*!< Defines if the condition is a default one */
+    VariableStore*  vars;     /*!< The variables of the model                */
+    SymbolTable::ID var_id;   /*!< The ID of the variable to be tested       */
+    std::string     var_name; /*!< The variable name                         */
+    int32_t         value;    /*!< The value to test the variable with       */
+    OPERANDE        operande; /*!< The performed test                        */
+    bool            defaut;   /*!< Defines if the condition is a default one */
 
     static std::map<OPERANDE, std::string>
                  operandeString; /*!< Test methods for std::string outputs  */
@@ -169,7 +237,9 @@ public:
     virtual void setParam(const std::string& p_name, 
                           const std::string& p_value);
 
-    virtual bool run();
+    virtual bool run(ModelInstance& p_model);
+
+    virtual uint64_t getDelay() const { return static_cast<uint64_t>(delay_value); }
 
 private:
     int32_t  delay_value;     /*!< The delay value in microseconds */
@@ -188,7 +258,7 @@ public:
     typedef enum {
         OP_ADD,    /*!< Performs addition on the variable     */
         OP_SUB,    /*!< Performs substraction on the variable */
-        OP_DEL,    /*!< Deletes the variable                  */
+        OP_DEL,    /*!< Deletes (resets) the variable         */
         OP_ASSIGN, /*!< Assigns value to the variable         */
         OP_UNKNOWN /*!< Unknown operation                     */
     } OPERANDE;
@@ -225,7 +295,31 @@ public:
      */
     std::string getDesc() const;
 
-    void setVariable(int32_t& p_variable) { var = &p_variable; }
+    /*!
+     * \brief setVariable sets the variable operated (resolved by
+     *        ModelInstance::checkIntegrity).
+     * \param p_id the ID of the variable.
+     * \param p_vars the variables of the model.
+     */
+    void setVariable(SymbolTable::ID p_id, VariableStore& p_vars) { var_id = p_id; vars = &p_vars; }
+
+    /*!
+     * \brief getVarId
+     * \return the ID of the operated variable (Cf. ModelInstance::ModelSymbols).
+     */
+    SymbolTable::ID getVarId() const { return var_id; }
+
+    /*!
+     * \brief getOperande
+     * \return the operation to perform.
+     */
+    OPERANDE getOperande() const { return operande; }
+
+    /*!
+     * \brief getValue
+     * \return the value of the operation.
+     */
+    int32_t getValue() const { return value; }
 
     /*!
      * \brief setParam Sets the desired param with the specified value.
@@ -236,10 +330,11 @@ public:
                   const std::string& p_value);
 
 private:
-    std::string  var_name; /*!< The ID of the operated variable   */
-    int32_t*     var;      /*!< The operated variable             */
-    OPERANDE     operande; /*!< Operation to perform              */
-    int32_t      value;    /*!< Value of the operation            */
+    std::string     var_name; /*!< The name of the operated variable */
+    SymbolTable::ID var_id;   /*!< The ID of the operated variable   */
+    VariableStore*  vars;     /*!< The variables of the model        */
+    OPERANDE        operande; /*!< Operation to perform              */
+    int32_t         value;    /*!< Value of the operation            */
 
     static std::map<OPERANDE, std::string>
     operandeString;        /*!< Operandes for std::string outputs */
@@ -289,12 +384,37 @@ public:
      */
     const std::string& getId() const { return name; }
 
+    /*!
+     * \brief getIndex
+     * \return the ID of the state (Cf. ModelInstance::ModelSymbols).
+     */
+    SymbolTable::ID getIndex() const { return index; }
+
+    /*!
+     * \brief setIndex sets the ID of the state (Cf. ModelInstance::checkIntegrity).
+     * \param p_index the ID of the state.
+     */
+    void setIndex(SymbolTable::ID p_index) { index = p_index; }
+
     /*!
      * \brief addMessage adds a \a Message to the current state.
      * \param p_message
      */
     void addMessage(Message* p_message)               { messages.push_back(p_message);        }
 
+    /*!
+     * \brief addMessageName adds the ID of a \a Message to the current state
+     *        (the message is added by ModelInstance::checkIntegrity).
+     * \param p_name
+     */
+    void addMessageName(const std::string& p_name)    { messageNames.push_back(p_name);       }
+
+    /*!
+     * \brief getMessageNames
+     * \return the IDs of the messages added by name.
+     */
+    const std::vector<std::string>& getMessageNames() const { return messageNames;            }
+
     /*!
      * \brief addTransition adds a \a Transition to the current state.
      * \param p_transition
@@ -314,10 +434,24 @@ public:
     std::vector<Transition*>& getTransitions()        { return transitions;                   }
 
     /*!
-     * \brief getMessages
-     * \return the list of messages to be sent
+     * \brief getOperations
+     * \return the \a Operation (s) of the current state.
+     */
+    const std::vector<Operation>& getOperations() const { return operations;                  }
+    std::vector<Operation>&       getOperations()       { return operations;                  }
+
+    /*!
+     * \brief getMessagesCount
+     * \return the number of messages to be sent
+     */
+    std::size_t getMessagesCount() const { return messages.size(); }
+
+    /*!
+     * \brief getMessage
+     * \param p_index the index of the message in the state.
+     * \return the (checked) message at the specified index.
      */
-    std::vector< std::vector<unsigned char> > getMessages();
+    Message& getMessage(std::size_t p_index);
 
     /*!
      * \brief getMessagesSrcIP
@@ -356,14 +490,50 @@ public:
 
     /*!
      * \brief run Performs the transitions asociated with this state
+     *        on the default instance of the model (Cf. Model.h)
      */
     void runTransitions();
 
+    /*!
+     * \brief run Performs the transitions asociated with this state
+     *        (a waiting state blocks until one of them is made, or until
+     *        its timeout: it is then resumed, Cf. isWaiting, ModelInstance::isResumed).
+     * \param p_model the instance of the model owning this state.
+     */
+    void runTransitions(ModelInstance& p_model);
+
+    /*!
+     * \brief isWaiting
+     * \return true if the state waits for a change of the variables of its
+     *         conditions when none of them is true (instead of being run again
+     *         right away). Only the states whose transitions all test a variable wait.
+     */
+    bool isWaiting() const { return wait; }
+
+    /*!
+     * \brief getWaitTimeout
+     * \return the maximum time (us) a waiting state waits for its variables
+     *         before being run again (0 for no limit).
+     */
+    uint64_t getWaitTimeout() const { return wait_timeout; }
+
+    /*!
+     * \brief isResent
+     * \return true if the messages of a waiting state are sent again when
+     *         the state is run again without having been left.
+     */
+    bool isResent() const { return resend; }
+
 private:
     std::string              name;        /*!< Id of the state                              */
+    SymbolTable::ID          index;       /*!< ID of the state (index in the model)         */
     std::vector<Message*>    messages;    /*!< The associated message(s)                    */
+    std::vector<std::string> messageNames;/*!< IDs of the messages to associate             */
     std::vector<Transition*> transitions; /*!< The possible transitions                     */
     std::vector<Operation>   operations;  /*!< The operations to perform on model variables */
+    bool                     wait;        /*!< Waits for its variables (Cf. isWaiting)      */
+    uint64_t                 wait_timeout;/*!< Maximum wait (us), 0 for no limit            */
+    bool                     resend;      /*!< Messages sent again after a wait             */
 };
 
 } // namespace ModGen
@@ -0,0 +1,54 @@
+/*!
+ * @file   SymbolTable.cpp
+ * @brief  Implementations of the functions defined in \a SymbolTable.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <limits>
+
+#include "SymbolTable.h"
+
+namespace ModGen {
+
+using namespace std;
+
+const SymbolTable::ID SymbolTable::NONE = numeric_limits<SymbolTable::ID>::max();
+
+////////////////////////////////////////////////////////////////////////
+SymbolTable::SymbolTable() :
+    names(),
+    ids()
+{}
+
+////////////////////////////////////////////////////////////////////////
+SymbolTable::ID SymbolTable::intern(string_view p_name)
+{
+    auto l_found = ids.find(p_name);
+    if(l_found != ids.end())
+    {
+        return l_found->second;
+    }
+
+    // The key is a view on the name kept by the table
+    ID l_id = static_cast<ID>(names.size());
+    names.emplace_back(p_name);
+    ids.emplace(names.back(), l_id);
+    return l_id;
+}
+
+////////////////////////////////////////////////////////////////////////
+SymbolTable::ID SymbolTable::find(string_view p_name) const
+{
+    auto l_found = ids.find(p_name);
+    return (l_found != ids.end()) ? l_found->second : NONE;
+}
+
+////////////////////////////////////////////////////////////////////////
+void SymbolTable::clear()
+{
+    ids.clear();
+    names.clear();
+}
+
+} // namespace ModGen
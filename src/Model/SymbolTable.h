@@ -0,0 +1,81 @@
+/*!
+ * @file   SymbolTable.h
+ * @brief  Contains the table interning the identifiers of a model
+ *         (names of the states, variables, messages and headers).
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef SYMBOLTABLE_MODELGENERATOR
+#define SYMBOLTABLE_MODELGENERATOR
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ModGen {
+
+/*!
+ * \brief The SymbolTable class interns identifiers: every name is given
+ *        a compact ID (0, 1, 2... in the order of the first intern) when
+ *        the model is loaded.
+ *        The model references its elements by ID (index of the element in
+ *        its container): the names are only kept for the diagnostics.
+ */
+class SymbolTable
+{
+public:
+    typedef uint32_t ID;
+
+    static const ID NONE; /*!< ID of the unknown names */
+
+    /*!
+     * \brief SymbolTable constructor (empty table)
+     */
+    SymbolTable();
+
+    SymbolTable(const SymbolTable&)            = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /*!
+     * \brief intern gets the ID of a name, added to the table if unknown.
+     * \param p_name the name.
+     * \return the ID of the name (== size() - 1 if it was added).
+     */
+    ID intern(std::string_view p_name);
+
+    /*!
+     * \brief find gets the ID of a name.
+     * \param p_name the name.
+     * \return the ID of the name, NONE if it is unknown.
+     */
+    ID find(std::string_view p_name) const;
+
+    /*!
+     * \brief getName
+     * \param p_id an ID of the table (< size).
+     * \return the name of the ID.
+     */
+    const std::string& getName(ID p_id) const { return names[p_id]; }
+
+    /*!
+     * \brief size
+     * \return the number of names of the table.
+     */
+    std::size_t size() const { return names.size(); }
+
+    /*!
+     * \brief clear removes every name (the IDs are given from 0 again).
+     */
+    void clear();
+
+private:
+    std::deque<std::string>                  names; /*!< Names, by ID (never moved)     */
+    std::unordered_map<std::string_view, ID> ids;   /*!< IDs of the names (in \a names) */
+};
+
+} // namespace ModGen
+
+#endif // SYMBOLTABLE_MODELGENERATOR
@@ -0,0 +1,188 @@
+/*!
+ * @file   TimingWheel.cpp
+ * @brief  Implementations of the functions defined in \a TimingWheel.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "TimingWheel.h"
+
+namespace ModGen {
+
+using namespace std;
+
+const TimingWheel::ENTRY TimingWheel::NONE  = numeric_limits<TimingWheel::ENTRY>::max();
+const uint64_t           TimingWheel::NEVER = numeric_limits<uint64_t>::max();
+
+////////////////////////////////////////////////////////////////////////
+TimingWheel::TimingWheel() :
+    deadlines(),
+    nexts(),
+    heads(),
+    occupied(),
+    tick(0),
+    count(0)
+{
+    setup(0, 0);
+}
+
+////////////////////////////////////////////////////////////////////////
+void TimingWheel::setup(size_t p_capacity, uint64_t p_tick)
+{
+    deadlines.assign(p_capacity, 0);
+    nexts.assign(p_capacity, NONE);
+    for(uint32_t l = 0; l < LEVELS; l++)
+    {
+        fill(heads[l], heads[l] + SLOTS, NONE);
+        fill(occupied[l], occupied[l] + WORDS, 0);
+    }
+    tick  = p_tick;
+    count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+void TimingWheel::schedule(ENTRY p_entry, uint64_t p_deadline)
+{
+    deadlines[p_entry] = p_deadline;
+    insert(p_entry);
+    count++;
+}
+
+////////////////////////////////////////////////////////////////////////
+void TimingWheel::insert(ENTRY p_entry)
+{
+    // The passed deadlines are due on the current tick, those beyond
+    // the wheel wait in the last slot of its window
+    uint64_t l_end = ((tick >> (LEVELS * SLOT_BITS)) + 1) << (LEVELS * SLOT_BITS);
+    uint64_t l_at  = min(max(deadlines[p_entry], tick), l_end - 1);
+
+    // Lowest level whose current window holds the deadline
+    uint64_t l_diff  = l_at ^ tick;
+    uint32_t l_level = 0;
+    while(l_level + 1 < LEVELS && (l_diff >> ((l_level + 1) * SLOT_BITS)))
+    {
+        l_level++;
+    }
+
+    uint32_t l_slot = static_cast<uint32_t>(l_at >> (l_level * SLOT_BITS)) & (SLOTS - 1);
+    nexts[p_entry]         = heads[l_level][l_slot];
+    heads[l_level][l_slot] = p_entry;
+    occupied[l_level][l_slot / 64] |= uint64_t(1) << (l_slot % 64);
+}
+
+////////////////////////////////////////////////////////////////////////
+TimingWheel::ENTRY TimingWheel::detach(uint32_t p_level, uint32_t p_slot)
+{
+    ENTRY l_first = heads[p_level][p_slot];
+    heads[p_level][p_slot] = NONE;
+    occupied[p_level][p_slot / 64] &= ~(uint64_t(1) << (p_slot % 64));
+    return l_first;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t TimingWheel::findSlot(uint32_t p_level, uint32_t p_slot) const
+{
+    for(uint32_t w = p_slot / 64; w < WORDS; w++)
+    {
+        uint64_t l_word = occupied[p_level][w];
+        if(w == p_slot / 64)
+        {
+            l_word &= ~uint64_t(0) << (p_slot % 64);
+        }
+        if(l_word)
+        {
+#if defined(__GNUC__)
+            return w * 64 + static_cast<uint32_t>(__builtin_ctzll(l_word));
+#else
+            uint32_t l_found = w * 64;
+            for(; !(l_word & 1); l_word >>= 1)
+            {
+                l_found++;
+            }
+            return l_found;
+#endif
+        }
+    }
+    return SLOTS;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t TimingWheel::getNextTick() const
+{
+    // The entries of a level are in the window of the level above: the
+    // first occupied slot of the lowest level is the next thing to do
+    for(uint32_t l = 0; l < LEVELS; l++)
+    {
+        // The current slot of an upper level has been cascaded (Cf. moveTo)
+        uint32_t l_shift = l * SLOT_BITS;
+        uint32_t l_slot  = (static_cast<uint32_t>(tick >> l_shift) & (SLOTS - 1)) + (l ? 1 : 0);
+
+        uint32_t l_found = (l_slot < SLOTS) ? findSlot(l, l_slot) : SLOTS;
+        if(l_found < SLOTS)
+        {
+            uint32_t l_window = l_shift + SLOT_BITS;
+            return ((tick >> l_window) << l_window) | (uint64_t(l_found) << l_shift);
+        }
+    }
+    return NEVER;
+}
+
+////////////////////////////////////////////////////////////////////////
+void TimingWheel::moveTo(uint64_t p_tick)
+{
+    tick = p_tick;
+
+    // The slots starting at the tick go down, from the highest level
+    for(uint32_t l = LEVELS - 1; l > 0; l--)
+    {
+        uint32_t l_shift = l * SLOT_BITS;
+        if(p_tick & ((uint64_t(1) << l_shift) - 1))
+        {
+            continue;
+        }
+
+        ENTRY l_entry = detach(l, static_cast<uint32_t>(p_tick >> l_shift) & (SLOTS - 1));
+        while(l_entry != NONE)
+        {
+            ENTRY l_following = nexts[l_entry];
+            insert(l_entry);
+            l_entry = l_following;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+TimingWheel::ENTRY TimingWheel::expire(uint64_t p_tick)
+{
+    if(tick != p_tick)
+    {
+        moveTo(p_tick);
+    }
+
+    ENTRY l_entry = detach(0, static_cast<uint32_t>(p_tick) & (SLOTS - 1));
+    moveTo(p_tick + 1);
+
+    // The deadlines beyond the wheel are scheduled again
+    ENTRY l_due = NONE;
+    while(l_entry != NONE)
+    {
+        ENTRY l_following = nexts[l_entry];
+        if(deadlines[l_entry] > p_tick)
+        {
+            insert(l_entry);
+        }
+        else
+        {
+            nexts[l_entry] = l_due;
+            l_due          = l_entry;
+            count--;
+        }
+        l_entry = l_following;
+    }
+    return l_due;
+}
+
+} // namespace ModGen
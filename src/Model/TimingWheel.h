@@ -0,0 +1,154 @@
+/*!
+ * @file   TimingWheel.h
+ * @brief  Contains the hierarchical timing wheel holding the
+ *         deadlines of the instances run by an \a EventLoop.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef TIMINGWHEEL_MODELGENERATOR
+#define TIMINGWHEEL_MODELGENERATOR
+
+#include <cstdint>
+#include <vector>
+
+namespace ModGen {
+
+/*!
+ * \brief The TimingWheel class schedules entries (0 to capacity - 1) on
+ *        absolute deadlines counted in ticks.
+ *
+ *        The wheel has LEVELS levels of SLOTS slots: a slot of the level L
+ *        spans SLOTS^L ticks. An entry is put in the lowest level whose current
+ *        window holds its deadline, so that inserting and expiring an entry is
+ *        O(1): when the wheel reaches a slot of an upper level, its entries are
+ *        cascaded to the lower levels (Cf. advance). The entries are chained in
+ *        arrays indexed by entry (no allocation once set up), and a bitmap of
+ *        the occupied slots of every level gives the next deadline without
+ *        visiting the empty slots.
+ *        The deadlines beyond the wheel (SLOTS^LEVELS ticks) wait in its last
+ *        slots and are scheduled again when they are reached.
+ */
+class TimingWheel
+{
+public:
+    typedef uint32_t ENTRY;
+
+    static const uint32_t LEVELS    = 4;              /*!< Levels of the wheel   */
+    static const uint32_t SLOT_BITS = 8;              /*!< log2 of SLOTS         */
+    static const uint32_t SLOTS     = 1 << SLOT_BITS; /*!< Slots of every level  */
+    static const ENTRY    NONE;                       /*!< End of the chains     */
+    static const uint64_t NEVER;                      /*!< No deadline (empty)   */
+
+    /*!
+     * \brief TimingWheel default constructor (no entry)
+     */
+    TimingWheel();
+
+    /*!
+     * \brief setup empties the wheel.
+     * \param p_capacity the number of entries (0 to p_capacity - 1).
+     * \param p_tick the current tick.
+     */
+    void setup(std::size_t p_capacity, uint64_t p_tick);
+
+    /*!
+     * \brief schedule schedules an entry (which must not be already scheduled).
+     * \param p_entry the entry (< capacity).
+     * \param p_deadline the tick at which it expires (the next tick if
+     *        it has already passed).
+     */
+    void schedule(ENTRY p_entry, uint64_t p_deadline);
+
+    /*!
+     * \brief getNextTick
+     * \return the first tick at which the wheel has work to do (an entry
+     *         expires or a slot is cascaded), NEVER if the wheel is empty.
+     */
+    uint64_t getNextTick() const;
+
+    /*!
+     * \brief getTick
+     * \return the first tick not processed yet.
+     */
+    uint64_t getTick() const { return tick; }
+
+    /*!
+     * \brief size
+     * \return the number of entries scheduled.
+     */
+    std::size_t size() const { return count; }
+
+    /*!
+     * \brief advance processes the ticks up to p_tick (included): every entry
+     *        due is unscheduled then given to p_expire (which can schedule it again).
+     * \param p_tick the last tick to process.
+     * \param p_expire the function called with each entry due.
+     */
+    template<typename EXPIRE>
+    void advance(uint64_t p_tick, EXPIRE p_expire)
+    {
+        for(uint64_t l_next = getNextTick(); l_next <= p_tick; l_next = getNextTick())
+        {
+            ENTRY l_entry = expire(l_next);
+            while(l_entry != NONE)
+            {
+                // Read before the entry is given (it can be scheduled again)
+                ENTRY l_following = nexts[l_entry];
+                p_expire(l_entry);
+                l_entry = l_following;
+            }
+        }
+
+        if(tick <= p_tick)
+        {
+            moveTo(p_tick + 1);
+        }
+    }
+
+private:
+    /*!
+     * \brief insert chains an entry in the slot of its deadline.
+     */
+    void insert(ENTRY p_entry);
+
+    /*!
+     * \brief detach empties a slot.
+     * \return the first entry of the slot, NONE if it was empty.
+     */
+    ENTRY detach(uint32_t p_level, uint32_t p_slot);
+
+    /*!
+     * \brief findSlot
+     * \return the first occupied slot of a level from p_slot, SLOTS if none.
+     */
+    uint32_t findSlot(uint32_t p_level, uint32_t p_slot) const;
+
+    /*!
+     * \brief moveTo sets the current tick (no work to do in between, Cf.
+     *        getNextTick): the slots of the upper levels starting at the tick
+     *        are cascaded, so that the current slots of these levels are empty.
+     */
+    void moveTo(uint64_t p_tick);
+
+    /*!
+     * \brief expire processes a tick (returned by getNextTick): the wheel moves
+     *        to the tick, then the entries of its slot are unscheduled.
+     * \return the first entry due (chained by \a nexts), NONE if none.
+     */
+    ENTRY expire(uint64_t p_tick);
+
+private:
+    static const uint32_t WORDS = SLOTS / 64; /*!< Words of the bitmap of a level */
+
+    std::vector<uint64_t> deadlines;               /*!< Deadline (tick), by entry        */
+    std::vector<ENTRY>    nexts;                   /*!< Next entry of the slot, by entry */
+    ENTRY                 heads[LEVELS][SLOTS];    /*!< First entry, by slot             */
+    uint64_t              occupied[LEVELS][WORDS]; /*!< Bitmap of the non-empty slots    */
+    uint64_t              tick;                    /*!< First tick not processed yet     */
+    std::size_t           count;                   /*!< Number of entries scheduled      */
+};
+
+} // namespace ModGen
+
+#endif // TIMINGWHEEL_MODELGENERATOR
@@ -0,0 +1,77 @@
+/*!
+ * @file   VariableStore.cpp
+ * @brief  Implementations of the functions defined in \a VariableStore.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include "VariableStore.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+VariableStore::VariableStore() :
+    initial(),
+    words(),
+    waiters(0),
+    mutex(),
+    changed()
+{}
+
+////////////////////////////////////////////////////////////////////////
+SymbolTable::ID VariableStore::add(int32_t p_init)
+{
+    initial.push_back(p_init);
+    return static_cast<SymbolTable::ID>(initial.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////
+void VariableStore::reset()
+{
+    if(!words)
+    {
+        words.reset(new atomic<uint64_t>[initial.size()]);
+        for(size_t i = 0; i < initial.size(); i++)
+        {
+            words[i].store(static_cast<uint32_t>(initial[i]));
+        }
+        return;
+    }
+
+    // The waiting threads see the reset as a change
+    for(SymbolTable::ID i = 0; i < initial.size(); i++)
+    {
+        set(i, initial[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void VariableStore::clear()
+{
+    initial.clear();
+    words.reset();
+}
+
+////////////////////////////////////////////////////////////////////////
+void VariableStore::set(SymbolTable::ID p_id, int32_t p_value)
+{
+    uint64_t l_word = words[p_id].load(memory_order_relaxed);
+    uint64_t l_new;
+    do
+    {
+        l_new = ((l_word & ~uint64_t(0xFFFFFFFF)) + VERSION_ONE) | static_cast<uint32_t>(p_value);
+    }
+    while(!words[p_id].compare_exchange_weak(l_word, l_new));
+
+    notify();
+}
+
+////////////////////////////////////////////////////////////////////////
+bool VariableStore::wait(SymbolTable::ID p_id, uint32_t p_version, const TimePoint& p_deadline)
+{
+    return wait(p_deadline, [&]() { return getVersion(p_id) != p_version; });
+}
+
+} // namespace ModGen
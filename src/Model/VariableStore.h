@@ -0,0 +1,186 @@
+/*!
+ * @file   VariableStore.h
+ * @brief  Contains the variables of a model, shared with the
+ *         threads driving them from outside the model.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef VARIABLESTORE_MODELGENERATOR
+#define VARIABLESTORE_MODELGENERATOR
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "SymbolTable.h"
+
+namespace ModGen {
+
+/*!
+ * \brief The VariableStore class holds the values of the variables of a
+ *        model in an array indexed by their ID (Cf. ModelInstance::ModelSymbols).
+ *
+ *        Every variable is one atomic word (version << 32 | value): it can be
+ *        read and written by any thread while the model runs, without lock.
+ *        Every change increments the version of the variable, so that a thread
+ *        can block until a variable changes (Cf. wait) - the waiting threads are
+ *        woken up by the writers, which only take a lock when someone waits.
+ *
+ *        The variables are added while the model is loaded; \a reset then
+ *        builds the array (the variables are not added or removed afterwards).
+ */
+class VariableStore
+{
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    /*!
+     * \brief VariableStore constructor (no variable)
+     */
+    VariableStore();
+
+    VariableStore(const VariableStore&)            = delete;
+    VariableStore& operator=(const VariableStore&) = delete;
+
+    /*!
+     * \brief add adds a variable (while the model is loaded).
+     * \param p_init the initial value of the variable.
+     * \return the ID of the variable.
+     */
+    SymbolTable::ID add(int32_t p_init);
+
+    /*!
+     * \brief setInitial changes the initial value of a variable
+     *        (while the model is loaded).
+     * \param p_id the ID of the variable.
+     * \param p_init the initial value of the variable.
+     */
+    void setInitial(SymbolTable::ID p_id, int32_t p_init) { initial[p_id] = p_init; }
+
+    /*!
+     * \brief getInitial
+     * \param p_id the ID of the variable (< size).
+     * \return the initial value of the variable.
+     */
+    int32_t getInitial(SymbolTable::ID p_id) const { return initial[p_id]; }
+
+    /*!
+     * \brief reset gives every variable its initial value
+     *        (the array is built after the variables were added).
+     */
+    void reset();
+
+    /*!
+     * \brief clear removes every variable.
+     */
+    void clear();
+
+    /*!
+     * \brief size
+     * \return the number of variables.
+     */
+    std::size_t size() const { return initial.size(); }
+
+    /*!
+     * \brief get
+     * \param p_id the ID of the variable (< size).
+     * \return the value of the variable.
+     */
+    int32_t get(SymbolTable::ID p_id) const
+    {
+        return static_cast<int32_t>(static_cast<uint32_t>(words[p_id].load(std::memory_order_acquire)));
+    }
+
+    /*!
+     * \brief getVersion
+     * \param p_id the ID of the variable (< size).
+     * \return the number of changes of the variable (wraps around).
+     */
+    uint32_t getVersion(SymbolTable::ID p_id) const
+    {
+        return static_cast<uint32_t>(words[p_id].load(std::memory_order_acquire) >> 32);
+    }
+
+    /*!
+     * \brief set sets the value of a variable.
+     * \param p_id the ID of the variable (< size).
+     * \param p_value the value.
+     */
+    void set(SymbolTable::ID p_id, int32_t p_value);
+
+    /*!
+     * \brief add adds a value to a variable (atomically: the concurrent
+     *        changes are not lost).
+     * \param p_id the ID of the variable (< size).
+     * \param p_value the value to add (negative to substract).
+     */
+    void add(SymbolTable::ID p_id, int32_t p_value)
+    {
+        words[p_id].fetch_add(VERSION_ONE + static_cast<uint32_t>(p_value));
+        notify();
+    }
+
+    /*!
+     * \brief wait blocks until a variable changes.
+     * \param p_id the ID of the variable (< size).
+     * \param p_version the version the variable had (Cf. getVersion).
+     * \param p_deadline the time to stop waiting at.
+     * \return true if the variable changed, false if the deadline was reached.
+     */
+    bool wait(SymbolTable::ID p_id, uint32_t p_version, const TimePoint& p_deadline);
+
+    /*!
+     * \brief wait blocks until a test on the variables is true
+     *        (evaluated again on every change of a variable).
+     * \param p_deadline the time to stop waiting at.
+     * \param p_changed the test (i.e. versions compared to those read before).
+     * \return true if the test is true, false if the deadline was reached.
+     */
+    template<typename TEST>
+    bool wait(const TimePoint& p_deadline, TEST p_changed)
+    {
+        // Counted before the versions are read: a writer either sees the
+        // waiter, or has changed a version before it is read
+        waiters.fetch_add(1);
+
+        bool l_changed;
+        {
+            std::unique_lock<std::mutex> l_lock(mutex);
+            l_changed = changed.wait_until(l_lock, p_deadline, p_changed);
+        }
+
+        waiters.fetch_sub(1);
+        return l_changed;
+    }
+
+private:
+    /*!
+     * \brief notify wakes up the threads waiting for a change.
+     */
+    void notify()
+    {
+        if(waiters.load() != 0)
+        {
+            std::lock_guard<std::mutex> l_lock(mutex);
+            changed.notify_all();
+        }
+    }
+
+private:
+    static const uint64_t VERSION_ONE = uint64_t(1) << 32; /*!< One change in a word */
+
+    std::vector<int32_t>                     initial;  /*!< Initial values, by ID                */
+    std::unique_ptr<std::atomic<uint64_t>[]> words;    /*!< Version and value, by ID             */
+    std::atomic<uint32_t>                    waiters;  /*!< Number of threads waiting (Cf. wait) */
+    std::mutex                               mutex;    /*!< Protects the waits                   */
+    std::condition_variable                  changed;  /*!< Signaled when a variable changes     */
+};
+
+} // namespace ModGen
+
+#endif // VARIABLESTORE_MODELGENERATOR
@@ -0,0 +1,344 @@
+/*!
+ * @file   WorkStealingRunner.cpp
+ * @brief  Implementations of the functions defined in \a WorkStealingRunner.h
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "WorkStealingRunner.h"
+#include "CompiledModel.h"
+#include "EventLoop.h"
+#include "Exception.h"
+#include "Logger.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+WorkStealingRunner::WorkStealingRunner() :
+    instances(),
+    workers(),
+    tick_us(EventLoop::DEFAULT_TICK_US),
+    poll_us(EventLoop::DEFAULT_POLL_US),
+    origin(),
+    backlogs(0),
+    sleepers(0),
+    stopped(false)
+{
+    setup(0, tick_us, poll_us);
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkStealingRunner::setup(uint32_t p_workers, uint64_t p_tick_us, uint64_t p_poll_us)
+{
+    if(!p_tick_us)
+    {
+        ERROR("Error - The tick of the work stealing runner must not be 0.");
+        throw Exception::UnimplementedElement<WorkStealingRunner>(0);
+    }
+
+    if(!p_workers)
+    {
+        p_workers = max(thread::hardware_concurrency(), 1u);
+    }
+
+    workers.clear();
+    for(uint32_t w = 0; w < p_workers; w++)
+    {
+        workers.emplace_back(new Worker());
+    }
+    tick_us = p_tick_us;
+    poll_us = p_poll_us;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint32_t WorkStealingRunner::add(CompiledModel& p_model, uint64_t p_start_us)
+{
+    instances.push_back(Instance{ &p_model, p_start_us, p_start_us, p_start_us });
+    return static_cast<uint32_t>(instances.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkStealingRunner::clear()
+{
+    instances.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t WorkStealingRunner::now() const
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(Clock::now() - origin).count());
+}
+
+////////////////////////////////////////////////////////////////////////
+WorkStealingRunner::Statistics WorkStealingRunner::getStatistics() const
+{
+    Statistics l_total{};
+    for(auto& l_worker: workers)
+    {
+        l_total.steps        += l_worker->statistics.steps;
+        l_total.stolen       += l_worker->statistics.stolen;
+        l_total.sleeps       += l_worker->statistics.sleeps;
+        l_total.sum_lateness += l_worker->statistics.sum_lateness;
+        l_total.max_lateness  = max(l_total.max_lateness, l_worker->statistics.max_lateness);
+    }
+    return l_total;
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkStealingRunner::run(const Sender& p_sender, uint64_t p_duration_us)
+{
+    origin = Clock::now();
+    backlogs.store(0);
+    sleepers.store(0);
+
+    // The instances are given to the workers in turn
+    for(auto& l_worker: workers)
+    {
+        l_worker->wheel.setup(instances.size(), 0);
+        l_worker->queue.clear();
+        l_worker->sleeping.store(false);
+        l_worker->statistics = Statistics();
+    }
+    for(uint32_t i = 0; i < instances.size(); i++)
+    {
+        Worker& l_owner = *workers[i % workers.size()];
+        instances[i].last     = instances[i].start;
+        instances[i].deadline = instances[i].start;
+        if(instances[i].start)
+        {
+            l_owner.wheel.schedule(i, toTick(instances[i].start));
+        }
+        else
+        {
+            l_owner.queue.push_back(i);
+        }
+    }
+
+    for(uint32_t w = 0; w < workers.size(); w++)
+    {
+        workers[w]->thread = thread(&WorkStealingRunner::work, this, w, cref(p_sender), p_duration_us);
+    }
+    for(auto& l_worker: workers)
+    {
+        l_worker->thread.join();
+    }
+
+    stopped.store(false);
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkStealingRunner::work(uint32_t p_worker, const Sender& p_sender, uint64_t p_duration_us)
+{
+    Worker&          l_self = *workers[p_worker];
+    vector<uint32_t> l_due;
+    pin(p_worker);
+
+    while(!stopped.load(memory_order_relaxed))
+    {
+        uint64_t l_now = now();
+        if(p_duration_us && l_now >= p_duration_us)
+        {
+            break;
+        }
+
+        // The instances due join the queue, whose front is run
+        l_due.clear();
+        l_self.wheel.advance(l_now / tick_us, [&](TimingWheel::ENTRY p_entry) { l_due.push_back(p_entry); });
+
+        uint32_t l_index   = TimingWheel::NONE;
+        size_t   l_backlog = 0;
+        {
+            lock_guard<mutex> l_lock(l_self.mutex);
+            l_self.queue.insert(l_self.queue.end(), l_due.begin(), l_due.end());
+            if(!l_self.queue.empty())
+            {
+                l_index = l_self.queue.front();
+                l_self.queue.pop_front();
+            }
+            l_backlog = l_self.queue.size();
+        }
+
+        if(l_index != TimingWheel::NONE)
+        {
+            // New instances due on a worker which is behind
+            if(l_backlog > 1 && !l_due.empty())
+            {
+                wakeUp(p_worker);
+            }
+            runInstance(p_worker, l_index, p_sender);
+            continue;
+        }
+
+        // Read before stealing: a backlog signaled afterwards is not missed
+        uint64_t l_seen = backlogs.load();
+        if(steal(p_worker))
+        {
+            continue;
+        }
+
+        // Sleeping until the next deadline of the worker, or until there is
+        // work to steal (by slices to check for a stop)
+        uint64_t l_next   = l_self.wheel.getNextTick();
+        uint64_t l_wakeUp = l_now + EventLoop::MAX_SLEEP_US;
+        if(l_next != TimingWheel::NEVER)
+        {
+            l_wakeUp = min(l_wakeUp, l_next * tick_us);
+        }
+        if(p_duration_us)
+        {
+            l_wakeUp = min(l_wakeUp, p_duration_us);
+        }
+
+        unique_lock<mutex> l_lock(l_self.mutex);
+        l_self.sleeping.store(true);
+        sleepers.fetch_add(1);
+        l_self.statistics.sleeps++;
+        l_self.wake.wait_until(l_lock, origin + chrono::microseconds(l_wakeUp), [&]()
+        {
+            return backlogs.load() != l_seen || !l_self.queue.empty() || stopped.load();
+        });
+        sleepers.fetch_sub(1);
+        l_self.sleeping.store(false);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkStealingRunner::runInstance(uint32_t p_worker, uint32_t p_index, const Sender& p_sender)
+{
+    Worker&        l_self     = *workers[p_worker];
+    Instance&      l_instance = instances[p_index];
+    CompiledModel& l_model    = *l_instance.model;
+    uint64_t       l_now      = now();
+
+    // A parked instance is checked without blocking the worker (Cf. EventLoop)
+    if(l_model.isParked())
+    {
+        if(!l_model.park(0))
+        {
+            l_self.wheel.schedule(p_index, toTick(l_now + poll_us));
+            return;
+        }
+        l_instance.deadline = l_now;
+    }
+
+    // A state following another without delay is due from the run of that one
+    uint64_t l_due      = max(l_instance.deadline, l_instance.last);
+    uint64_t l_lateness = (l_now > l_due) ? l_now - l_due : 0;
+    l_instance.last     = l_now;
+    l_self.statistics.steps++;
+    l_self.statistics.sum_lateness += l_lateness;
+    l_self.statistics.max_lateness  = max(l_self.statistics.max_lateness, l_lateness);
+
+    l_model.nextState();
+    p_sender(p_worker, p_index, l_model);
+    uint64_t l_delay = l_model.step();
+    l_instance.deadline += l_delay;
+
+    // Late by more than one period: the deadlines missed are not run at once
+    // (Cf. Scheduler::LATE_CATCH_UP)
+    if(l_delay && l_instance.deadline + l_delay <= l_now)
+    {
+        l_instance.deadline = l_now;
+    }
+
+    // The instance now belongs to the worker which ran it
+    if(l_model.isParked())
+    {
+        l_self.wheel.schedule(p_index, toTick(l_now + poll_us));
+    }
+    else if(l_instance.deadline <= l_now)
+    {
+        lock_guard<mutex> l_lock(l_self.mutex);
+        l_self.queue.push_back(p_index);
+    }
+    else
+    {
+        l_self.wheel.schedule(p_index, toTick(l_instance.deadline));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+bool WorkStealingRunner::steal(uint32_t p_worker)
+{
+    Worker& l_self = *workers[p_worker];
+    for(uint32_t i = 1; i < workers.size(); i++)
+    {
+        Worker& l_victim = *workers[(p_worker + i) % workers.size()];
+
+        // The victim keeps the front half of its queue (the instances it runs next)
+        scoped_lock<mutex, mutex> l_lock(l_self.mutex, l_victim.mutex);
+        size_t l_count = l_victim.queue.size() / 2;
+        if(!l_count)
+        {
+            continue;
+        }
+
+        l_self.queue.insert(l_self.queue.end(), l_victim.queue.end() - l_count, l_victim.queue.end());
+        l_victim.queue.erase(l_victim.queue.end() - l_count, l_victim.queue.end());
+        l_self.statistics.stolen += l_count;
+        return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkStealingRunner::wakeUp(uint32_t p_worker)
+{
+    // Counted first: a worker going to sleep either sees the backlog,
+    // or is seen sleeping
+    backlogs.fetch_add(1);
+    if(sleepers.load() == 0)
+    {
+        return;
+    }
+
+    for(uint32_t i = 1; i < workers.size(); i++)
+    {
+        Worker& l_worker = *workers[(p_worker + i) % workers.size()];
+        if(l_worker.sleeping.load())
+        {
+            lock_guard<mutex> l_lock(l_worker.mutex);
+            l_worker.wake.notify_one();
+            return;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkStealingRunner::pin(uint32_t p_worker)
+{
+#ifdef __linux__
+    // The worker goes on the p_worker-th core it is allowed to run on
+    cpu_set_t l_allowed;
+    if(sched_getaffinity(0, sizeof(l_allowed), &l_allowed) != 0 || CPU_COUNT(&l_allowed) <= 1)
+    {
+        return;
+    }
+
+    int l_rank = static_cast<int>(p_worker % static_cast<uint32_t>(CPU_COUNT(&l_allowed)));
+    for(int c = 0; c < CPU_SETSIZE; c++)
+    {
+        if(CPU_ISSET(c, &l_allowed) && l_rank-- == 0)
+        {
+            cpu_set_t l_core;
+            CPU_ZERO(&l_core);
+            CPU_SET(c, &l_core);
+            pthread_setaffinity_np(pthread_self(), sizeof(l_core), &l_core);
+            return;
+        }
+    }
+#else
+    (void)p_worker;
+#endif
+}
+
+} // namespace ModGen
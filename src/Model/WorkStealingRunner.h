@@ -0,0 +1,220 @@
+/*!
+ * @file   WorkStealingRunner.h
+ * @brief  Contains the runner spreading many compiled models
+ *         over several threads with work stealing.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#ifndef WORKSTEALINGRUNNER_MODELGENERATOR
+#define WORKSTEALINGRUNNER_MODELGENERATOR
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TimingWheel.h"
+
+namespace ModGen {
+
+class CompiledModel;
+
+/*!
+ * \brief The WorkStealingRunner class runs many instances of models (Cf.
+ *        CompiledModel) on several worker threads (one per core by default).
+ *
+ *        Every worker owns some instances: their deadlines are in its timing
+ *        wheel (Cf. EventLoop), and the instances due are put in its run queue.
+ *        A worker runs the instances of its queue (from the front); an idle
+ *        worker steals half of the queue of a busy one (from the back), and the
+ *        instances stolen then belong to the thief. The instances thus migrate
+ *        only between two states, and stay on the same worker as long as it
+ *        keeps up: the chatty instances get spread over the workers while the
+ *        quiet ones do not move. A worker with a backlog wakes up a sleeping one.
+ *        On Linux, every worker is pinned to a core (best effort).
+ */
+class WorkStealingRunner
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /*!
+     * \brief The function given an instance (index of the worker, index of the
+     *        instance and the instance) when it goes into a state. It is called by
+     *        every worker (concurrently) and encodes the messages of the state with
+     *        the generators of the instance (Cf. CompiledModel::encodeMessage): the
+     *        payloads of an instance do not depend on the worker running it.
+     */
+    typedef std::function<void(uint32_t, uint32_t, CompiledModel&)> Sender;
+
+    /*!
+     * \brief The Statistics struct holds the counters of a run.
+     */
+    struct Statistics
+    {
+        uint64_t steps;        /*!< Number of states run                      */
+        uint64_t stolen;       /*!< Number of instances stolen                */
+        uint64_t sleeps;       /*!< Number of times the worker slept          */
+        uint64_t max_lateness; /*!< Highest lateness of an instance (us)      */
+        uint64_t sum_lateness; /*!< Sum of the lateness of the instances (us) */
+    };
+
+    /*!
+     * \brief WorkStealingRunner default constructor (no instance,
+     *        one worker per core)
+     */
+    WorkStealingRunner();
+
+    WorkStealingRunner(const WorkStealingRunner&)            = delete;
+    WorkStealingRunner& operator=(const WorkStealingRunner&) = delete;
+
+    /*!
+     * \brief setup sets the workers and the timing parameters.
+     * \param p_workers the number of worker threads (0 for one per core).
+     * \param p_tick_us the tick of the wheels (us): the deadlines are rounded up to it.
+     * \param p_poll_us the period (us) at which the parked instances are checked.
+     */
+    void setup(uint32_t p_workers, uint64_t p_tick_us, uint64_t p_poll_us);
+
+    /*!
+     * \brief add adds an instance, run from its current state (owned by the
+     *        workers in turn). The model must outlive the runner (or be removed by clear).
+     * \param p_model the compiled model of the instance.
+     * \param p_start_us the time (us) from the beginning of the run at which
+     *        the instance starts.
+     * \return the index of the instance (given to the sender).
+     */
+    uint32_t add(CompiledModel& p_model, uint64_t p_start_us = 0);
+
+    /*!
+     * \brief clear removes every instance.
+     */
+    void clear();
+
+    /*!
+     * \brief size
+     * \return the number of instances.
+     */
+    std::size_t size() const { return instances.size(); }
+
+    /*!
+     * \brief getWorkersCount
+     * \return the number of worker threads.
+     */
+    uint32_t getWorkersCount() const { return static_cast<uint32_t>(workers.size()); }
+
+    /*!
+     * \brief run runs the instances on the workers until stop is called
+     *        or the duration is reached (the calling thread waits for them).
+     * \param p_sender the function given the messages of the instances.
+     * \param p_duration_us the duration (us) of the run, 0 for no limit.
+     */
+    void run(const Sender& p_sender, uint64_t p_duration_us);
+
+    /*!
+     * \brief stop makes run return (can be called from another thread
+     *        or from a signal handler).
+     */
+    void stop() { stopped.store(true); }
+
+    /*!
+     * \brief getStatistics
+     * \param p_worker the index of a worker.
+     * \return the counters of the worker for the last run.
+     */
+    const Statistics& getStatistics(uint32_t p_worker) const { return workers[p_worker]->statistics; }
+
+    /*!
+     * \brief getStatistics
+     * \return the counters of every worker for the last run, summed
+     *         (highest lateness of them all).
+     */
+    Statistics getStatistics() const;
+
+private:
+    /*!
+     * \brief The Instance struct is an instance run by the workers
+     *        (only used by the worker running it).
+     */
+    struct Instance
+    {
+        CompiledModel* model;    /*!< The compiled model               */
+        uint64_t       start;    /*!< Start of the instance (us)       */
+        uint64_t       last;     /*!< Time of its last state (us)      */
+        uint64_t       deadline; /*!< Deadline of its next state (us)  */
+    };
+
+    /*!
+     * \brief The Worker struct is a worker thread with its run queue.
+     */
+    struct Worker
+    {
+        std::mutex              mutex;      /*!< Protects the queue                   */
+        std::condition_variable wake;       /*!< Signaled when there is work to steal */
+        std::deque<uint32_t>    queue;      /*!< Instances due (stolen from the back) */
+        TimingWheel             wheel;      /*!< Deadlines of its instances (its own) */
+        std::atomic<bool>       sleeping;   /*!< The worker sleeps (Cf. wakeUp)       */
+        Statistics              statistics; /*!< Counters of the worker               */
+        std::thread             thread;     /*!< The worker thread                    */
+    };
+
+    /*!
+     * \brief now
+     * \return the time (us) since the beginning of the run.
+     */
+    uint64_t now() const;
+
+    /*!
+     * \brief toTick
+     * \return the first tick not before a time (us).
+     */
+    uint64_t toTick(uint64_t p_us) const { return (p_us + tick_us - 1) / tick_us; }
+
+    /*!
+     * \brief work is the loop of a worker thread.
+     */
+    void work(uint32_t p_worker, const Sender& p_sender, uint64_t p_duration_us);
+
+    /*!
+     * \brief runInstance runs the next state of a due instance, then
+     *        schedules it on the worker.
+     */
+    void runInstance(uint32_t p_worker, uint32_t p_index, const Sender& p_sender);
+
+    /*!
+     * \brief steal moves half of the queue of another worker to a worker.
+     * \return true if instances were stolen.
+     */
+    bool steal(uint32_t p_worker);
+
+    /*!
+     * \brief wakeUp wakes up a sleeping worker (other than p_worker) to steal work.
+     */
+    void wakeUp(uint32_t p_worker);
+
+    /*!
+     * \brief pin pins the calling thread to a core (Linux only).
+     */
+    static void pin(uint32_t p_worker);
+
+private:
+    std::vector<Instance>                instances; /*!< Instances, by index                      */
+    std::vector<std::unique_ptr<Worker>> workers;   /*!< Workers, by index                        */
+    uint64_t                             tick_us;   /*!< Tick of the wheels (us)                  */
+    uint64_t                             poll_us;   /*!< Poll period of the parked instances      */
+    Clock::time_point                    origin;    /*!< Beginning of the run                     */
+    std::atomic<uint64_t>                backlogs;  /*!< Number of backlogs signaled (Cf. wakeUp) */
+    std::atomic<uint32_t>                sleepers;  /*!< Number of workers sleeping               */
+    std::atomic<bool>                    stopped;   /*!< A stop has been requested                */
+};
+
+} // namespace ModGen
+
+#endif // WORKSTEALINGRUNNER_MODELGENERATOR
@@ -0,0 +1,249 @@
+/*!
+ * @file   FrameAggregator.cpp
+ * @brief  Implementations of the functions defined in \a FrameAggregator.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "FrameAggregator.h"
+#include "CompiledModel.h"
+#include "Exception.h"
+#include "Logger.h"
+#include "ModelInstance.h"
+#include "State.h"
+#include "time_util.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+FrameAggregator::FrameAggregator(SENDING_METHOD p_method,
+                                 uint32_t       p_maxSize,
+                                 uint64_t       p_timeout) :
+    method(SIMPLE),
+    maxSize(0),
+    timeout(0),
+    pending(),
+    ready(),
+    unused()
+{
+    setup(p_method, p_maxSize, p_timeout);
+}
+
+////////////////////////////////////////////////////////////////////////
+FrameAggregator::~FrameAggregator()
+{}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::setup(int32_t p_method, uint32_t p_maxSize, uint64_t p_timeout)
+{
+    if(p_method < SIMPLE || p_method > AUTO)
+    {
+        ERROR("Error - Unknown sending method " + to_string(p_method) + ".");
+        throw Exception::UnimplementedElement<SENDING_METHOD>(p_method);
+    }
+
+    method  = static_cast<SENDING_METHOD>(p_method);
+    maxSize = p_maxSize;
+    timeout = p_timeout;
+
+    reset();
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::reset()
+{
+    flush();
+    clearFrames();
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::addState(ModelInstance& p_model)
+{
+    poll();
+
+    State* l_state = p_model.getCurrState();
+    for(size_t i = 0; i < l_state->getMessagesCount(); i++)
+    {
+        addMessage(p_model.getCompiled(), l_state->getIndex(), i);
+    }
+
+    // The messages of a state are not packed with the following ones
+    if(method == SMART_MULTIPLEX)
+    {
+        flush();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::addMessages(CompiledModel& p_model)
+{
+    poll();
+
+    for(size_t i = 0; i < p_model.getMessagesCount(); i++)
+    {
+        addMessage(p_model, p_model.getCurrent(), i);
+    }
+
+    // The messages of a state are not packed with the following ones
+    if(method == SMART_MULTIPLEX)
+    {
+        flush();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::poll()
+{
+    if(method != AUTO || pending.empty())
+    {
+        return;
+    }
+
+    uint64_t l_now = TimeUtil::ellapsed_microseconds();
+    for(size_t i = 0; i < pending.size(); )
+    {
+        if(l_now - pending[i].created >= timeout)
+        {
+            release(i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t FrameAggregator::getTimeLeft() const
+{
+    if(method != AUTO || pending.empty())
+    {
+        return NO_TIMEOUT;
+    }
+
+    // The oldest frame is the first one to expire
+    uint64_t l_created = pending.front().created;
+    for(auto& l_frame: pending)
+    {
+        l_created = min(l_created, l_frame.created);
+    }
+
+    uint64_t l_ellapsed = TimeUtil::ellapsed_microseconds() - l_created;
+    return (l_ellapsed >= timeout) ? 0 : timeout - l_ellapsed;
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::flush()
+{
+    for(auto& l_frame: pending)
+    {
+        ready.push_back(move(l_frame));
+    }
+    pending.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::clearFrames()
+{
+    for(auto& l_frame: ready)
+    {
+        unused.push_back(move(l_frame));
+    }
+    ready.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::addMessage(CompiledModel& p_model, uint32_t p_state, size_t p_index)
+{
+    const ModelDefinition&        l_def   = *p_model.getDefinition();
+    uint32_t                      l_mesg  = l_def.getMessage(p_state, p_index);
+    uint32_t                      l_size  = l_def.getMessageSize(l_mesg);
+    const ModelDefinition::Route& l_route = l_def.getRoute(l_mesg);
+
+    if(method == SIMPLE)
+    {
+        ready.push_back(newFrame(l_route));
+        append(ready.back(), p_model, p_state, p_index, l_size);
+        return;
+    }
+
+    size_t l_index = 0;
+    while(l_index < pending.size() && !sameRoute(*pending[l_index].route, l_route))
+    {
+        l_index++;
+    }
+
+    // The message does not fit: the frame is sent as is
+    if(l_index < pending.size() && pending[l_index].data.size() + l_size > maxSize)
+    {
+        release(l_index);
+        l_index = pending.size();
+    }
+
+    if(l_index == pending.size())
+    {
+        pending.push_back(newFrame(l_route));
+    }
+
+    append(pending[l_index], p_model, p_state, p_index, l_size);
+
+    if(pending[l_index].data.size() >= maxSize)
+    {
+        release(l_index);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+Frame FrameAggregator::newFrame(const ModelDefinition::Route& p_route)
+{
+    Frame l_frame;
+    if(!unused.empty())
+    {
+        l_frame = move(unused.back());
+        unused.pop_back();
+        l_frame.data.clear();
+        l_frame.boundaries.clear();
+    }
+
+    l_frame.route   = &p_route;
+    l_frame.created = TimeUtil::ellapsed_microseconds();
+
+    return l_frame;
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::append(Frame& p_frame, CompiledModel& p_model, uint32_t p_state, size_t p_index, uint32_t p_size)
+{
+    size_t l_offset = p_frame.data.size();
+
+    p_frame.boundaries.push_back(static_cast<uint32_t>(l_offset));
+    p_frame.data.resize(l_offset + p_size);
+    p_model.encodeMessage(p_state, p_index, p_frame.data.data() + l_offset, p_size);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool FrameAggregator::sameRoute(const ModelDefinition::Route& p_first, const ModelDefinition::Route& p_second)
+{
+    // The routes of a definition are unique
+    return ( &p_first == &p_second ||
+             ( p_first.dst_port == p_second.dst_port              &&
+               p_first.src_port == p_second.src_port              &&
+               strcmp(p_first.dst_ip,    p_second.dst_ip)    == 0 &&
+               strcmp(p_first.src_ip,    p_second.src_ip)    == 0 &&
+               strcmp(p_first.interface, p_second.interface) == 0 )
+           );
+}
+
+////////////////////////////////////////////////////////////////////////
+void FrameAggregator::release(size_t p_index)
+{
+    ready.push_back(move(pending[p_index]));
+    pending.erase(pending.begin() + static_cast<ptrdiff_t>(p_index));
+}
+
+} // namespace ModGen
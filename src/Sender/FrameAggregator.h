@@ -0,0 +1,209 @@
+/*!
+ * @file   FrameAggregator.h
+ * @brief  Contains the aggregator packing the messages
+ *         emitted by the States into frames to be sent.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef FRAMEAGGREGATOR_MODELGENERATOR
+#define FRAMEAGGREGATOR_MODELGENERATOR
+
+#include <includes.h>
+#include <opt_util.h>
+
+#include "ModelDefinition.h"
+
+namespace ModGen {
+
+/*!
+ * \dir Sender
+ * The \b Sender directory holds the source files used to \n
+ * pack and send the messages built by the \e Model of the
+ * <b> ModelGenerator Library </b>.
+ */
+
+class CompiledModel;
+class ModelInstance;
+
+/*!
+ * \brief The Frame struct is a set of messages
+ *        sent together to the same destination.
+ */
+struct Frame
+{
+    std::vector<uint8_t>          data;       /*!< The packed messages                                 */
+    std::vector<uint32_t>         boundaries; /*!< Offset (bytes) of every message in data             */
+    const ModelDefinition::Route* route;      /*!< Source/destination of the messages of the frame     */
+    uint64_t                      created;    /*!< Time (us) at which the first message has been added */
+};
+
+/*!
+ * \brief The FrameAggregator class packs the messages of the states
+ *        into frames according to the sending method (Cf. display_help):
+ * <ul>
+ * <li> \a SIMPLE: Every message is sent in its own frame.
+ * <li> \a SMART_MULTIPLEX: The messages of a state sharing the same source and
+ *         destination are packed into frames up to the maximum size.
+ * <li> \a FULL_MULTIPLEX: The messages of consecutive states are packed into frames,
+ *         which are sent once the maximum size is reached.
+ * <li> \a AUTO: Same as \a FULL_MULTIPLEX but a frame is also sent once the
+ *         timeout has expired since its first message.
+ * </ul>
+ *        A message is never split: a message bigger than the maximum size
+ *        is sent in its own frame.
+ */
+class FrameAggregator
+{
+public:
+    /*!
+     * Enumerate of the available sending methods.
+     */
+    typedef enum {
+        SIMPLE          = 0, /*!< One message per frame                      */
+        SMART_MULTIPLEX = 1, /*!< Messages of a same state                   */
+        FULL_MULTIPLEX  = 2, /*!< Messages of consecutive states             */
+        AUTO            = 3  /*!< Consecutive states, flushed on timeout too */
+    } SENDING_METHOD;
+
+    static const uint64_t NO_TIMEOUT = UINT64_MAX; /*!< No pending frame (Cf. getTimeLeft) */
+
+    /*!
+     * \brief FrameAggregator constructor
+     * \param p_method the sending method.
+     * \param p_maxSize the maximum size (bytes) of a frame.
+     * \param p_timeout the timeout (us) of the AUTO method.
+     */
+    FrameAggregator(SENDING_METHOD p_method  = static_cast<SENDING_METHOD>(DEFAULT_SENDING_METHOD),
+                    uint32_t       p_maxSize = DEFAULT_FRAME_MAXSIZE,
+                    uint64_t       p_timeout = DEFAULT_AUTO_TIMEOUT);
+
+    /*!
+     * \brief ~FrameAggregator default destructor
+     */
+    ~FrameAggregator();
+
+    /*!
+     * \brief setup changes the parameters of the aggregator.
+     *        The pending and ready frames are dropped.
+     * \param p_method the sending method (Cf. SENDING_METHOD).
+     * \param p_maxSize the maximum size (bytes) of a frame.
+     * \param p_timeout the timeout (us) of the AUTO method.
+     */
+    void setup(int32_t p_method, uint32_t p_maxSize, uint64_t p_timeout);
+
+    /*!
+     * \brief reset drops the pending and ready frames
+     *        (Ex/ when the model they reference is cleared).
+     */
+    void reset();
+
+    /*!
+     * \brief addState packs the messages of the current state of a model,
+     *        encoded with its generators (Cf. ModelInstance::encodeMessage).
+     * \param p_model the model which messages are emitted.
+     */
+    void addState(ModelInstance& p_model);
+
+    /*!
+     * \brief addMessages packs the messages of the current state of an
+     *        instance of a compiled model (Cf. CompiledModel::getMessagesCount),
+     *        encoded with its generators.
+     * \param p_model the instance which messages are emitted.
+     */
+    void addMessages(CompiledModel& p_model);
+
+    /*!
+     * \brief poll makes ready the pending frames which timeout
+     *        has expired (AUTO method only).
+     */
+    void poll();
+
+    /*!
+     * \brief getTimeLeft
+     * \return the time (us) before the timeout of the first pending frame
+     *         expires (AUTO method only, Cf. poll) - 0 if it has expired,
+     *         NO_TIMEOUT if no frame waits for a timeout.
+     */
+    uint64_t getTimeLeft() const;
+
+    /*!
+     * \brief flush makes ready every pending frame.
+     */
+    void flush();
+
+    /*!
+     * \brief getFrames
+     * \return the frames ready to be sent.
+     */
+    std::vector<Frame>& getFrames() { return ready; }
+
+    /*!
+     * \brief clearFrames drops the frames ready to be sent
+     *        (their buffers are reused by the next frames).
+     */
+    void clearFrames();
+
+    /*!
+     * \brief getMethod
+     * \return the sending method in use.
+     */
+    SENDING_METHOD getMethod() const { return method; }
+
+    /*!
+     * \brief getPendingCount
+     * \return the number of frames waiting for more messages.
+     */
+    std::size_t getPendingCount() const { return pending.size(); }
+
+private:
+    /*!
+     * \brief addMessage packs a message according to the sending method.
+     * \param p_model the instance which message is emitted.
+     * \param p_state the index of the state of the message.
+     * \param p_index the index of the message in the state.
+     */
+    void addMessage(CompiledModel& p_model, uint32_t p_state, std::size_t p_index);
+
+    /*!
+     * \brief newFrame
+     * \param p_route the route of the messages of the frame.
+     * \return an empty frame (reusing a dropped buffer if possible).
+     */
+    Frame newFrame(const ModelDefinition::Route& p_route);
+
+    /*!
+     * \brief append encodes a message at the end of a frame.
+     * \param p_frame the frame to complete.
+     * \param p_model the instance which message is emitted.
+     * \param p_state the index of the state of the message.
+     * \param p_index the index of the message in the state.
+     * \param p_size the encoded size of the message.
+     */
+    static void append(Frame& p_frame, CompiledModel& p_model, uint32_t p_state, std::size_t p_index, uint32_t p_size);
+
+    /*!
+     * \brief sameRoute
+     * \return true if both routes use the same source, destination and interface.
+     */
+    static bool sameRoute(const ModelDefinition::Route& p_first, const ModelDefinition::Route& p_second);
+
+    /*!
+     * \brief release makes ready a pending frame.
+     * \param p_index the index of the frame in the pending frames.
+     */
+    void release(std::size_t p_index);
+
+private:
+    SENDING_METHOD     method;  /*!< The sending method in use                      */
+    uint32_t           maxSize; /*!< Maximum size (bytes) of a frame                */
+    uint64_t           timeout; /*!< Timeout (us) of the pending frames (AUTO only) */
+
+    std::vector<Frame> pending; /*!< Frames waiting for more messages               */
+    std::vector<Frame> ready;   /*!< Frames ready to be sent                        */
+    std::vector<Frame> unused;  /*!< Dropped frames which buffers can be reused     */
+};
+
+} // namespace ModGen
+
+#endif // FRAMEAGGREGATOR_MODELGENERATOR
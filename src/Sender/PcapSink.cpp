@@ -0,0 +1,241 @@
+/*!
+ * @file   PcapSink.cpp
+ * @brief  Implementations of the functions defined in \a PcapSink.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <cstring>
+
+#include "PcapSink.h"
+#include "UdpSender.h"
+#include "FrameAggregator.h"
+#include "Exception.h"
+#include "Logger.h"
+#include "time_util.h"
+
+namespace ModGen {
+
+using namespace std;
+
+/*!
+ * \brief The PcapFileHeader struct is the global header of a pcap file
+ *        (written in the byte order of the host, as expected by the readers).
+ */
+struct PcapFileHeader
+{
+    uint32_t magic;         /*!< 0xa1b2c3d4 - timestamps in microseconds */
+    uint16_t version_major; /*!< 2                                       */
+    uint16_t version_minor; /*!< 4                                       */
+    int32_t  thiszone;      /*!< GMT offset (unused)                     */
+    uint32_t sigfigs;       /*!< Timestamps accuracy (unused)            */
+    uint32_t snaplen;       /*!< Maximum length of the records           */
+    uint32_t network;       /*!< Link type (1 = Ethernet)                */
+};
+
+/*!
+ * \brief The PcapRecordHeader struct precedes every packet of a pcap file.
+ */
+struct PcapRecordHeader
+{
+    uint32_t ts_sec;        /*!< Timestamp (seconds)                     */
+    uint32_t ts_usec;       /*!< Timestamp (microseconds)                */
+    uint32_t incl_len;      /*!< Number of bytes saved in the file       */
+    uint32_t orig_len;      /*!< Actual length of the packet             */
+};
+
+static const uint32_t PCAP_SNAPLEN = 65535;
+
+////////////////////////////////////////////////////////////////////////
+static inline void writeU16(uint8_t* p_data, uint32_t p_value)
+{
+    p_data[0] = static_cast<uint8_t>(p_value >> 8);
+    p_data[1] = static_cast<uint8_t>(p_value);
+}
+
+////////////////////////////////////////////////////////////////////////
+PcapSink::PcapSink() :
+    file(),
+    buffer(),
+    headers(),
+    ip_id(0),
+    frames(0),
+    bytes(0)
+{}
+
+////////////////////////////////////////////////////////////////////////
+PcapSink::~PcapSink()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////
+void PcapSink::open(const string&          p_filePath,
+                    const ModelDefinition& p_definition)
+{
+    close();
+
+    headers.clear();
+    for(size_t i = 0; i < p_definition.getRoutesCount(); i++)
+    {
+        headers[&p_definition.getRoutes()[i]] = buildHeaders(p_definition.getRoutes()[i]);
+    }
+
+    file.open(p_filePath, ios::out | ios::binary | ios::trunc);
+    if(!file.is_open())
+    {
+        ERROR("Error - PcapSink - Unable to create the file " + p_filePath + ".");
+        throw Exception::OutputFileError("Unable to create the file " + p_filePath);
+    }
+
+    PcapFileHeader l_header = { 0xa1b2c3d4, 2, 4, 0, 0, PCAP_SNAPLEN, 1 };
+
+    buffer.reserve(BUFFER_SIZE);
+    buffer.resize(sizeof(l_header));
+    memcpy(buffer.data(), &l_header, sizeof(l_header));
+
+    ip_id  = 0;
+    frames = 0;
+    bytes  = sizeof(l_header);
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t PcapSink::write(const vector<Frame>& p_frames)
+{
+    return write(p_frames, TimeUtil::microseconds());
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t PcapSink::write(const vector<Frame>& p_frames, uint64_t p_time_us)
+{
+    size_t l_written = 0;
+    for(auto& l_frame: p_frames)
+    {
+        auto l_headers = headers.find(l_frame.route);
+        if(l_headers == headers.end())
+        {
+            ERROR("Error - PcapSink - No route to " + string(l_frame.route->dst_ip) + ":"
+                                                    + to_string(l_frame.route->dst_port) + ".");
+            continue;
+        }
+
+        uint32_t l_orig = static_cast<uint32_t>(HEADERS_SIZE + l_frame.data.size());
+        uint32_t l_incl = min(l_orig, PCAP_SNAPLEN);
+
+        PcapRecordHeader l_record = { static_cast<uint32_t>(p_time_us / 1000000),
+                                      static_cast<uint32_t>(p_time_us % 1000000),
+                                      l_incl,
+                                      l_orig };
+
+        if(buffer.size() + sizeof(l_record) + l_incl > BUFFER_SIZE)
+        {
+            flush();
+        }
+
+        size_t l_offset = buffer.size();
+        buffer.resize(l_offset + sizeof(l_record) + l_incl);
+
+        uint8_t* l_data = buffer.data() + l_offset;
+        memcpy(l_data, &l_record, sizeof(l_record));
+        l_data += sizeof(l_record);
+
+        // Lengths are clipped: such a frame cannot be sent over UDP anyway
+        uint32_t l_ipLen  = min<uint32_t>(l_orig - 14, 0xFFFF);
+        uint32_t l_udpLen = min<uint32_t>(l_orig - 34, 0xFFFF);
+        memcpy(l_data, l_headers->second.data(), HEADERS_SIZE);
+        writeU16(l_data + 16, l_ipLen);
+        writeU16(l_data + 18, ip_id++);
+        writeU16(l_data + 24, checksum(l_data + 14));
+        writeU16(l_data + 38, l_udpLen);
+        memcpy(l_data + HEADERS_SIZE, l_frame.data.data(), l_incl - HEADERS_SIZE);
+
+        bytes += sizeof(l_record) + l_incl;
+        l_written++;
+    }
+
+    frames += l_written;
+    return l_written;
+}
+
+////////////////////////////////////////////////////////////////////////
+void PcapSink::flush()
+{
+    if(!file.is_open() || buffer.empty())
+    {
+        return;
+    }
+
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<streamsize>(buffer.size()));
+    if(!file)
+    {
+        ERROR("Error - PcapSink - Unable to write the capture file.");
+        throw Exception::OutputFileError("Unable to write the capture file");
+    }
+    buffer.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+void PcapSink::close()
+{
+    if(file.is_open())
+    {
+        flush();
+        file.close();
+    }
+    buffer.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+PcapSink::Headers PcapSink::buildHeaders(const ModelDefinition::Route& p_route)
+{
+    sockaddr_in l_src = UdpSender::resolve(p_route.src_ip, p_route.src_port);
+    sockaddr_in l_dst = UdpSender::resolve(p_route.dst_ip, p_route.dst_port);
+
+    Headers l_headers;
+    l_headers.fill(0);
+    uint8_t* l_data = l_headers.data();
+
+    // Ethernet - 02:00:<ip> (locally administered)
+    l_data[0] = 0x02;
+    memcpy(l_data + 2, &l_dst.sin_addr, 4);
+    l_data[6] = 0x02;
+    memcpy(l_data + 8, &l_src.sin_addr, 4);
+    writeU16(l_data + 12, 0x0800);
+
+    // IPv4 - no options, Don't Fragment, TTL 64, UDP
+    uint8_t* l_ip = l_data + 14;
+    l_ip[0] = 0x45;
+    writeU16(l_ip + 6, 0x4000);
+    l_ip[8] = 64;
+    l_ip[9] = 17;
+    memcpy(l_ip + 12, &l_src.sin_addr, 4);
+    memcpy(l_ip + 16, &l_dst.sin_addr, 4);
+
+    // UDP - no checksum
+    uint8_t* l_udp = l_ip + 20;
+    memcpy(l_udp,     &l_src.sin_port, 2);
+    memcpy(l_udp + 2, &l_dst.sin_port, 2);
+
+    return l_headers;
+}
+
+////////////////////////////////////////////////////////////////////////
+uint16_t PcapSink::checksum(const uint8_t* p_header)
+{
+    uint32_t l_sum = 0;
+    for(size_t i = 0; i < 20; i += 2)
+    {
+        if(i != 10)
+        {
+            l_sum += (static_cast<uint32_t>(p_header[i]) << 8) | p_header[i + 1];
+        }
+    }
+    while(l_sum >> 16)
+    {
+        l_sum = (l_sum & 0xFFFF) + (l_sum >> 16);
+    }
+
+    return static_cast<uint16_t>(~l_sum);
+}
+
+} // namespace ModGen
@@ -0,0 +1,132 @@
+/*!
+ * @file   PcapSink.h
+ * @brief  Contains the sink writing the frames
+ *         (Cf. FrameAggregator.h) to a pcap capture file.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef PCAPSINK_MODELGENERATOR
+#define PCAPSINK_MODELGENERATOR
+
+#include <array>
+#include <fstream>
+#include <unordered_map>
+
+#include <includes.h>
+
+#include "ModelDefinition.h"
+
+namespace ModGen {
+
+struct Frame;
+
+/*!
+ * \brief The PcapSink class writes the frames into a pcap file
+ *        (Ethernet link type) instead of sending them.
+ *
+ *        Every frame is wrapped into synthetic Ethernet/IPv4/UDP headers built
+ *        from the addressing of its messages (the MAC addresses are locally
+ *        administered addresses derived from the IPs). The records are timestamped
+ *        with the clock of the model and written by large blocks.
+ */
+class PcapSink
+{
+public:
+    static const std::size_t HEADERS_SIZE = 14 + 20 + 8;     /*!< Ethernet + IPv4 + UDP headers   */
+    static const std::size_t BUFFER_SIZE  = 1024 * 1024;     /*!< Size of the blocks written      */
+
+    /*!
+     * \brief PcapSink default constructor
+     */
+    PcapSink();
+
+    /*!
+     * \brief ~PcapSink default destructor (closes the file).
+     */
+    ~PcapSink();
+
+    /*!
+     * \brief open creates the capture file and prepares the headers of the routes
+     *        of the messages. The previous file is closed.
+     * \param p_filePath the path of the pcap file.
+     * \param p_definition the compiled model (Cf. ModelDefinition::getRoutes),
+     *        which must outlive the capture.
+     * \throw Exception::OutputFileError if the file cannot be created.
+     */
+    void open(const std::string&     p_filePath,
+              const ModelDefinition& p_definition);
+
+    /*!
+     * \brief write adds the frames to the capture.
+     * \param p_frames the frames to write (Cf. FrameAggregator::getFrames).
+     * \param p_time_us the timestamp (us since epoch) of the frames.
+     * \return the number of frames written.
+     */
+    std::size_t write(const std::vector<Frame>& p_frames, uint64_t p_time_us);
+
+    /*!
+     * \brief write adds the frames to the capture, timestamped
+     *        with the clock of the model.
+     * \param p_frames the frames to write (Cf. FrameAggregator::getFrames).
+     * \return the number of frames written.
+     */
+    std::size_t write(const std::vector<Frame>& p_frames);
+
+    /*!
+     * \brief flush writes the buffered records to the file.
+     */
+    void flush();
+
+    /*!
+     * \brief close flushes and closes the file.
+     */
+    void close();
+
+    /*!
+     * \brief isOpened
+     * \return true if a capture file is opened.
+     */
+    bool isOpened() const { return file.is_open(); }
+
+    /*!
+     * \brief getFramesCount
+     * \return the number of frames written since open.
+     */
+    uint64_t getFramesCount() const { return frames; }
+
+    /*!
+     * \brief getBytesCount
+     * \return the number of bytes written since open (headers included).
+     */
+    uint64_t getBytesCount()  const { return bytes;  }
+
+private:
+    typedef std::array<uint8_t, HEADERS_SIZE> Headers;
+
+    /*!
+     * \brief buildHeaders
+     * \return the headers of the route - lengths, id and checksum
+     *         are completed for every frame.
+     */
+    static Headers buildHeaders(const ModelDefinition::Route& p_route);
+
+    /*!
+     * \brief checksum
+     * \return the IPv4 checksum of the header.
+     */
+    static uint16_t checksum(const uint8_t* p_header);
+
+private:
+    std::ofstream                                file;    /*!< The capture file                         */
+    std::vector<uint8_t>                         buffer;  /*!< The records waiting to be written        */
+    std::unordered_map<const ModelDefinition::Route*, Headers>
+                                                 headers; /*!< Pre-built headers of every route         */
+    uint16_t                                     ip_id;   /*!< Identification of the next IPv4 packet   */
+    uint64_t                                     frames;  /*!< Number of frames written                 */
+    uint64_t                                     bytes;   /*!< Number of bytes written                  */
+};
+
+} // namespace ModGen
+
+#endif // PCAPSINK_MODELGENERATOR
@@ -0,0 +1,327 @@
+/*!
+ * @file   UdpSender.cpp
+ * @brief  Implementations of the functions defined in \a UdpSender.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#endif
+
+#include "UdpSender.h"
+#include "FrameAggregator.h"
+#include "Exception.h"
+#include "Logger.h"
+
+namespace ModGen {
+
+using namespace std;
+
+#ifdef _WIN32
+////////////////////////////////////////////////////////////////////////
+static int lastError()
+{
+    return WSAGetLastError();
+}
+
+////////////////////////////////////////////////////////////////////////
+static string errorText(int p_error)
+{
+    return "error " + to_string(p_error);
+}
+
+////////////////////////////////////////////////////////////////////////
+static void closeSocket(SOCKET p_socket)
+{
+    closesocket(p_socket);
+}
+#else
+static const int INVALID_SOCKET = -1; /*!< Returned by socket on failure */
+
+////////////////////////////////////////////////////////////////////////
+static int lastError()
+{
+    return errno;
+}
+
+////////////////////////////////////////////////////////////////////////
+static string errorText(int p_error)
+{
+    return strerror(p_error);
+}
+
+////////////////////////////////////////////////////////////////////////
+static void closeSocket(int p_socket)
+{
+    ::close(p_socket);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////
+UdpSender::UdpSender() :
+    sockets(),
+    routes(),
+#ifdef __linux__
+    headers(),
+    iovecs(),
+#endif
+    frames(0),
+    syscalls(0),
+    errors(0)
+{
+#ifdef _WIN32
+    // Winsock is initialized for every sender (the system counts them)
+    WSADATA l_data;
+    WSAStartup(MAKEWORD(2, 2), &l_data);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////
+UdpSender::~UdpSender()
+{
+    close();
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////
+void UdpSender::setup(const ModelDefinition& p_definition)
+{
+    close();
+
+    for(size_t i = 0; i < p_definition.getRoutesCount(); i++)
+    {
+        const ModelDefinition::Route& l_compiled = p_definition.getRoutes()[i];
+
+        Route l_route;
+        l_route.dst    = resolve(l_compiled.dst_ip, l_compiled.dst_port);
+        l_route.socket = openSocket(l_compiled.src_ip, l_compiled.src_port, l_compiled.interface);
+
+        routes[&l_compiled] = l_route;
+    }
+
+    DEBUG("UdpSender - " + to_string(sockets.size()) + " socket(s) opened for "
+                         + to_string(routes.size())  + " route(s).");
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t UdpSender::send(const vector<Frame>& p_frames)
+{
+    for(size_t i = 0; i < p_frames.size(); i++)
+    {
+        auto l_route = routes.find(p_frames[i].route);
+        if(l_route == routes.end())
+        {
+            ERROR("Error - UdpSender - No route to " + string(p_frames[i].route->dst_ip) + ":"
+                                                     + to_string(p_frames[i].route->dst_port) + ".");
+            errors++;
+            continue;
+        }
+        sockets[l_route->second.socket].pending.push_back(i);
+    }
+
+    size_t l_sent = 0;
+    for(auto& l_socket: sockets)
+    {
+        if(!l_socket.pending.empty())
+        {
+            l_sent += sendPending(l_socket, p_frames);
+            l_socket.pending.clear();
+        }
+    }
+
+    frames += l_sent;
+    return l_sent;
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t UdpSender::sendPending(Socket& p_socket, const vector<Frame>& p_frames)
+{
+    size_t l_count = p_socket.pending.size();
+
+#ifdef __linux__
+    // The iovecs must be complete before the headers point to them
+    iovecs.resize(l_count);
+    for(size_t i = 0; i < l_count; i++)
+    {
+        auto& l_frame      = p_frames[p_socket.pending[i]];
+        iovecs[i].iov_base = const_cast<uint8_t*>(l_frame.data.data());
+        iovecs[i].iov_len  = l_frame.data.size();
+    }
+
+    headers.resize(l_count);
+    for(size_t i = 0; i < l_count; i++)
+    {
+        Route& l_route = routes[p_frames[p_socket.pending[i]].route];
+
+        memset(&headers[i], 0, sizeof(mmsghdr));
+        headers[i].msg_hdr.msg_name    = &l_route.dst;
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        headers[i].msg_hdr.msg_iov     = &iovecs[i];
+        headers[i].msg_hdr.msg_iovlen  = 1;
+    }
+
+    size_t l_sent  = 0;
+    size_t l_first = 0;
+    while(l_first < l_count)
+    {
+        int l_res = sendmmsg(p_socket.fd, &headers[l_first], static_cast<unsigned int>(l_count - l_first), 0);
+        syscalls++;
+        if(l_res < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            // The first frame cannot be sent: the following ones are still tried
+            ERROR("Error - UdpSender - sendmmsg failed (" + errorText(errno) + ").");
+            errors++;
+            l_first++;
+            continue;
+        }
+        l_sent  += static_cast<size_t>(l_res);
+        l_first += static_cast<size_t>(l_res);
+    }
+
+    return l_sent;
+#else
+    size_t l_sent = 0;
+    for(size_t i = 0; i < l_count; i++)
+    {
+        auto&  l_frame = p_frames[p_socket.pending[i]];
+        Route& l_route = routes[l_frame.route];
+
+        long l_res = sendto(p_socket.fd, reinterpret_cast<const char*>(l_frame.data.data()),
+                            static_cast<int>(l_frame.data.size()), 0,
+                            reinterpret_cast<const sockaddr*>(&l_route.dst), sizeof(sockaddr_in));
+        syscalls++;
+        if(l_res < 0)
+        {
+            ERROR("Error - UdpSender - sendto failed (" + errorText(lastError()) + ").");
+            errors++;
+            continue;
+        }
+        l_sent++;
+    }
+
+    return l_sent;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////
+void UdpSender::close()
+{
+    for(auto& l_socket: sockets)
+    {
+        closeSocket(l_socket.fd);
+    }
+    sockets.clear();
+    routes.clear();
+
+    frames   = 0;
+    syscalls = 0;
+    errors   = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+sockaddr_in UdpSender::resolve(const string& p_ip, uint32_t p_port)
+{
+    sockaddr_in l_addr;
+    memset(&l_addr, 0, sizeof(l_addr));
+    l_addr.sin_family = AF_INET;
+    l_addr.sin_port   = htons(static_cast<uint16_t>(p_port));
+
+    if(p_ip.empty())
+    {
+        l_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        return l_addr;
+    }
+
+    if(inet_pton(AF_INET, p_ip.c_str(), &l_addr.sin_addr) == 1)
+    {
+        return l_addr;
+    }
+
+    // Not a numeric address: resolve the host name
+    addrinfo  l_hints;
+    addrinfo* l_res = nullptr;
+    memset(&l_hints, 0, sizeof(l_hints));
+    l_hints.ai_family   = AF_INET;
+    l_hints.ai_socktype = SOCK_DGRAM;
+
+    int l_err = getaddrinfo(p_ip.c_str(), nullptr, &l_hints, &l_res);
+    if(l_err != 0 || !l_res)
+    {
+        ERROR("Error - UdpSender - Unable to resolve the address " + p_ip + ".");
+        throw Exception::SocketError("Unable to resolve the address " + p_ip, EINVAL);
+    }
+    l_addr.sin_addr = reinterpret_cast<sockaddr_in*>(l_res->ai_addr)->sin_addr;
+    freeaddrinfo(l_res);
+
+    return l_addr;
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t UdpSender::openSocket(const string& p_ip,
+                             uint32_t      p_port,
+                             const string& p_interface)
+{
+    for(size_t i = 0; i < sockets.size(); i++)
+    {
+        if(sockets[i].src_port  == p_port &&
+           sockets[i].src_ip    == p_ip   &&
+           sockets[i].interface == p_interface)
+        {
+            return i;
+        }
+    }
+
+    Socket l_socket;
+    l_socket.src_ip    = p_ip;
+    l_socket.src_port  = p_port;
+    l_socket.interface = p_interface;
+    l_socket.fd        = socket(AF_INET, SOCK_DGRAM, 0);
+    if(l_socket.fd == INVALID_SOCKET)
+    {
+        ERROR("Error - UdpSender - Unable to create a socket.");
+        throw Exception::SocketError("Unable to create a socket", lastError());
+    }
+
+    int l_reuse = 1;
+    setsockopt(l_socket.fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&l_reuse), sizeof(l_reuse));
+
+#ifdef SO_BINDTODEVICE
+    if(!p_interface.empty() &&
+       setsockopt(l_socket.fd, SOL_SOCKET, SO_BINDTODEVICE, p_interface.c_str(),
+                  static_cast<socklen_t>(p_interface.size())) < 0)
+    {
+        int l_errno = errno;
+        closeSocket(l_socket.fd);
+        ERROR("Error - UdpSender - Unable to bind a socket to the interface " + p_interface + ".");
+        throw Exception::SocketError("Unable to bind a socket to the interface " + p_interface, l_errno);
+    }
+#endif
+
+    sockaddr_in l_src = resolve(p_ip, p_port);
+    if(bind(l_socket.fd, reinterpret_cast<const sockaddr*>(&l_src), sizeof(l_src)) < 0)
+    {
+        int l_errno = lastError();
+        closeSocket(l_socket.fd);
+        ERROR("Error - UdpSender - Unable to bind a socket to " + p_ip + ":" + to_string(p_port) + ".");
+        throw Exception::SocketError("Unable to bind a socket to " + p_ip + ":" + to_string(p_port), l_errno);
+    }
+
+    sockets.push_back(l_socket);
+    return sockets.size() - 1;
+}
+
+} // namespace ModGen
@@ -0,0 +1,164 @@
+/*!
+ * @file   UdpSender.h
+ * @brief  Contains the sender writing the frames
+ *         (Cf. FrameAggregator.h) to UDP sockets.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef UDPSENDER_MODELGENERATOR
+#define UDPSENDER_MODELGENERATOR
+
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+#include <includes.h>
+
+#include "ModelDefinition.h"
+
+namespace ModGen {
+
+struct Frame;
+
+/*!
+ * \brief The UdpSender class sends the frames to the destination
+ *        of their messages.
+ *
+ *        The addresses of every route of the messages are resolved once (Cf. setup) and
+ *        a bound UDP socket is kept for every (source ip, source port, interface).
+ *        The frames sent through a same socket are written with a single
+ *        <em>sendmmsg</em> call (one <em>sendto</em> per frame on systems without it).
+ */
+class UdpSender
+{
+public:
+    /*!
+     * \brief UdpSender default constructor
+     */
+    UdpSender();
+
+    /*!
+     * \brief ~UdpSender default destructor (closes the sockets).
+     */
+    ~UdpSender();
+
+    /*!
+     * \brief setup resolves the routes of the messages and opens the sockets.
+     *        The previous sockets are closed.
+     * \param p_definition the compiled model (Cf. ModelDefinition::getRoutes),
+     *        which must outlive the sender setup.
+     * \throw Exception::SocketError if an address cannot be resolved or
+     *        a socket cannot be bound.
+     */
+    void setup(const ModelDefinition& p_definition);
+
+    /*!
+     * \brief send writes the frames to their destination.
+     * \param p_frames the frames to send (Cf. FrameAggregator::getFrames).
+     * \return the number of frames successfully sent.
+     */
+    std::size_t send(const std::vector<Frame>& p_frames);
+
+    /*!
+     * \brief close closes every socket.
+     */
+    void close();
+
+    /*!
+     * \brief getFramesCount
+     * \return the number of frames sent since setup.
+     */
+    uint64_t getFramesCount()   const { return frames;   }
+
+    /*!
+     * \brief getSyscallsCount
+     * \return the number of system calls used to send the frames since setup.
+     */
+    uint64_t getSyscallsCount() const { return syscalls; }
+
+    /*!
+     * \brief getErrorsCount
+     * \return the number of frames which could not be sent since setup.
+     */
+    uint64_t getErrorsCount()   const { return errors;   }
+
+    /*!
+     * \brief resolve converts an ip (or host name) and a port to an address.
+     * \param p_ip the ip or host name (any address if empty).
+     * \param p_port the port.
+     * \return the resolved IPv4 address.
+     * \throw Exception::SocketError if the address cannot be resolved.
+     */
+    static sockaddr_in resolve(const std::string& p_ip, uint32_t p_port);
+
+private:
+#ifdef _WIN32
+    typedef SOCKET Handle; /*!< Socket of the system */
+#else
+    typedef int    Handle; /*!< Socket of the system */
+#endif
+
+    /*!
+     * \brief The Socket struct is a bound socket and
+     *        the frames to send through it.
+     */
+    struct Socket
+    {
+        Handle                fd;        /*!< File descriptor of the socket             */
+        std::string           src_ip;    /*!< Source ip the socket is bound to          */
+        uint32_t              src_port;  /*!< Source port the socket is bound to        */
+        std::string           interface; /*!< Network interface the socket is bound to  */
+        std::vector<std::size_t>
+                              pending;   /*!< Index of the frames to send               */
+    };
+
+    /*!
+     * \brief The Route struct is the resolved addressing of a route of the messages.
+     */
+    struct Route
+    {
+        std::size_t           socket;    /*!< Index of the socket to use                */
+        sockaddr_in           dst;       /*!< Destination address                       */
+    };
+
+    /*!
+     * \brief openSocket
+     * \return the index of the socket bound to the specified source
+     *         (the socket is created if needed).
+     */
+    std::size_t openSocket(const std::string& p_ip,
+                           uint32_t           p_port,
+                           const std::string& p_interface);
+
+    /*!
+     * \brief sendPending sends the pending frames of a socket.
+     * \return the number of frames successfully sent.
+     */
+    std::size_t sendPending(Socket& p_socket, const std::vector<Frame>& p_frames);
+
+private:
+    std::vector<Socket>                        sockets;  /*!< The bound sockets                            */
+    std::unordered_map<const ModelDefinition::Route*, Route>
+                                               routes;   /*!< Resolved addressing of every route           */
+
+#ifdef __linux__
+    std::vector<mmsghdr>                       headers;  /*!< Headers of the batched frames (reused)       */
+    std::vector<iovec>                         iovecs;   /*!< Data of the batched frames (reused)          */
+#endif
+
+    uint64_t                                   frames;   /*!< Number of frames sent                        */
+    uint64_t                                   syscalls; /*!< Number of system calls used to send frames   */
+    uint64_t                                   errors;   /*!< Number of frames which could not be sent     */
+};
+
+} // namespace ModGen
+
+#endif // UDPSENDER_MODELGENERATOR
@@ -15,10 +15,17 @@ namespace ModGen {
 #define DEFAULT_CONF_FILEPATH "./Conf/conf_test.xml" /*!< Fichier de conf par défaut          */
 #define DEFAULT_LOGS_FILEPATH "./Logs/default_logs"  /*!< Fichier de logs par défaut          */
 #define DEFAULT_LOGS_TRACEVAL 0                      /*!< Valeur de trace des logs par défaut */
+#define DEFAULT_SENDING_METHOD 0                     /*!< Méthode d'envoi par défaut (SIMPLE) */
+#define DEFAULT_AUTO_TIMEOUT  1000000                /*!< Timeout (us) du mode AUTO           */
+#define DEFAULT_FRAME_MAXSIZE 100                    /*!< Taille max (octets) d'une trame     */
+#define DEFAULT_SPIN_TAIL     0                      /*!< Attente active (us) avant échéance  */
+#define DEFAULT_LATE_POLICY   0                      /*!< Politique des échéances dépassées   */
+#define PARK_SLICE_US         100000                 /*!< Attente (us) max d'un état parqué   */
+#define VIRTUAL_STALL_STATES  100000                 /*!< États sans délai max (temps virtuel)*/
 
 inline void display_help()
 {
-    std::cout << "\nUsage modelGenerator <-c -e> [-l -t -T -S]"                          << std::endl;
+    std::cout << "\nUsage modelGenerator <-c -e> [-l -t -T -S -p -s -L -V -B -C]"                 << std::endl;
     std::cout << "---Available options---"                                               << std::endl;
     std::cout << "====Required===="                                                      << std::endl;
     std::cout << "\t-c 'conf_filePath' : The configuration file path."                   << std::endl;
@@ -32,13 +39,34 @@ inline void display_help()
               << DEFAULT_LOGS_TRACEVAL << ")"                                            << std::endl;
     std::cout << "\t ( '-1':No logs | 0':Errors only | '1':Errors && infos | '2':Errors && infos && debug)" 
                                                                                          << std::endl;                             
-    std::cout << "\t-T 'timeout': The timeout value in us for the AUTO mode. (Default = 1e6 = 1s)"
+    std::cout << "\t-T 'timeout': The timeout value in us for the AUTO mode. (Default = "
+              << DEFAULT_AUTO_TIMEOUT << " = 1s)"
                                                                                          << std::endl; 
-    std::cout << "\t-S 'max size': The maximum frame size in bytes for the AUTO mode. (Default = 100 bytes)"
+    std::cout << "\t-S 'max size': The maximum frame size in bytes for the multiplex and AUTO modes. (Default = "
+              << DEFAULT_FRAME_MAXSIZE << " bytes)"
+                                                                                         << std::endl;
+    std::cout << "\t-p 'pcap_filePath': Write the frames into a pcap file instead of sending them."
+                                                                                         << std::endl;
+    std::cout << "\t-s 'spin': Time in us spent spinning before each deadline for sub-10us accuracy. (Default = "
+              << DEFAULT_SPIN_TAIL << ")"                                                << std::endl;
+    std::cout << "\t-L 'late_policy': The behaviour when a deadline has already passed. (Default = "
+              << DEFAULT_LATE_POLICY << ")"                                              << std::endl;
+    std::cout << "\t ( '0':Catch up | '1':Skip missed periods | '2':Rebase on current time)"
+                                                                                         << std::endl;
+    std::cout << "\t-V 'duration': Run the given number of seconds of the model in virtual time (as fast as possible)."
+                                                                                         << std::endl;
+    std::cout << "\t ( stopped with an error after " << VIRTUAL_STALL_STATES << " states without any delay: the clock would not advance)"
+                                                                                         << std::endl;
+    std::cout << "\t-B : Write the logs in binary (rendered as text by ModelGeneratorLogDecoder)."
+                                                                                         << std::endl;
+    std::cout << "\t-C 'cache_filePath': Map the compiled model from this binary image instead of loading the configuration file, (re)built when it changes."
                                                                                          << std::endl;
     std::cout << "====Examples===="                                                      << std::endl;                                                                                                                                                                                                                                                                   
     std::cout << "\t./modelSender -c /home/user/conf.xml -e 1 -l ./logs -t 1"            << std::endl;
-    std::cout << "\t./modelSender -e 3 -T 1000 -S 2500\n"                                << std::endl;
+    std::cout << "\t./modelSender -e 3 -T 1000 -S 2500"                                  << std::endl;
+    std::cout << "\t./modelSender -e 0 -p ./trace.pcap -V 3600"                          << std::endl;
+    std::cout << "\t./modelSender -e 0 -l ./logs.bin -t 2 -B"                            << std::endl;
+    std::cout << "\t./modelSender -c /home/user/conf.xml -e 0 -C /tmp/conf.cache\n"      << std::endl;
 }
 
 } // namespace ModGen
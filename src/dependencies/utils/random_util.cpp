@@ -0,0 +1,219 @@
+/*!
+ * @file   random_util.cpp
+ * @brief  Contains the implementation of the strucures defined
+ *         in \a random_util.h
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define RANDOM_UTIL_SSE2
+#endif
+
+#include "random_util.h"
+
+namespace ModGen {
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+static inline uint64_t splitmix64(uint64_t& p_state)
+{
+    uint64_t l_z = (p_state += 0x9E3779B97F4A7C15ULL);
+    l_z = (l_z ^ (l_z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    l_z = (l_z ^ (l_z >> 27)) * 0x94D049BB133111EBULL;
+    return l_z ^ (l_z >> 31);
+}
+
+////////////////////////////////////////////////////////////////////////
+static inline uint64_t rotl(uint64_t p_x, int p_k)
+{
+    return (p_x << p_k) | (p_x >> (64 - p_k));
+}
+
+////////////////////////////////////////////////////////////////////////
+RandomGenerator::RandomGenerator()
+{
+    seed(randomSeed());
+}
+
+////////////////////////////////////////////////////////////////////////
+RandomGenerator::RandomGenerator(uint64_t p_seed)
+{
+    seed(p_seed);
+}
+
+////////////////////////////////////////////////////////////////////////
+RandomGenerator::RandomGenerator(const uint32_t* p_state)
+{
+    load(p_state);
+}
+
+////////////////////////////////////////////////////////////////////////
+uint64_t RandomGenerator::randomSeed()
+{
+    random_device l_device;
+    uint64_t l_seed = (static_cast<uint64_t>(l_device()) << 32) ^ l_device();
+    return l_seed ^ static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count());
+}
+
+////////////////////////////////////////////////////////////////////////
+void RandomGenerator::seed(uint64_t p_seed)
+{
+    // The state of each lane is expanded from the seed (never all zeros)
+    for(size_t i = 0; i < LANES; i++)
+    {
+        s0[i] = splitmix64(p_seed);
+        s1[i] = splitmix64(p_seed);
+        s2[i] = splitmix64(p_seed);
+        s3[i] = splitmix64(p_seed);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+void RandomGenerator::save(uint32_t* p_state) const
+{
+    static_assert(sizeof(s0) * 4 == STATE_WORDS * sizeof(uint32_t), "The state is four words per lane");
+
+    memcpy(p_state,                 s0, sizeof(s0));
+    memcpy(p_state +     LANES * 2, s1, sizeof(s1));
+    memcpy(p_state + 2 * LANES * 2, s2, sizeof(s2));
+    memcpy(p_state + 3 * LANES * 2, s3, sizeof(s3));
+}
+
+////////////////////////////////////////////////////////////////////////
+void RandomGenerator::load(const uint32_t* p_state)
+{
+    memcpy(s0, p_state,                 sizeof(s0));
+    memcpy(s1, p_state +     LANES * 2, sizeof(s1));
+    memcpy(s2, p_state + 2 * LANES * 2, sizeof(s2));
+    memcpy(s3, p_state + 3 * LANES * 2, sizeof(s3));
+}
+
+////////////////////////////////////////////////////////////////////////
+void RandomGenerator::fill(uint8_t* p_data, size_t p_size)
+{
+    while(p_size >= BLOCK_SIZE)
+    {
+        step(p_data);
+        p_data += BLOCK_SIZE;
+        p_size -= BLOCK_SIZE;
+    }
+
+    if(p_size)
+    {
+        uint8_t l_block[BLOCK_SIZE];
+        step(l_block);
+        memcpy(p_data, l_block, p_size);
+    }
+}
+
+#if defined(__AVX2__)
+
+////////////////////////////////////////////////////////////////////////
+static inline __m256i rotl(__m256i p_x, int p_k)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(p_x, p_k), _mm256_srli_epi64(p_x, 64 - p_k));
+}
+
+////////////////////////////////////////////////////////////////////////
+void RandomGenerator::step(uint8_t* p_out)
+{
+    __m256i l_s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s0));
+    __m256i l_s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s1));
+    __m256i l_s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s2));
+    __m256i l_s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s3));
+
+    // rotl(s1 * 5, 7) * 9 - multiplications as shifts (no 64-bits mullo in AVX2)
+    __m256i l_res = _mm256_add_epi64(_mm256_slli_epi64(l_s1, 2), l_s1);
+    l_res = rotl(l_res, 7);
+    l_res = _mm256_add_epi64(_mm256_slli_epi64(l_res, 3), l_res);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out), l_res);
+
+    __m256i l_t = _mm256_slli_epi64(l_s1, 17);
+    l_s2 = _mm256_xor_si256(l_s2, l_s0);
+    l_s3 = _mm256_xor_si256(l_s3, l_s1);
+    l_s1 = _mm256_xor_si256(l_s1, l_s2);
+    l_s0 = _mm256_xor_si256(l_s0, l_s3);
+    l_s2 = _mm256_xor_si256(l_s2, l_t);
+    l_s3 = rotl(l_s3, 45);
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s0), l_s0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s1), l_s1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s2), l_s2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s3), l_s3);
+}
+
+#elif defined(RANDOM_UTIL_SSE2)
+
+////////////////////////////////////////////////////////////////////////
+static inline __m128i rotl(__m128i p_x, int p_k)
+{
+    return _mm_or_si128(_mm_slli_epi64(p_x, p_k), _mm_srli_epi64(p_x, 64 - p_k));
+}
+
+////////////////////////////////////////////////////////////////////////
+void RandomGenerator::step(uint8_t* p_out)
+{
+    // Two lanes per register
+    for(size_t i = 0; i < LANES; i += 2)
+    {
+        __m128i l_s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(s0 + i));
+        __m128i l_s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(s1 + i));
+        __m128i l_s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(s2 + i));
+        __m128i l_s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(s3 + i));
+
+        __m128i l_res = _mm_add_epi64(_mm_slli_epi64(l_s1, 2), l_s1);
+        l_res = rotl(l_res, 7);
+        l_res = _mm_add_epi64(_mm_slli_epi64(l_res, 3), l_res);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p_out + i * 8), l_res);
+
+        __m128i l_t = _mm_slli_epi64(l_s1, 17);
+        l_s2 = _mm_xor_si128(l_s2, l_s0);
+        l_s3 = _mm_xor_si128(l_s3, l_s1);
+        l_s1 = _mm_xor_si128(l_s1, l_s2);
+        l_s0 = _mm_xor_si128(l_s0, l_s3);
+        l_s2 = _mm_xor_si128(l_s2, l_t);
+        l_s3 = rotl(l_s3, 45);
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(s0 + i), l_s0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s1 + i), l_s1);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s2 + i), l_s2);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s3 + i), l_s3);
+    }
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////
+void RandomGenerator::step(uint8_t* p_out)
+{
+    for(size_t i = 0; i < LANES; i++)
+    {
+        // Stored little-endian so that every implementation gives the same bytes
+        uint64_t l_res = rotl(s1[i] * 5, 7) * 9;
+        for(size_t j = 0; j < 8; j++)
+        {
+            p_out[i * 8 + j] = static_cast<uint8_t>(l_res >> (8 * j));
+        }
+
+        uint64_t l_t = s1[i] << 17;
+        s2[i] ^= s0[i];
+        s3[i] ^= s1[i];
+        s1[i] ^= s2[i];
+        s0[i] ^= s3[i];
+        s2[i] ^= l_t;
+        s3[i]  = rotl(s3[i], 45);
+    }
+}
+
+#endif
+
+} // namespace ModGen
@@ -0,0 +1,97 @@
+/*!
+ * @file   random_util.h
+ * @brief  Contains the pseudo-random generator used to
+ *         fill the DATA part of the messages.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#ifndef RANDOM_UTIL_MODELGENERATOR
+#define RANDOM_UTIL_MODELGENERATOR
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ModGen {
+
+/*!
+ * \brief The RandomGenerator class implements four interleaved
+ *        <em>xoshiro256**</em> generators filling 32 bytes per step.
+ *
+ *        The lanes are computed with AVX2 (if the library is built with it),
+ *        SSE2 or plain 64-bits arithmetic: the three implementations produce
+ *        the same sequence, so a seeded generator is reproducible on any build.
+ */
+class RandomGenerator {
+
+public:
+    static const std::size_t LANES      = 4;               /*!< Number of interleaved generators */
+    static const std::size_t BLOCK_SIZE = LANES * 8;       /*!< Number of bytes produced per step */
+    static const std::size_t STATE_WORDS = LANES * 8;      /*!< Size (32-bits words) of the state (Cf. save) */
+
+    /*!
+     * \brief RandomGenerator default constructor
+     *        (seeded with a non-deterministic value).
+     */
+    RandomGenerator();
+
+    /*!
+     * \brief RandomGenerator constructor.
+     * \param p_seed the seed of the generator.
+     */
+    explicit RandomGenerator(uint64_t p_seed);
+
+    /*!
+     * \brief RandomGenerator constructor of a generator saved by \a save.
+     * \param p_state the STATE_WORDS words of the state (no alignment required).
+     */
+    explicit RandomGenerator(const uint32_t* p_state);
+
+    /*!
+     * \brief seed resets the generator.
+     * \param p_seed the seed to use.
+     */
+    void seed(uint64_t p_seed);
+
+    /*!
+     * \brief fill writes random bytes into the requested buffer.
+     * \param p_data the buffer to fill.
+     * \param p_size the number of bytes to write.
+     */
+    void fill(uint8_t* p_data, std::size_t p_size);
+
+    /*!
+     * \brief save copies the state of the generator, so that it can be kept
+     *        outside of it (Ex/ in the runtime block of an instance).
+     * \param p_state the STATE_WORDS words to write (no alignment required).
+     */
+    void save(uint32_t* p_state) const;
+
+    /*!
+     * \brief load restores a state copied by \a save.
+     * \param p_state the STATE_WORDS words of the state.
+     */
+    void load(const uint32_t* p_state);
+
+    /*!
+     * \brief randomSeed
+     * \return a non-deterministic seed.
+     */
+    static uint64_t randomSeed();
+
+private:
+    /*!
+     * \brief step advances every lane and writes BLOCK_SIZE bytes.
+     * \param p_out the destination (no alignment required).
+     */
+    void step(uint8_t* p_out);
+
+    alignas(32) uint64_t s0[LANES]; /*!< First word of the state of every lane  */
+    alignas(32) uint64_t s1[LANES]; /*!< Second word of the state of every lane */
+    alignas(32) uint64_t s2[LANES]; /*!< Third word of the state of every lane  */
+    alignas(32) uint64_t s3[LANES]; /*!< Fourth word of the state of every lane */
+};
+
+} // namespace ModGen
+
+#endif  /* RANDOM_UTIL_MODELGENERATOR */
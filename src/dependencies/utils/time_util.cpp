@@ -120,6 +120,8 @@ uint64_t TimeUtil::hour_millisec   = 3600000;
 uint64_t TimeUtil::utc_coeff       = 7200000;
 uint64_t TimeUtil::utc_coeff_micro = 7200000000;
 
+thread_local TimeUtil::VirtualTime TimeUtil::virtual_time = { false, 0, 0, 0 };
+
 ////////////////////////////////////////////////////////////////////////
 uint64_t TimeUtil::day_milliseconds()
 {
@@ -135,6 +137,11 @@ uint64_t TimeUtil::day_microseconds()
 ////////////////////////////////////////////////////////////////////////
 uint64_t TimeUtil::milliseconds()
 {
+    if(virtual_time.enabled)
+    {
+        return (virtual_time.start + virtual_time.offset) / 1000;
+    }
+
     return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>
               (std::chrono::high_resolution_clock::now().time_since_epoch()).count());
 }
@@ -142,6 +149,11 @@ uint64_t TimeUtil::milliseconds()
 ////////////////////////////////////////////////////////////////////////
 uint64_t TimeUtil::microseconds()
 {
+    if(virtual_time.enabled)
+    {
+        return virtual_time.start + virtual_time.offset;
+    }
+
     return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>
               (std::chrono::high_resolution_clock::now().time_since_epoch()).count());
 }
@@ -149,6 +161,11 @@ uint64_t TimeUtil::microseconds()
 ////////////////////////////////////////////////////////////////////////
 uint64_t TimeUtil::ellapsed_seconds()
 {
+  if(virtual_time.enabled)
+  {
+    return (virtual_time.ellapsed + virtual_time.offset) / 1000000;
+  }
+
   TimePoint l_end = std::chrono::high_resolution_clock::now();
   return  std::chrono::duration_cast<std::chrono::seconds>(l_end-time_ref).count();
 }
@@ -156,6 +173,11 @@ uint64_t TimeUtil::ellapsed_seconds()
 ////////////////////////////////////////////////////////////////////////
 uint64_t TimeUtil::ellapsed_milliseconds()
 {
+  if(virtual_time.enabled)
+  {
+    return (virtual_time.ellapsed + virtual_time.offset) / 1000;
+  }
+
   TimePoint l_end = std::chrono::high_resolution_clock::now();
   return  std::chrono::duration_cast<std::chrono::milliseconds>(l_end-time_ref).count();
 }
@@ -163,6 +185,11 @@ uint64_t TimeUtil::ellapsed_milliseconds()
 ////////////////////////////////////////////////////////////////////////
 uint64_t TimeUtil::ellapsed_microseconds()
 {
+  if(virtual_time.enabled)
+  {
+    return (virtual_time.ellapsed + virtual_time.offset);
+  }
+
   TimePoint l_end = std::chrono::high_resolution_clock::now();
   return  std::chrono::duration_cast<std::chrono::microseconds>(l_end-time_ref).count();
 }
@@ -181,6 +208,16 @@ uint64_t TimeUtil::hhr_diane_since_start()
   return l_diane.toInt();
 }
 
+////////////////////////////////////////////////////////////////////////
+void TimeUtil::startVirtual(uint64_t p_start_us)
+{
+  virtual_time.enabled  = false;
+  virtual_time.ellapsed = TimeUtil::ellapsed_microseconds();
+  virtual_time.start    = p_start_us;
+  virtual_time.offset   = 0;
+  virtual_time.enabled  = true;
+}
+
 ////////////////////////////////////////////////////////////////////////
 std::string TimeUtil::currentTime()
 {
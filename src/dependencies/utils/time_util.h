@@ -172,7 +172,51 @@ public:
      */
     static std::string currentTime();
 
+    /*!
+     * \brief startVirtual makes the calling thread read a virtual clock
+     *        instead of the system clock (except for \a currentTime).
+     *        The virtual clock only moves when advanced (Cf. advanceVirtual),
+     *        so that a model can be run faster than real time.
+     * \param p_start_us the start time (us since epoch) of the virtual clock.
+     */
+    static void startVirtual(uint64_t p_start_us);
+
+    /*!
+     * \brief stopVirtual makes the calling thread read the system clock again.
+     */
+    static void stopVirtual() { virtual_time.enabled = false; }
+
+    /*!
+     * \brief isVirtual
+     * \return true if the calling thread reads a virtual clock.
+     */
+    static bool isVirtual() { return virtual_time.enabled; }
+
+    /*!
+     * \brief advanceVirtual moves the virtual clock of the calling thread forward.
+     * \param p_us the duration (us) to advance the clock by.
+     */
+    static void advanceVirtual(uint64_t p_us) { virtual_time.offset += p_us; }
+
+    /*!
+     * \brief virtual_microseconds
+     * \return the number of microseconds the virtual clock was advanced by.
+     */
+    static uint64_t virtual_microseconds() { return virtual_time.offset; }
+
 private:
+    /*!
+     * \brief The VirtualTime struct is the virtual clock of a thread.
+     */
+    struct VirtualTime
+    {
+        bool     enabled;   /*!< The thread reads the virtual clock              */
+        uint64_t start;     /*!< Start time (us since epoch)                     */
+        uint64_t ellapsed;  /*!< Time ellapsed (us) since start of the software  */
+        uint64_t offset;    /*!< Time (us) the clock was advanced by             */
+    };
+
+    static thread_local VirtualTime virtual_time; /*!< Virtual clock of the calling thread                          */
     static TimePoint time_ref;       /*!< Software time reference (initialized at start of the software)              */
     static int64_t  utc_hours;       /*!< Number of hours of offset in UTC time (Ex/ France is UTC -1)                */
     static uint64_t hour_millisec;   /*!< Number of milliseconds in an hour                                           */
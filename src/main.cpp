@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <csignal>
 #include <pugixml.hpp>
@@ -7,11 +8,16 @@
 #include <Model.h>
 #include <version.h>
 #include <State.h>
+#include <FrameAggregator.h>
+#include <UdpSender.h>
+#include <PcapSink.h>
+#include <time_util.h>
+
+static volatile std::sig_atomic_t VG_signal = 0; /*!< Signal which stopped the model (0 while running) */
 
 void signal_handler(int32_t p_signalNum)
 {
-    ModGen::INFO("Prgramm ended by the user (signal - " + std::to_string(p_signalNum) + ")");
-    exit(p_signalNum);
+    VG_signal = p_signalNum;
 }
 
 int main(int argc, char **argv)
@@ -20,11 +26,20 @@ int main(int argc, char **argv)
     std::string l_conf_file      {DEFAULT_CONF_FILEPATH};
     std::string l_logs_file      {DEFAULT_LOGS_FILEPATH};
     int         l_logs_traceLevel{DEFAULT_LOGS_TRACEVAL};
+    int         l_sending_method {DEFAULT_SENDING_METHOD};
+    uint64_t    l_auto_timeout   {DEFAULT_AUTO_TIMEOUT};
+    uint32_t    l_frame_maxSize  {DEFAULT_FRAME_MAXSIZE};
+    std::string l_pcap_file;
+    uint64_t    l_spin_tail      {DEFAULT_SPIN_TAIL};
+    int         l_late_policy    {DEFAULT_LATE_POLICY};
+    uint64_t    l_virtual_time   {0};
+    bool        l_binary_logs    {false};
+    std::string l_cache_file;
 
     // Register the signals and the signal handler to the app
     std::signal(SIGINT, signal_handler);
 
-    while((l_cmd_value = getopt(argc, argv, "c:l:h:t:")) != -1)
+    while((l_cmd_value = getopt(argc, argv, "c:l:h:t:e:T:S:p:s:L:V:BC:")) != -1)
     {
         switch(l_cmd_value)
         {
@@ -59,19 +74,184 @@ int main(int argc, char **argv)
             }
             l_logs_traceLevel = strtol(optarg, static_cast<char **>(nullptr), 10);
             break;
+        case 'e':
+            if(!optarg)
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-e) Sending method not properly set");
+            }
+            l_sending_method = strtol(optarg, static_cast<char **>(nullptr), 10);
+            break;
+        case 'T':
+            if(!optarg)
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-T) Timeout not properly set");
+            }
+            l_auto_timeout = strtoull(optarg, static_cast<char **>(nullptr), 10);
+            break;
+        case 'S':
+            if(!optarg)
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-S) Maximum frame size not properly set");
+            }
+            l_frame_maxSize = static_cast<uint32_t>(strtoul(optarg, static_cast<char **>(nullptr), 10));
+            break;
+        case 'p':
+            if(optarg)
+            {
+                l_pcap_file = optarg;
+            }
+            else
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-p) Capture file not properly set");
+            }
+            break;
+        case 's':
+            if(!optarg)
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-s) Spinning time not properly set");
+            }
+            l_spin_tail = strtoull(optarg, static_cast<char **>(nullptr), 10);
+            break;
+        case 'L':
+            if(!optarg)
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-L) Late deadlines policy not properly set");
+            }
+            l_late_policy = strtol(optarg, static_cast<char **>(nullptr), 10);
+            break;
+        case 'V':
+            if(!optarg)
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-V) Virtual time duration not properly set");
+            }
+            l_virtual_time = strtoull(optarg, static_cast<char **>(nullptr), 10) * 1000000;
+            break;
+        case 'B':
+            l_binary_logs = true;
+            break;
+        case 'C':
+            if(optarg)
+            {
+                l_cache_file = optarg;
+            }
+            else
+            {
+                throw ModGen::Exception::CommandLineArgsError("(-C) Cache file not properly set");
+            }
+            break;
         }
     }
 
+    ModGen::Logger::setBinary(l_binary_logs);
     ModGen::Logger::setup(l_logs_file, static_cast<ModGen::Logger::TRACELEVELS>(l_logs_traceLevel));
+    ModGen::Model::setCache(l_cache_file);
     ModGen::Model::setup(l_conf_file);
     ModGen::Model::log();
+    ModGen::Model::getScheduler().setup(l_spin_tail, l_late_policy);
 
-    while(1)
+    ModGen::FrameAggregator l_aggregator;
+    l_aggregator.setup(l_sending_method, l_frame_maxSize, l_auto_timeout);
+
+    ModGen::UdpSender l_sender;
+    ModGen::PcapSink  l_pcap;
+    if(l_pcap_file.empty())
+    {
+        l_sender.setup(*ModGen::Model::getInstance().getDefinition());
+    }
+    else
+    {
+        l_pcap.open(l_pcap_file, *ModGen::Model::getInstance().getDefinition());
+    }
+
+    // The delays advance a virtual clock instead of being waited
+    if(l_virtual_time)
     {
-        ModGen::State* l_currState = ModGen::Model::getNextState();
-        ModGen::INFO(l_currState->getId());
-        auto l_currMesgs = l_currState->getMessages();
-        l_currState->runOperations();
-        l_currState->runTransitions();
+        ModGen::TimeUtil::startVirtual(ModGen::TimeUtil::microseconds());
     }
+
+    // The frames ready are written to the capture file or sent
+    auto l_send = [&]()
+    {
+        if(l_pcap.isOpened())
+        {
+            l_pcap.write(l_aggregator.getFrames());
+        }
+        else
+        {
+            l_sender.send(l_aggregator.getFrames());
+        }
+        l_aggregator.clearFrames();
+    };
+
+    // The frames whose timeout expires while the model waits are not kept
+    // until the next state (AUTO method): the waits are cut at their timeouts
+    auto l_poll = [&]() -> uint64_t
+    {
+        l_aggregator.poll();
+        if(!l_aggregator.getFrames().empty())
+        {
+            l_send();
+        }
+        return l_aggregator.getTimeLeft();
+    };
+
+    // The automaton is run on its compiled form (Cf. CompiledModel)
+    ModGen::CompiledModel& l_model   = ModGen::Model::getCompiled();
+    uint64_t               l_clock   = 0; // Virtual clock at the last state
+    uint64_t               l_stalled = 0; // States run since it advanced
+    while(!VG_signal && (!l_virtual_time || ModGen::TimeUtil::virtual_microseconds() < l_virtual_time))
+    {
+        // A cycle of states without delay never reaches the virtual duration
+        if(l_virtual_time)
+        {
+            l_stalled = (ModGen::TimeUtil::virtual_microseconds() == l_clock) ? l_stalled + 1 : 0;
+            l_clock   = ModGen::TimeUtil::virtual_microseconds();
+            if(l_stalled >= VIRTUAL_STALL_STATES)
+            {
+                break;
+            }
+        }
+
+        uint32_t l_state = l_model.nextState();
+        LOG_RECORD(ModGen::Logger::ERRORS_INFO, ModGen::LOG_FMT_STATE, l_model.getStateName(l_state));
+        l_aggregator.addMessages(l_model);
+        LOG_RECORD(ModGen::Logger::ERRORS_INFO_DEBUG, ModGen::LOG_FMT_FRAMES, l_aggregator.getFrames().size());
+        l_send();
+        ModGen::Model::getScheduler().wait(l_model.step(), l_poll);
+
+        // An idle waiting state blocks until its variables change (the stop
+        // requests and the timeouts of the frames are checked between slices);
+        // the deadlines restart after it
+        if(l_model.isParked())
+        {
+            while(!VG_signal && !l_model.park(std::min<uint64_t>(PARK_SLICE_US, l_poll())))
+            {
+            }
+            ModGen::Model::getScheduler().start();
+        }
+    }
+
+    // The pending frames are not lost
+    l_aggregator.flush();
+    l_send();
+    if(l_pcap.isOpened())
+    {
+        l_pcap.close();
+    }
+
+    if(l_stalled >= VIRTUAL_STALL_STATES)
+    {
+        ERROR("Error - The virtual clock stopped at " + std::to_string(l_clock) + "us: "
+              + std::to_string(VIRTUAL_STALL_STATES) + " states were run without any delay.");
+        return 1;
+    }
+
+    if(l_virtual_time && !VG_signal)
+    {
+        INFO("Programm ended after " + std::to_string(l_virtual_time / 1000000) + "s of virtual time");
+        return 0;
+    }
+
+    INFO("Prgramm ended by the user (signal - " + std::to_string(VG_signal) + ")");
+    return VG_signal;
 }
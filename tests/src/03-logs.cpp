@@ -12,6 +12,8 @@
 #include <cstdio>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <modelGenerator_interface.h>
 
@@ -107,4 +109,121 @@ TEST_CASE( "Logger writing function works correctly", "[logs]" )
 
     	std::remove(l_fileName.c_str()); 
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Logger writes the messages of several threads", "[logs]" ) 
+{
+	std::string l_fileName = "03-logs.txt";
+	std::remove(l_fileName.c_str());
+
+	SECTION("Every message is written or counted as dropped") 
+	{
+		const size_t l_threads  = 4;
+		const size_t l_messages = 20000;
+
+		LOGS::setup(l_fileName, 2);
+
+		std::vector<std::thread> l_writers;
+		for(size_t t = 0; t < l_threads; t++)
+		{
+			l_writers.emplace_back([t, l_messages]() {
+				for(size_t i = 0; i < l_messages; i++)
+				{
+					LOGS::write("Thread " + std::to_string(t) + " message " + std::to_string(i), 1);
+				}
+			});
+		}
+		for(auto& l_writer: l_writers) { l_writer.join(); }
+
+		LOGS::flush();
+		uint64_t l_drops = LOGS::getDropCount();
+		LOGS::close();
+
+		// The first line is written by the setup
+		size_t        l_lines = 0;
+		std::string   l_line;
+		std::ifstream l_file(l_fileName);
+		while(std::getline(l_file, l_line))
+		{
+			if(l_line.find(":: Thread ") != std::string::npos) { l_lines++; }
+		}
+
+		REQUIRE( l_lines + l_drops == l_threads * l_messages );
+
+		std::remove(l_fileName.c_str());
+	}
+
+	SECTION("Long messages are truncated") 
+	{
+		LOGS::setup(l_fileName, 2);
+		LOGS::write(std::string(1000, 'x'), 1);
+		LOGS::flush();
+		REQUIRE( LOGS::getOverflowCount() == 1 );
+		LOGS::close();
+
+		std::string   l_line, l_res;
+		std::ifstream l_file(l_fileName);
+		while(std::getline(l_file, l_line))
+		{
+			if(l_line.find('x') != std::string::npos) { l_res = l_line; }
+		}
+		REQUIRE( l_res.find(std::string(100, 'x')) != std::string::npos );
+		REQUIRE( l_res.size() < 1000 );
+
+		std::remove(l_fileName.c_str());
+	}
+}
+
+TEST_CASE( "Binary logs are decoded as text logs", "[logs]" ) 
+{
+	std::string l_binFile  = "03-logs.bin";
+	std::string l_textFile = "03-logs-decoded.txt";
+	std::remove(l_binFile.c_str());
+
+	SECTION("Decoded messages") 
+	{
+		LOGS::setBinary(true);
+		LOGS::setup(l_binFile, 2);
+		LOGS::write("First binary message", 1);
+		LOGS::write("Second binary message", 2);
+		LOGS::write("Not logged", 3);
+		LOGS::close();
+		LOGS::setBinary(false);
+
+		// The first message is written by the setup (if the information
+		// messages are compiled in, Cf. LOG_LEVEL_MAX)
+		std::vector<std::string> l_expected;
+#if LOG_LEVEL_MAX >= 1
+		l_expected.push_back("ms:: Log file set to " + l_binFile);
+#endif
+		l_expected.push_back("ms:: First binary message");
+		l_expected.push_back("ms:: Second binary message");
+
+		REQUIRE( LOGS::decode(l_binFile, l_textFile) == l_expected.size() );
+
+		std::vector<std::string> l_lines;
+		std::string              l_line;
+		std::ifstream            l_file(l_textFile);
+		while(std::getline(l_file, l_line)) { l_lines.push_back(l_line); }
+
+		REQUIRE( l_lines.size() == l_expected.size() );
+		for(size_t i = 0; i < l_expected.size(); i++)
+		{
+			CHECK( l_lines[i].find(l_expected[i]) != std::string::npos );
+		}
+
+		std::remove(l_textFile.c_str());
+	}
+
+	SECTION("Text logs are not decoded") 
+	{
+		LOGS::setup(l_binFile, 2);
+		LOGS::write("A text message", 1);
+		LOGS::close();
+
+		CHECK_THROWS( LOGS::decode(l_binFile, l_textFile) );
+		std::remove(l_textFile.c_str());
+	}
+
+	std::remove(l_binFile.c_str());
+}
@@ -11,9 +11,12 @@
 
 #include <catch.hpp>
 #include <stdbool.h>
+#include <chrono>
 #include <cstdio>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include <modelGenerator_interface.h>
@@ -44,6 +47,22 @@ TEST_CASE( "Model creation is working correctly", "[model]" )
 		CHECK_NOTHROW( MODEL::create("./data/minimal_ok.xml") );
 	}
 
+	SECTION("Comments and CDATA sections are skipped up to their end")
+	{
+		std::ifstream     l_source("./data/minimal_ok.xml");
+		std::stringstream l_xml;
+		l_xml << l_source.rdbuf();
+
+		// The ends are preceded by their first characters
+		std::string l_conf("./skipped_model.xml");
+		std::string l_model = l_xml.str();
+		l_model.insert(l_model.find("<Conf>") + 6, "<!-- Comment ending with a dash --->"
+		                                           "<![CDATA[ Section ending with a bracket ]]]>");
+		std::ofstream(l_conf) << l_model;
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		std::remove(l_conf.c_str());
+	}
+
 	SECTION("Correct fileName but not properly formatted XML")
 	{
 		CHECK_THROWS(  MODEL::create("./data/wrong_xml.xml") );
@@ -60,7 +79,183 @@ TEST_CASE( "Model creation is working correctly", "[model]" )
 	}
 }
 
-TEST_CASE( "Model running functions work correctly", "[model]" ) 
+TEST_CASE( "Configuration sections can be in any order", "[model]" )
+{
+	std::vector<std::string> l_states_w =
+		{ "ETAT_A", "ETAT_B", "ETAT_C",
+		  "ETAT_B", "ETAT_D", "ETAT_D"
+		};
+
+	SECTION("References to the sections defined later are resolved")
+	{
+		CHECK_NOTHROW( MODEL::create("./data/running_unordered.xml") );
+
+		for(unsigned i = 0; i < l_states_w.size(); i++)
+		{
+			MODEL::nextState();
+			REQUIRE( MODEL::currentStateString() == l_states_w[i] );
+			REQUIRE( MODEL::getMessagesDstPort() == std::vector<uint32_t>({ i ? 3333u : 2222u }) );
+			MODEL::runOperations();
+			MODEL::runTransitions();
+		}
+	}
+
+	SECTION("Undefined references are still detected")
+	{
+		CHECK_THROWS( MODEL::create("./data/unknown_variable.xml") );
+	}
+
+	SECTION("Names defined twice are detected")
+	{
+		std::ifstream     l_source("./data/minimal_ok.xml");
+		std::stringstream l_xml;
+		l_xml << l_source.rdbuf();
+
+		std::string l_conf("./duplicate_model.xml");
+		std::string l_state = l_xml.str();
+		l_state.replace(l_state.find("name=\"ETAT_B\""), 13, "name=\"ETAT_A\"");
+		std::ofstream(l_conf) << l_state;
+		CHECK_THROWS( MODEL::create(l_conf) );
+
+		std::string l_header = l_xml.str();
+		l_header.replace(l_header.find("</Headers>"), 10, "<Header name=\"HEADER_1\"><Field name=\"F\" pos=\"0\" size=\"8\" value=\"1\""
+		                                                  " endianness=\"LE\" swap=\"FALSE\" invert=\"FALSE\"/></Header></Headers>");
+		std::ofstream(l_conf) << l_header;
+		CHECK_THROWS( MODEL::create(l_conf) );
+
+		CHECK_NOTHROW( MODEL::create("./data/minimal_ok.xml") );
+		std::remove(l_conf.c_str());
+	}
+}
+
+TEST_CASE( "Models are loaded from their binary image", "[model]" )
+{
+	std::string l_conf ("./cache_model.xml");
+	std::string l_cache("./cache_model.cache");
+
+	std::ifstream     l_source("./data/running_ok.xml");
+	std::stringstream l_xml;
+	l_xml << l_source.rdbuf();
+	std::ofstream(l_conf) << l_xml.str();
+	std::remove(l_cache.c_str());
+
+	MODEL::setCache(l_cache);
+
+	SECTION("The image is built then used")
+	{
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		REQUIRE( std::ifstream(l_cache).good() );
+
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		std::vector<std::string> l_states_w = { "ETAT_A", "ETAT_B", "ETAT_C", "ETAT_B", "ETAT_D" };
+		for(unsigned i = 0; i < l_states_w.size(); i++)
+		{
+			MODEL::nextState();
+			REQUIRE( MODEL::currentStateString() == l_states_w[i] );
+			REQUIRE( MODEL::getMessagesDstPort() == std::vector<uint32_t>({ i ? 3333u : 2222u }) );
+			MODEL::runOperations();
+			MODEL::runTransitions();
+		}
+	}
+
+	SECTION("The image is rebuilt when the configuration file changes")
+	{
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+
+		std::string l_changed = l_xml.str();
+		l_changed.replace(l_changed.find("port_dst=\"2222\""), 15, "port_dst=\"4444\"");
+		std::ofstream(l_conf) << l_changed;
+
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		MODEL::nextState();
+		REQUIRE( MODEL::getMessagesDstPort() == std::vector<uint32_t>({ 4444 }) );
+	}
+
+	SECTION("The file is not read while its size and time are unchanged")
+	{
+		// A time too recent is not recorded in the image (the file is hashed)
+		auto l_time = std::filesystem::last_write_time(l_conf) - std::chrono::hours(1);
+		std::filesystem::last_write_time(l_conf, l_time);
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+
+		std::ofstream(l_conf) << std::string(l_xml.str().size(), ' ');
+		std::filesystem::last_write_time(l_conf, l_time);
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		CHECK_NOTHROW( MODEL::getVariable("FLIP_FLOP") );
+
+		// Any other time: the file is hashed (and loaded)
+		std::filesystem::last_write_time(l_conf, l_time + std::chrono::seconds(1));
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		CHECK_THROWS( MODEL::getVariable("FLIP_FLOP") );
+	}
+
+	SECTION("The states are only loaded from the configuration file when used")
+	{
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+
+		// The variables come with the compiled model
+		MODEL::VARIABLE l_flipFlop = MODEL::getVariable("FLIP_FLOP");
+		REQUIRE( MODEL::getVariableValue(l_flipFlop) == 0 );
+
+		std::string l_changed = l_xml.str();
+		l_changed.replace(l_changed.find("\"ETAT_A\""), 8, "\"ETAT_Z\"");
+		std::ofstream(l_conf) << l_changed;
+		CHECK_THROWS( MODEL::nextState() );
+
+		std::ofstream(l_conf) << l_xml.str();
+		CHECK_NOTHROW( MODEL::nextState() );
+		REQUIRE( MODEL::currentStateString() == "ETAT_A" );
+	}
+
+	SECTION("An invalid image is rebuilt")
+	{
+		std::ofstream(l_cache) << "MGCACHE - not an image";
+
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "ETAT_A" );
+
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "ETAT_A" );
+	}
+
+	MODEL::setCache("");
+	std::remove(l_conf.c_str());
+	std::remove(l_cache.c_str());
+}
+
+TEST_CASE( "Models can be reloaded", "[model]" )
+{
+	std::vector<std::string> l_states_w = { "ETAT_A", "ETAT_B", "ETAT_C", "ETAT_B", "ETAT_D" };
+
+	SECTION("Every reload rebuilds the whole model")
+	{
+		for(unsigned r = 0; r < 20; r++)
+		{
+			CHECK_NOTHROW( MODEL::create("./data/running_ok.xml") );
+			for(unsigned i = 0; i < l_states_w.size(); i++)
+			{
+				MODEL::nextState();
+				REQUIRE( MODEL::currentStateString() == l_states_w[i] );
+				MODEL::runOperations();
+				MODEL::runTransitions();
+			}
+		}
+	}
+
+	SECTION("A model is reloaded after a failed load")
+	{
+		CHECK_THROWS(  MODEL::create("./data/typo.xml") );
+		CHECK_NOTHROW( MODEL::create("./data/running_ok.xml") );
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "ETAT_A" );
+		REQUIRE( MODEL::getMessagesDstPort() == std::vector<uint32_t>({ 2222 }) );
+	}
+}
+
+TEST_CASE( "Model running functions work correctly", "[model]" )
 {
 	if(WRITE_LOGS)
 	{
@@ -526,4 +721,390 @@ TEST_CASE( "MULTIPLEXED MODE: Model messages are correctly built", "[model]" )
 	{
 		LOGS::close();
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Model messages are encoded into caller buffers", "[model]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/messages_ok.xml") );
+
+	unsigned char index_start_time = 2;
+	unsigned char index_end_time   = 5;
+
+	std::vector< unsigned char > l_mesgA_w = { 	16, 90, 0, 0, 0, 0, 19, 204, 51,
+												0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	MODEL::nextState();
+
+	std::vector< unsigned char > l_buffer(64, 0xFF);
+
+	SECTION("Encoded size is exact")
+	{
+		REQUIRE( MODEL::getMessagesCount() == 1 );
+		REQUIRE( MODEL::getMessageSize(0)  == l_mesgA_w.size() );
+	}
+
+	SECTION("Message is written into the buffer")
+	{
+		REQUIRE( MODEL::encodeMessage(0, l_buffer.data(), l_buffer.size()) == l_mesgA_w.size() );
+
+		for(unsigned i = 0; i < l_mesgA_w.size(); i++)
+		{
+			if( (i < index_start_time) || (i > index_end_time) )
+			{
+				REQUIRE( l_buffer[i] == l_mesgA_w[i] );
+			}
+		}
+
+		// Nothing is written after the message
+		REQUIRE( l_buffer[l_mesgA_w.size()] == 0xFF );
+	}
+
+	SECTION("Buffer too small")
+	{
+		CHECK_THROWS( MODEL::encodeMessage(0, l_buffer.data(), l_mesgA_w.size() - 1) );
+		CHECK_THROWS( MODEL::encodeMessage(1, l_buffer.data(), l_buffer.size()) );
+	}
+
+	SECTION("Index out of range")
+	{
+		CHECK_THROWS_WITH( MODEL::encodeMessage(1, l_buffer.data(), l_buffer.size()),
+		                   Catch::Contains("has no message at index 1 (1 message(s))") );
+		CHECK_THROWS_WITH( MODEL::getMessageSize(3), Catch::Contains("has no message at index 3") );
+	}
+}
+
+TEST_CASE( "Random payloads are reproducible with a seed", "[model]" ) 
+{
+	std::vector< unsigned char > l_first (1003, 0);
+	std::vector< unsigned char > l_second(1003, 0);
+	std::vector< unsigned char > l_other (1003, 0);
+
+	CHECK_NOTHROW( MODEL::create("./data/messages_seeded.xml") );
+	MODEL::nextState();
+	REQUIRE( MODEL::getMessagesCount() == 2 );
+	REQUIRE( MODEL::encodeMessage(0, l_first.data(), l_first.size()) == l_first.size() );
+	REQUIRE( MODEL::encodeMessage(1, l_other.data(), l_other.size()) == l_other.size() );
+
+	CHECK_NOTHROW( MODEL::create("./data/messages_seeded.xml") );
+	MODEL::nextState();
+	REQUIRE( MODEL::encodeMessage(0, l_second.data(), l_second.size()) == l_second.size() );
+
+	// Header is untouched by the payload
+	REQUIRE( l_first[0] == 16 );
+
+	// Same seed, same payload - different seed, different payload
+	REQUIRE( l_first == l_second );
+	REQUIRE( l_first != l_other  );
+
+	// Every byte value can be generated
+	REQUIRE( std::find(l_first.begin() + 3, l_first.end(), 0xFF) != l_first.end() );
+}
+
+TEST_CASE( "Delays are waited on absolute deadlines", "[model]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/loop_5ms.xml") );
+	MODEL::setScheduling(0, 0);
+
+	// 10 loops of 5ms, each state spending 2ms working
+	auto l_start = std::chrono::steady_clock::now();
+	for(unsigned i = 0; i < 10; i++)
+	{
+		MODEL::nextState();
+		auto l_messages = MODEL::getMessages();
+		std::this_thread::sleep_for(std::chrono::microseconds(2000));
+		MODEL::runOperations();
+		MODEL::runTransitions();
+	}
+	auto l_elapsed = std::chrono::duration_cast<std::chrono::microseconds>
+						(std::chrono::steady_clock::now() - l_start).count();
+
+	// The work and the wake-up latencies are not accumulated (>= 70ms otherwise)
+	REQUIRE( l_elapsed >= 50000 );
+	REQUIRE( l_elapsed <  62000 );
+
+	CHECK_THROWS( MODEL::setScheduling(0, 3) );
+}
+
+TEST_CASE( "Delays are not all made at once after a stall", "[model]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/loop_5ms.xml") );
+	MODEL::setScheduling(0, 0);
+
+	MODEL::nextState();
+	MODEL::runOperations();
+	MODEL::runTransitions();
+
+	// The model is held for 10 periods (Ex/ by a state without delay)
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	// Only the first deadline is late: the next ones are counted from it
+	auto l_start = std::chrono::steady_clock::now();
+	for(unsigned i = 0; i < 5; i++)
+	{
+		MODEL::nextState();
+		MODEL::runOperations();
+		MODEL::runTransitions();
+	}
+	auto l_elapsed = std::chrono::duration_cast<std::chrono::microseconds>
+						(std::chrono::steady_clock::now() - l_start).count();
+
+	REQUIRE( l_elapsed >= 20000 );
+	REQUIRE( MODEL::getLateCount() == 1 );
+}
+
+TEST_CASE( "Model instances run independently", "[model]" ) 
+{
+	std::vector<std::string> l_states_w = 
+		{ "ETAT_A", "ETAT_B", "ETAT_C",
+		  "ETAT_B", "ETAT_D", "ETAT_D",
+		  "ETAT_D", "ETAT_D", "ETAT_D",
+		  "ETAT_B", "ETAT_E", "ETAT_B"
+		};	
+
+	CHECK_NOTHROW( MODEL::create("./data/running_ok.xml") );
+	CHECK_THROWS( MODEL::createInstance("/incorrect/file/name") );
+
+	MODEL::INSTANCE l_first  = MODEL::createInstance("./data/running_ok.xml");
+	MODEL::INSTANCE l_second = MODEL::createInstance("./data/running_ok.xml");
+	REQUIRE( l_first  != MODEL::getDefaultInstance() );
+	REQUIRE( l_second != l_first );
+
+	SECTION("Every instance has its own states and variables")
+	{
+		for(unsigned i = 0; i < 4; i++)
+		{
+			MODEL::nextState(l_first);
+			REQUIRE( MODEL::currentStateString(l_first) == l_states_w[i] );
+			MODEL::runOperations(l_first);
+			MODEL::runTransitions(l_first);
+		}
+
+		// FLIP_FLOP was set by the first instance only
+		MODEL::nextState(l_second);
+		MODEL::runOperations(l_second);
+		MODEL::runTransitions(l_second);
+		MODEL::nextState(l_second);
+		REQUIRE( MODEL::currentStateString(l_second) == "ETAT_B" );
+		MODEL::runOperations(l_second);
+		MODEL::runTransitions(l_second);
+		MODEL::nextState(l_second);
+		REQUIRE( MODEL::currentStateString(l_second) == "ETAT_C" );
+
+		MODEL::nextState(l_first);
+		REQUIRE( MODEL::currentStateString(l_first) == "ETAT_D" );
+
+		// The default instance did not move
+		REQUIRE( MODEL::currentStateString() == "ETAT_A" );
+		REQUIRE( MODEL::getMessagesDstPort(l_first) == std::vector<uint32_t>({3333}) );
+		REQUIRE( MODEL::getMessagesDstPort()        == std::vector<uint32_t>({2222}) );
+	}
+
+	SECTION("Instances run on separate threads")
+	{
+		std::vector<std::string> l_states[2];
+		MODEL::INSTANCE          l_instances[2] = { l_first, l_second };
+
+		std::vector<std::thread> l_threads;
+		for(unsigned t = 0; t < 2; t++)
+		{
+			l_threads.emplace_back([&, t]()
+			{
+				for(unsigned i = 0; i < l_states_w.size(); i++)
+				{
+					MODEL::nextState(l_instances[t]);
+					l_states[t].push_back(MODEL::currentStateString(l_instances[t]));
+					auto l_messages = MODEL::getMessages(l_instances[t]);
+					MODEL::runOperations(l_instances[t]);
+					MODEL::runTransitions(l_instances[t]);
+				}
+			});
+		}
+		for(auto& l_thread: l_threads)
+		{
+			l_thread.join();
+		}
+
+		REQUIRE( l_states[0] == l_states_w );
+		REQUIRE( l_states[1] == l_states_w );
+	}
+
+	SECTION("Invalid handles")
+	{
+		CHECK_THROWS( MODEL::runOperations(nullptr) );
+		CHECK_THROWS( MODEL::destroyInstance(MODEL::getDefaultInstance()) );
+	}
+
+	MODEL::destroyInstance(l_first);
+	MODEL::destroyInstance(l_second);
+}
+
+TEST_CASE( "Variables are driven from other threads", "[model]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/running_ok.xml") );
+	CHECK_THROWS( MODEL::getVariable("UNKNOWN") );
+	CHECK_THROWS( MODEL::getVariableValue(42) );
+
+	MODEL::VARIABLE l_flipFlop = MODEL::getVariable("FLIP_FLOP");
+
+	SECTION("A transition sees the value set by another thread")
+	{
+		MODEL::nextState();
+		MODEL::runOperations();
+		MODEL::runTransitions();
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "ETAT_B" );
+
+		std::thread l_control([&]() { MODEL::setVariableValue(l_flipFlop, 2); });
+		l_control.join();
+		REQUIRE( MODEL::getVariableValue(l_flipFlop) == 2 );
+
+		MODEL::runOperations();
+		MODEL::runTransitions();
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "ETAT_E" );
+	}
+
+	SECTION("The changes wake up the waiting threads")
+	{
+		uint32_t l_version = MODEL::getVariableVersion(l_flipFlop);
+		REQUIRE_FALSE( MODEL::waitVariable(l_flipFlop, l_version, 1000) );
+
+		std::thread l_control([&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			MODEL::setVariableValue(l_flipFlop, 7);
+		});
+		REQUIRE( MODEL::waitVariable(l_flipFlop, l_version, 5000000) );
+		l_control.join();
+
+		REQUIRE( MODEL::getVariableValue(l_flipFlop) == 7 );
+		REQUIRE( MODEL::getVariableVersion(l_flipFlop) != l_version );
+	}
+}
+
+TEST_CASE( "Idle states wait for their variables", "[model]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/waiting.xml") );
+	MODEL::VARIABLE l_go = MODEL::getVariable("GO");
+
+	SECTION("A waiting state blocks until its variables change")
+	{
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "IDLE" );
+		MODEL::runOperations();
+
+		std::thread l_control([&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			MODEL::setVariableValue(l_go, 1);
+		});
+		auto l_start = std::chrono::steady_clock::now();
+		MODEL::runTransitions();
+		auto l_elapsed = std::chrono::steady_clock::now() - l_start;
+		l_control.join();
+
+		REQUIRE( l_elapsed >= std::chrono::milliseconds(15) );
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "POLL" );
+	}
+
+	SECTION("A waiting state is run again after its timeout")
+	{
+		MODEL::setVariableValue(l_go, 1);
+		MODEL::nextState();
+		MODEL::runOperations();
+		MODEL::runTransitions();
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "POLL" );
+		REQUIRE( MODEL::getMessagesCount() == 1 );
+
+		auto l_start = std::chrono::steady_clock::now();
+		MODEL::runTransitions();
+		REQUIRE( std::chrono::steady_clock::now() - l_start >= std::chrono::milliseconds(15) );
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "POLL" );
+
+		// POLL is not resent
+		REQUIRE( MODEL::getMessagesCount() == 0 );
+		REQUIRE( MODEL::getMessages().empty() );
+
+		MODEL::setVariableValue(l_go, 2);
+		MODEL::runTransitions();
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "IDLE" );
+		REQUIRE( MODEL::getMessagesCount() == 1 );
+	}
+
+	SECTION("A resent state has its messages after its timeout")
+	{
+		std::ifstream     l_source("./data/waiting.xml");
+		std::stringstream l_xml;
+		l_xml << l_source.rdbuf();
+
+		std::string l_conf("./waiting_resent.xml");
+		std::string l_model = l_xml.str();
+		l_model.replace(l_model.find("resend=\"FALSE\""), 14, "resend=\"TRUE\"");
+		std::ofstream(l_conf) << l_model;
+		CHECK_NOTHROW( MODEL::create(l_conf) );
+		std::remove(l_conf.c_str());
+
+		MODEL::setVariableValue(l_go, 1);
+		MODEL::nextState();
+		MODEL::runTransitions();
+		MODEL::nextState();
+		MODEL::runTransitions();
+		MODEL::nextState();
+		REQUIRE( MODEL::currentStateString() == "POLL" );
+		REQUIRE( MODEL::getMessagesCount() == 1 );
+	}
+
+	SECTION("Only the states testing variables can wait")
+	{
+		std::ifstream     l_source("./data/waiting.xml");
+		std::stringstream l_xml;
+		l_xml << l_source.rdbuf();
+
+		std::string l_conf("./waiting_delay.xml");
+		std::string l_model = l_xml.str();
+		std::string l_condition("<Condition name=\"GO\" value=\"1\" operande=\"==\"/>");
+		l_model.replace(l_model.find(l_condition), l_condition.size(), "<Delay value=\"1000\"/>");
+		std::ofstream(l_conf) << l_model;
+		CHECK_THROWS( MODEL::create(l_conf) );
+		std::remove(l_conf.c_str());
+	}
+}
+
+TEST_CASE( "Delays advance the virtual clock", "[model]" ) 
+{
+	std::vector< unsigned char > l_first (14, 0);
+	std::vector< unsigned char > l_last  (14, 0);
+
+	TIME::startVirtualClock(0);
+	CHECK_NOTHROW( MODEL::create("./data/virtual_time.xml") );
+
+	// An hour of 1s delays
+	auto l_start = std::chrono::steady_clock::now();
+	for(unsigned i = 0; i < 3600; i++)
+	{
+		MODEL::nextState();
+		REQUIRE( MODEL::encodeMessage(0, (i ? l_last : l_first).data(), l_last.size()) == l_last.size() );
+		MODEL::runOperations();
+		MODEL::runTransitions();
+	}
+	auto l_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
+						(std::chrono::steady_clock::now() - l_start).count();
+	TIME::stopVirtualClock();
+
+	REQUIRE( TIME::getVirtualTime() == 3600000000ull );
+	REQUIRE( l_elapsed < 2000 );
+
+	// The time field reads the virtual clock (ms, most significant bits first)
+	uint32_t l_firstTime = 0;
+	uint32_t l_lastTime  = 0;
+	for(unsigned i = 0; i < 4; i++)
+	{
+		l_firstTime = (l_firstTime << 8) | l_first[i];
+		l_lastTime  = (l_lastTime  << 8) | l_last[i];
+	}
+	REQUIRE( l_lastTime - l_firstTime == 3599000 );
+}
@@ -0,0 +1,262 @@
+/*!
+ * @file   06-sender.cpp
+ * @brief  Contains the unit tests for the sender module.
+ * @author lhm
+ * @date   16/10/2026
+ */
+
+#define CATCH_CONFIG_MAIN 
+
+#include <catch.hpp>
+#include <stdbool.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <modelGenerator_interface.h>
+
+using namespace ModelGeneratorAPI;
+
+/*!
+ *	Messages of ./data/messages_aggregated.xml
+ *	- MESG_1 : 20 bytes to 10.52.10.100:4321
+ *	- MESG_2 : 30 bytes to 10.52.10.100:4321
+ *	- MESG_3 : 10 bytes to 10.101.80.10:8765
+ *	STATE A sends MESG_1, MESG_2 and MESG_3 - STATE B sends MESG_1 twice.
+ */
+static void goToNextState(void)
+{
+	MODEL::runOperations();
+	MODEL::runTransitions();
+	MODEL::nextState();
+}
+
+TEST_CASE( "SIMPLE: one frame per message", "[sender]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/messages_aggregated.xml") );
+	SENDER::setup(0, 64, UTIL::getDefaultTimeout());
+	MODEL::nextState();
+
+	REQUIRE( SENDER::aggregate() == 3 );
+	REQUIRE( SENDER::getFrame(0).size() == 20 );
+	REQUIRE( SENDER::getFrame(1).size() == 30 );
+	REQUIRE( SENDER::getFrame(2).size() == 10 );
+	REQUIRE( SENDER::getFrameBoundaries(0) == std::vector<uint32_t>({0}) );
+	REQUIRE( SENDER::getFrameDstIp(2)   == "10.101.80.10" );
+	REQUIRE( SENDER::getFrameDstPort(2) == 8765 );
+	REQUIRE( SENDER::getFrame(0)[1] == 20 );
+
+	SENDER::clearFrames();
+	REQUIRE( SENDER::getFramesCount() == 0 );
+	CHECK_THROWS( SENDER::getFrame(0) );
+}
+
+TEST_CASE( "Smart Multiplex: messages of a state are packed", "[sender]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/messages_aggregated.xml") );
+	SENDER::setup(1, 64, UTIL::getDefaultTimeout());
+	MODEL::nextState();
+
+	REQUIRE( SENDER::aggregate() == 2 );
+	REQUIRE( SENDER::getFrame(0).size() == 50 );
+	REQUIRE( SENDER::getFrameBoundaries(0) == std::vector<uint32_t>({0, 20}) );
+	REQUIRE( SENDER::getFrameDstIp(0) == "10.52.10.100" );
+	REQUIRE( SENDER::getFrame(0)[20] == 16 );
+	REQUIRE( SENDER::getFrame(0)[21] == 30 );
+	REQUIRE( SENDER::getFrame(1).size() == 10 );
+	REQUIRE( SENDER::getFrameDstIp(1) == "10.101.80.10" );
+	SENDER::clearFrames();
+
+	goToNextState();
+	REQUIRE( MODEL::currentStateString() == "STATE B" );
+	REQUIRE( SENDER::aggregate() == 1 );
+	REQUIRE( SENDER::getFrame(0).size() == 40 );
+	REQUIRE( SENDER::getFrameBoundaries(0) == std::vector<uint32_t>({0, 20}) );
+	SENDER::clearFrames();
+}
+
+TEST_CASE( "Full Multiplex: messages of consecutive states are packed", "[sender]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/messages_aggregated.xml") );
+	SENDER::setup(2, 64, UTIL::getDefaultTimeout());
+	MODEL::nextState();
+
+	// Nothing is sent before the maximum size is reached
+	REQUIRE( SENDER::aggregate() == 0 );
+
+	goToNextState();
+	REQUIRE( SENDER::aggregate() == 1 );
+	REQUIRE( SENDER::getFrame(0).size() == 50 );
+	SENDER::clearFrames();
+
+	// 40 + 20 bytes : MESG_2 does not fit anymore, the frame is sent
+	goToNextState();
+	REQUIRE( SENDER::aggregate() == 1 );
+	REQUIRE( SENDER::getFrame(0).size() == 60 );
+	REQUIRE( SENDER::getFrameBoundaries(0) == std::vector<uint32_t>({0, 20, 40}) );
+	SENDER::clearFrames();
+
+	// The remaining frames
+	REQUIRE( SENDER::flush() == 2 );
+	REQUIRE( SENDER::getFrame(0).size() + SENDER::getFrame(1).size() == 30 + 20 );
+	SENDER::clearFrames();
+}
+
+TEST_CASE( "AUTO: frames are sent on timeout", "[sender]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/messages_aggregated.xml") );
+	SENDER::setup(3, 1000, 20000);
+	MODEL::nextState();
+
+	REQUIRE( SENDER::aggregate() == 0 );
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	goToNextState();
+	REQUIRE( SENDER::aggregate() == 2 );
+	REQUIRE( SENDER::getFrame(0).size() == 50 );
+	REQUIRE( SENDER::getFrame(1).size() == 10 );
+	SENDER::clearFrames();
+
+	CHECK_THROWS( SENDER::setup(4, 1000, 20000) );
+}
+
+TEST_CASE( "AUTO: frames are sent on timeout without any new message", "[sender]" ) 
+{
+	CHECK_NOTHROW( MODEL::create("./data/messages_aggregated.xml") );
+	SENDER::setup(3, 1000, 20000);
+	REQUIRE( SENDER::getTimeLeft() == UINT64_MAX );
+
+	MODEL::nextState();
+	REQUIRE( SENDER::aggregate() == 0 );
+	REQUIRE( SENDER::getTimeLeft() >  0 );
+	REQUIRE( SENDER::getTimeLeft() <= 20000 );
+	REQUIRE( SENDER::poll() == 0 );
+
+	// The model waits: the frames are sent once their timeout expires
+	std::this_thread::sleep_for(std::chrono::microseconds(SENDER::getTimeLeft() + 1000));
+	REQUIRE( SENDER::getTimeLeft() == 0 );
+	REQUIRE( SENDER::poll() == 2 );
+	REQUIRE( SENDER::getFrame(0).size() == 50 );
+	REQUIRE( SENDER::getFrame(1).size() == 10 );
+	REQUIRE( SENDER::getTimeLeft() == UINT64_MAX );
+	SENDER::clearFrames();
+}
+
+TEST_CASE( "UDP: frames are sent on loopback", "[sender]" ) 
+{
+	// Receiver of ./data/messages_loopback.xml (every message is sent to 127.0.0.1:45000)
+	int l_fd = socket(AF_INET, SOCK_DGRAM, 0);
+	REQUIRE( l_fd >= 0 );
+
+	sockaddr_in l_addr = {};
+	l_addr.sin_family 		= AF_INET;
+	l_addr.sin_port   		= htons(45000);
+	l_addr.sin_addr.s_addr 	= htonl(INADDR_LOOPBACK);
+	REQUIRE( bind(l_fd, reinterpret_cast<sockaddr*>(&l_addr), sizeof(l_addr)) == 0 );
+
+	timeval l_timeout = {1, 0};
+	setsockopt(l_fd, SOL_SOCKET, SO_RCVTIMEO, &l_timeout, sizeof(l_timeout));
+
+	CHECK_NOTHROW( MODEL::create("./data/messages_loopback.xml") );
+	SENDER::setup(0, 64, UTIL::getDefaultTimeout());
+	CHECK_NOTHROW( SENDER::open() );
+	MODEL::nextState();
+
+	// MESG_1 and MESG_2 share a socket, MESG_3 uses another one
+	REQUIRE( SENDER::aggregate() == 3 );
+	REQUIRE( SENDER::send() == 3 );
+	REQUIRE( SENDER::getFramesCount() == 0 );
+	REQUIRE( SENDER::getSentFramesCount() == 3 );
+#ifdef __linux__
+	REQUIRE( SENDER::getSyscallsCount() == 2 );
+#endif
+
+	std::vector<size_t> l_sizes;
+	unsigned char l_buffer[256];
+	for(int i = 0; i < 3; i++)
+	{
+		ssize_t l_res = recv(l_fd, l_buffer, sizeof(l_buffer), 0);
+		REQUIRE( l_res > 0 );
+		REQUIRE( l_buffer[0] == 16 );
+		REQUIRE( l_buffer[1] == l_res );
+		l_sizes.push_back(static_cast<size_t>(l_res));
+	}
+	std::sort(l_sizes.begin(), l_sizes.end());
+	REQUIRE( l_sizes == std::vector<size_t>({10, 20, 30}) );
+
+	SENDER::close();
+	::close(l_fd);
+}
+
+TEST_CASE( "PCAP: frames are written to a capture file", "[sender]" ) 
+{
+	const std::string l_file("06-capture.pcap");
+
+	CHECK_NOTHROW( MODEL::create("./data/messages_loopback.xml") );
+	SENDER::setup(1, 64, UTIL::getDefaultTimeout());
+	CHECK_NOTHROW( SENDER::openPcap(l_file) );
+	MODEL::nextState();
+
+	// [MESG_1 MESG_2] and [MESG_3]
+	REQUIRE( SENDER::aggregate() == 2 );
+	std::vector<unsigned char> l_frame = SENDER::getFrame(0);
+	REQUIRE( SENDER::send() == 2 );
+	REQUIRE( SENDER::getSentFramesCount() == 2 );
+	SENDER::close();
+
+	std::ifstream l_capture(l_file, std::ios::binary);
+	std::vector<unsigned char> l_data((std::istreambuf_iterator<char>(l_capture)),
+									   std::istreambuf_iterator<char>());
+
+	// Global header + 2 records (16 bytes) with Ethernet/IPv4/UDP headers (42 bytes)
+	REQUIRE( l_data.size() == 24 + (16 + 42 + 50) + (16 + 42 + 10) );
+
+	uint32_t l_magic = 0;
+	std::memcpy(&l_magic, l_data.data(), 4);
+	REQUIRE( l_magic == 0xa1b2c3d4 );
+
+	uint32_t l_inclLen = 0;
+	std::memcpy(&l_inclLen, l_data.data() + 24 + 8, 4);
+	REQUIRE( l_inclLen == 42 + 50 );
+
+	const unsigned char* l_eth = l_data.data() + 24 + 16;
+	const unsigned char* l_ip  = l_eth + 14;
+	const unsigned char* l_udp = l_ip + 20;
+	REQUIRE( l_eth[12] == 0x08 );
+	REQUIRE( l_eth[13] == 0x00 );
+	REQUIRE( l_ip[0] == 0x45 );
+	REQUIRE( ((l_ip[2] << 8) | l_ip[3]) == 20 + 8 + 50 );
+	REQUIRE( l_ip[9] == 17 );
+	REQUIRE( l_ip[12] == 127 );
+	REQUIRE( l_ip[19] == 1 );
+
+	// The checksum of a valid header sums to 0xFFFF
+	uint32_t l_sum = 0;
+	for(int i = 0; i < 20; i += 2)
+	{
+		l_sum += (l_ip[i] << 8) | l_ip[i + 1];
+	}
+	while(l_sum >> 16)
+	{
+		l_sum = (l_sum & 0xFFFF) + (l_sum >> 16);
+	}
+	REQUIRE( l_sum == 0xFFFF );
+
+	REQUIRE( ((l_udp[0] << 8) | l_udp[1]) == 45001 );
+	REQUIRE( ((l_udp[2] << 8) | l_udp[3]) == 45000 );
+	REQUIRE( ((l_udp[4] << 8) | l_udp[5]) == 8 + 50 );
+	REQUIRE( std::equal(l_frame.begin(), l_frame.end(), l_udp + 8) );
+
+	std::remove(l_file.c_str());
+}
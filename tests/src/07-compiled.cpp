@@ -0,0 +1,359 @@
+/*!
+ * @file   07-compiled.cpp
+ * @brief  Contains the unit tests for the compiled models.
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include <stdbool.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ModelInstance.h>
+#include <CompiledModel.h>
+#include <Message.h>
+
+using namespace ModGen;
+
+TEST_CASE( "Waiting states are resumed with or without their messages", "[compiled]" )
+{
+	ModelInstance l_model;
+	REQUIRE_NOTHROW( l_model.setup("./data/waiting.xml") );
+
+	CompiledModel&  l_run  = l_model.getCompiled();
+	VariableStore&  l_vars = l_model.getVariables();
+	SymbolTable::ID l_go   = l_model.getSymbols().variables.find("GO");
+	SymbolTable::ID l_idle = l_model.getSymbols().states.find("IDLE");
+	SymbolTable::ID l_poll = l_model.getSymbols().states.find("POLL");
+
+	// IDLE sends its messages again (default)
+	REQUIRE( l_run.nextState() == l_idle );
+	REQUIRE( l_run.getMessagesCount() == 1 );
+	REQUIRE( l_run.step() == 0 );
+	REQUIRE( l_run.isParked() );
+	REQUIRE_FALSE( l_run.park(1000) );
+
+	l_vars.set(l_go, 3);
+	REQUIRE( l_run.park(1000) );
+	REQUIRE( l_run.nextState() == l_idle );
+	REQUIRE( l_run.getMessagesCount() == 1 );
+	l_run.step();
+	REQUIRE( l_run.isParked() );
+
+	l_vars.set(l_go, 1);
+	REQUIRE( l_run.park(1000) );
+	REQUIRE( l_run.nextState() == l_idle );
+	l_run.step();
+	REQUIRE_FALSE( l_run.isParked() );
+	REQUIRE( l_run.getNext() == l_poll );
+
+	SECTION("A state which is not resent has no message once resumed by a variable")
+	{
+		REQUIRE( l_run.nextState() == l_poll );
+		REQUIRE( l_run.getMessagesCount() == 1 );
+		l_run.step();
+		REQUIRE( l_run.isParked() );
+
+		l_vars.set(l_go, 3);
+		REQUIRE( l_run.park(100000) );
+		REQUIRE( l_run.nextState() == l_poll );
+		REQUIRE( l_run.getMessagesCount() == 0 );
+
+		l_vars.set(l_go, 2);
+		l_run.step();
+		REQUIRE( l_run.getNext() == l_idle );
+		REQUIRE( l_run.nextState() == l_idle );
+		REQUIRE( l_run.getMessagesCount() == 1 );
+	}
+
+	SECTION("A state which is not resent has no message once resumed by its timeout")
+	{
+		REQUIRE( l_run.nextState() == l_poll );
+		l_run.step();
+		REQUIRE( l_run.isParked() );
+
+		auto l_start = std::chrono::steady_clock::now();
+		while(!l_run.park(1000)) {}
+		REQUIRE( std::chrono::steady_clock::now() - l_start >= std::chrono::milliseconds(15) );
+		REQUIRE( l_run.nextState() == l_poll );
+		REQUIRE( l_run.getMessagesCount() == 0 );
+		l_run.step();
+		REQUIRE( l_run.isParked() );
+	}
+}
+
+TEST_CASE( "Cached conditions are made in declaration order", "[compiled]" )
+{
+	ModelInstance l_model;
+	REQUIRE_NOTHROW( l_model.setup("./data/indexed.xml") );
+
+	const ModelInstance::ModelSymbols& l_symbols = l_model.getSymbols();
+	SymbolTable::ID l_select = l_symbols.states.find("SELECT");
+	REQUIRE( l_model.getDefinition()->isIndexed(l_select) );
+
+	// Variables changed before each step (the others keep their value),
+	// and the state which must be selected
+	struct Change { std::vector< std::pair<std::string, int32_t> > vars; std::string state; };
+	std::vector<Change> l_changes =
+		{ { {},                     "SELECT" },
+		  { { {"C", 6} },           "S_C"    },
+		  { { {"A", 2} },           "S_A2"   },
+		  { { {"B", 1} },           "S_B1"   },
+		  { { {"A", 1} },           "S_A1"   },
+		  { { {"A", 0}, {"B", 0} }, "S_C"    },
+		  { { {"C", 3} },           "S_C3"   },
+		  { { {"D", 7} },           "S_C3"   },
+		  { { {"C", 0} },           "S_D7"   },
+		  { { {"D", -1} },          "S_D"    },
+		  { { {"B", 2}, {"D", 0} }, "S_B2"   },
+		  { { {"B", 0} },           "SELECT" } };
+
+	SECTION("Variables of the instance")
+	{
+		CompiledModel l_run(l_model.getDefinition());
+		REQUIRE( l_run.nextState() == l_select );
+
+		for(auto& l_change: l_changes)
+		{
+			for(auto& l_var: l_change.vars)
+			{
+				l_run.setVariable(l_symbols.variables.find(l_var.first), l_var.second);
+			}
+			l_run.step();
+			REQUIRE( l_run.getStateName(l_run.getNext()) == l_change.state );
+
+			// Back to SELECT
+			if(l_run.nextState() != l_select)
+			{
+				l_run.step();
+				REQUIRE( l_run.nextState() == l_select );
+			}
+		}
+	}
+
+	SECTION("Variables shared with other threads")
+	{
+		CompiledModel& l_run = l_model.getCompiled();
+		REQUIRE( l_run.nextState() == l_select );
+
+		for(auto& l_change: l_changes)
+		{
+			for(auto& l_var: l_change.vars)
+			{
+				l_model.getVariables().set(l_symbols.variables.find(l_var.first), l_var.second);
+			}
+			l_run.step();
+			REQUIRE( l_run.getStateName(l_run.getNext()) == l_change.state );
+
+			if(l_run.nextState() != l_select)
+			{
+				l_run.step();
+				REQUIRE( l_run.nextState() == l_select );
+			}
+		}
+	}
+}
+
+TEST_CASE( "A definition stays valid after a reload of its model", "[compiled]" )
+{
+	ModelInstance l_model;
+	REQUIRE_NOTHROW( l_model.setup("./data/loop_5ms.xml") );
+
+	CompiledModel l_run(l_model.getDefinition());
+
+	std::vector<uint8_t> l_before(64, 0xAA);
+	REQUIRE( l_run.getStateName(l_run.nextState()) == "STATE A" );
+	REQUIRE( l_run.getMessagesCount() == 1 );
+	REQUIRE( l_run.getMessageSize(0) == 11 );
+	uint32_t l_size = l_run.encodeMessage(0, l_before.data(), l_before.size());
+	REQUIRE( l_size == 11 );
+	l_run.step();
+
+	// The frames, routes and names of the states are those of loop_5ms:
+	// the elements of the model they were compiled from are freed
+	REQUIRE_NOTHROW( l_model.setup("./data/waiting.xml") );
+	REQUIRE( l_model.getDefinition() != l_run.getDefinition() );
+
+	for(uint32_t i = 0; i < 3; i++)
+	{
+		std::vector<uint8_t> l_after(64, 0xAA);
+		REQUIRE( l_run.getStateName(l_run.nextState()) == "STATE A" );
+		REQUIRE( l_run.getMessagesCount() == 1 );
+		REQUIRE( l_run.encodeMessage(0, l_after.data(), l_after.size()) == l_size );
+		REQUIRE( l_after == l_before );
+		REQUIRE( l_run.step() == 5000 );
+	}
+}
+
+TEST_CASE( "Instances of a definition run independently", "[compiled]" )
+{
+	ModelInstance l_model;
+	REQUIRE_NOTHROW( l_model.setup("./data/running_ok.xml") );
+
+	SymbolTable::ID l_flipFlop = l_model.getSymbols().variables.find("FLIP_FLOP");
+
+	// The states, delays and values of the variable of a new instance
+	struct Step { uint32_t state; uint64_t delay; int32_t value; };
+	auto l_run = [&](CompiledModel& p_model)
+	{
+		uint32_t l_state = p_model.nextState();
+		uint64_t l_delay = p_model.step();
+		return Step{ l_state, l_delay, p_model.getVariable(l_flipFlop) };
+	};
+	auto l_check = [&](const Step& p_step, const Step& p_expected)
+	{
+		REQUIRE( p_step.state == p_expected.state );
+		REQUIRE( p_step.delay == p_expected.delay );
+		REQUIRE( p_step.value == p_expected.value );
+	};
+
+	std::vector<Step> l_expected;
+	CompiledModel     l_reference(l_model.getDefinition());
+	for(uint32_t i = 0; i < 60; i++)
+	{
+		l_expected.push_back(l_run(l_reference));
+	}
+
+	CompiledModel l_first(l_model.getDefinition());
+	CompiledModel l_second(l_model.getDefinition());
+	for(uint32_t i = 0; i < 13; i++)
+	{
+		l_check(l_run(l_first), l_expected[i]);
+	}
+
+	SECTION("The loop counters and the variables are not shared")
+	{
+		REQUIRE( l_second.getVariable(l_flipFlop) == 0 );
+		for(uint32_t i = 0; i + 13 < l_expected.size(); i++)
+		{
+			l_check(l_run(l_second), l_expected[i]);
+			l_check(l_run(l_first),  l_expected[i + 13]);
+		}
+
+		l_first.setVariable(l_flipFlop, 42);
+		REQUIRE( l_first.getVariable(l_flipFlop)  == 42 );
+		REQUIRE( l_second.getVariable(l_flipFlop) == l_expected[l_expected.size() - 14].value );
+		REQUIRE( l_model.getVariables().get(l_flipFlop) == 0 );
+	}
+
+	SECTION("A copy goes on from the state of the instance copied")
+	{
+		CompiledModel l_copy(l_first);
+		l_second = l_first;
+		for(CompiledModel* l_instance: { &l_copy, &l_second })
+		{
+			REQUIRE( l_instance->getCurrent() == l_first.getCurrent() );
+			REQUIRE( l_instance->getNext()    == l_first.getNext() );
+			REQUIRE( l_instance->getVariable(l_flipFlop) == l_first.getVariable(l_flipFlop) );
+		}
+
+		// The loop counters are copied too (the copies go through the loops)
+		for(uint32_t i = 13; i < l_expected.size(); i++)
+		{
+			l_check(l_run(l_copy),   l_expected[i]);
+			l_check(l_run(l_second), l_expected[i]);
+		}
+		l_copy.setVariable(l_flipFlop, 42);
+		REQUIRE( l_second.getVariable(l_flipFlop) != 42 );
+		REQUIRE( l_first.getVariable(l_flipFlop)  == l_expected[12].value );
+	}
+
+	SECTION("A copy of an instance sharing its variables has variables of its own")
+	{
+		CompiledModel& l_shared = l_model.getCompiled();
+		for(uint32_t i = 0; i < 13; i++)
+		{
+			l_check(l_run(l_shared), l_expected[i]);
+		}
+
+		CompiledModel l_copy(l_shared);
+		REQUIRE( l_copy.getVariable(l_flipFlop) == l_expected[12].value );
+		l_model.getVariables().set(l_flipFlop, 42);
+		REQUIRE( l_copy.getVariable(l_flipFlop) == l_expected[12].value );
+
+		for(uint32_t i = 13; i < l_expected.size(); i++)
+		{
+			l_check(l_run(l_copy), l_expected[i]);
+		}
+	}
+}
+
+TEST_CASE( "The payloads of an instance are drawn from its own generators", "[compiled]" )
+{
+	ModelInstance l_model;
+	REQUIRE_NOTHROW( l_model.setup("./data/messages_seeded.xml") );
+
+	// The payloads of the next states of an instance
+	auto l_draw = [](CompiledModel& p_model, uint32_t p_states)
+	{
+		std::vector< std::vector<uint8_t> > l_payloads;
+		for(uint32_t i = 0; i < p_states; i++)
+		{
+			p_model.nextState();
+			for(std::size_t m = 0; m < p_model.getMessagesCount(); m++)
+			{
+				l_payloads.emplace_back(p_model.getMessageSize(m), 0);
+				REQUIRE( p_model.encodeMessage(m, l_payloads.back().data(), l_payloads.back().size()) == 1003 );
+			}
+			p_model.step();
+		}
+		return l_payloads;
+	};
+
+	CompiledModel l_reference(l_model.getDefinition());
+	auto          l_expected = l_draw(l_reference, 8);
+	REQUIRE( l_expected.size() == 16 );
+	REQUIRE( l_expected[0] != l_expected[2] );
+
+	SECTION("The instances of a definition draw the same payloads, whatever their order")
+	{
+		CompiledModel l_first(l_model.getDefinition());
+		CompiledModel l_second(l_model.getDefinition());
+		auto          l_begin = l_draw(l_second, 3);
+		auto          l_all   = l_draw(l_first, 8);
+		auto          l_end   = l_draw(l_second, 5);
+		l_begin.insert(l_begin.end(), l_end.begin(), l_end.end());
+		REQUIRE( l_all   == l_expected );
+		REQUIRE( l_begin == l_expected );
+
+		// The model draws them through the same definition
+		l_model.nextState();
+		REQUIRE( l_model.encodeMessages() == std::vector< std::vector<uint8_t> >(l_expected.begin(), l_expected.begin() + 2) );
+	}
+
+	SECTION("A copy goes on with the streams of the instance copied")
+	{
+		CompiledModel l_first(l_model.getDefinition());
+		l_draw(l_first, 3);
+		CompiledModel l_copy(l_first);
+		auto          l_end = l_draw(l_copy, 5);
+		REQUIRE( l_end == std::vector< std::vector<uint8_t> >(l_expected.begin() + 6, l_expected.end()) );
+		REQUIRE( l_draw(l_first, 5) == l_end );
+
+		// A reset starts the streams again
+		l_first.reset();
+		REQUIRE( l_draw(l_first, 8) == l_expected );
+	}
+
+	SECTION("The instances seeded alike draw the same payloads")
+	{
+		CompiledModel l_first(l_model.getDefinition());
+		CompiledModel l_second(l_model.getDefinition());
+		l_first.seed(7);
+		l_second.seed(7);
+		auto l_seeded = l_draw(l_first, 8);
+		REQUIRE( l_draw(l_second, 8) == l_seeded );
+		REQUIRE( l_seeded != l_expected );
+		REQUIRE( l_seeded[0] != l_seeded[1] );
+
+		// The headers are not drawn
+		REQUIRE( l_seeded[0][0] == 16 );
+		REQUIRE( l_seeded[0][1] == l_expected[0][1] );
+	}
+}
@@ -0,0 +1,476 @@
+/*!
+ * @file   08-runners.cpp
+ * @brief  Contains the unit tests for the runners of the compiled
+ *         models (timing wheel, event loop and work stealing runner).
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include <stdbool.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <ModelInstance.h>
+#include <CompiledModel.h>
+#include <EventLoop.h>
+#include <TimingWheel.h>
+#include <WorkStealingRunner.h>
+
+using namespace ModGen;
+
+TEST_CASE( "Timing wheel entries expire on their deadline", "[runners]" )
+{
+	TimingWheel l_wheel;
+
+	SECTION("Random deadlines are checked against a sorted reference")
+	{
+		const uint32_t        l_count = 2000;
+		std::mt19937_64       l_random(42);
+		std::vector<uint64_t> l_expected(l_count, TimingWheel::NEVER);
+		uint64_t              l_errors = 0;
+
+		l_wheel.setup(l_count, 123456);
+
+		auto l_schedule = [&](TimingWheel::ENTRY p_entry, uint64_t p_from)
+		{
+			// Around the slots of the first levels, far away, beyond the wheel or passed
+			uint64_t l_deadline = 0;
+			switch(l_random() % 5)
+			{
+			case 0:  l_deadline = p_from + l_random() % 300;                        break;
+			case 1:  l_deadline = p_from + l_random() % 70000;                      break;
+			case 2:  l_deadline = p_from + l_random() % (uint64_t(1) << 26);        break;
+			case 3:  l_deadline = p_from + l_random() % (uint64_t(1) << 34);        break;
+			default: l_deadline = p_from - std::min<uint64_t>(p_from, l_random() % 1000); break;
+			}
+			l_wheel.schedule(p_entry, l_deadline);
+			l_expected[p_entry] = std::max(l_deadline, l_wheel.getTick());
+		};
+
+		for(TimingWheel::ENTRY e = 0; e < l_count; e++)
+		{
+			l_schedule(e, l_wheel.getTick());
+		}
+
+		for(uint32_t l_round = 0; l_round < 300; l_round++)
+		{
+			uint64_t l_target = l_wheel.getTick();
+			switch(l_round % 4)
+			{
+			case 0:  l_target += l_random() % 50;                     break;
+			case 1:  l_target += l_random() % 5000;                   break;
+			case 2:  l_target += l_random() % (uint64_t(1) << 27);    break;
+			default: l_target  = (l_target | 0xFFFF);                 break;
+			}
+
+			// The entries are unscheduled when given: some are scheduled again
+			std::vector<std::pair<uint64_t, TimingWheel::ENTRY>> l_given;
+			l_wheel.advance(l_target, [&](TimingWheel::ENTRY p_entry)
+			{
+				uint64_t l_at = l_wheel.getTick() - 1;
+				l_given.push_back({ l_at, p_entry });
+				if(l_at != l_expected[p_entry])
+				{
+					l_errors++;
+				}
+				l_expected[p_entry] = TimingWheel::NEVER;
+				if(p_entry % 2)
+				{
+					l_schedule(p_entry, l_target + 1);
+				}
+			});
+			REQUIRE( l_errors == 0 );
+			REQUIRE( l_wheel.getTick() == l_target + 1 );
+			REQUIRE( std::is_sorted(l_given.begin(), l_given.end(),
+			                        [](const std::pair<uint64_t, TimingWheel::ENTRY>& a,
+			                           const std::pair<uint64_t, TimingWheel::ENTRY>& b) { return a.first < b.first; }) );
+
+			// Nothing due is left, nothing else was given
+			std::size_t l_scheduled = 0;
+			for(TimingWheel::ENTRY e = 0; e < l_count; e++)
+			{
+				if(l_expected[e] != TimingWheel::NEVER)
+				{
+					REQUIRE( l_expected[e] > l_target );
+					l_scheduled++;
+				}
+			}
+			REQUIRE( l_wheel.size() == l_scheduled );
+
+			for(auto& l_entry: l_given)
+			{
+				if(l_expected[l_entry.second] == TimingWheel::NEVER)
+				{
+					l_schedule(l_entry.second, l_wheel.getTick());
+				}
+			}
+		}
+
+		// Up to the farthest deadline
+		uint64_t l_last = 0;
+		for(uint64_t l_deadline: l_expected)
+		{
+			if(l_deadline != TimingWheel::NEVER)
+			{
+				l_last = std::max(l_last, l_deadline);
+			}
+		}
+		l_wheel.advance(l_last, [&](TimingWheel::ENTRY p_entry)
+		{
+			if(l_wheel.getTick() - 1 != l_expected[p_entry])
+			{
+				l_errors++;
+			}
+		});
+		REQUIRE( l_errors == 0 );
+		REQUIRE( l_wheel.size() == 0 );
+		REQUIRE( l_wheel.getNextTick() == TimingWheel::NEVER );
+	}
+
+	SECTION("Deadlines on the boundaries of the levels")
+	{
+		std::vector<uint64_t> l_deadlines = { 255, 256, 257, 511, 512, 65535, 65536, 65537, 131072,
+		                                      (uint64_t(1) << 24) - 1, uint64_t(1) << 24, uint64_t(1) << 32,
+		                                      (uint64_t(1) << 32) + 1 };
+
+		for(uint64_t l_start: { uint64_t(0), uint64_t(200), uint64_t(65500) })
+		{
+			l_wheel.setup(l_deadlines.size(), l_start);
+			for(TimingWheel::ENTRY e = 0; e < l_deadlines.size(); e++)
+			{
+				l_wheel.schedule(e, l_deadlines[e]);
+			}
+
+			// The deadlines passed at the start are all due on its tick
+			std::vector<uint64_t> l_dues;
+			for(uint64_t l_deadline: l_deadlines)
+			{
+				l_dues.push_back(std::max(l_deadline, l_start));
+			}
+
+			for(std::size_t i = 0; i < l_dues.size(); i++)
+			{
+				if(i && l_dues[i] == l_dues[i - 1])
+				{
+					continue;
+				}
+				uint64_t l_due = l_dues[i];
+
+				// Nothing is given before the deadline
+				std::vector<TimingWheel::ENTRY> l_given;
+				auto l_give = [&](TimingWheel::ENTRY p_entry) { l_given.push_back(p_entry); };
+				if(l_due > l_wheel.getTick())
+				{
+					l_wheel.advance(l_due - 1, l_give);
+				}
+				REQUIRE( l_given.empty() );
+				REQUIRE( l_wheel.getNextTick() <= l_due );
+
+				std::vector<TimingWheel::ENTRY> l_expected;
+				for(TimingWheel::ENTRY e = 0; e < l_dues.size(); e++)
+				{
+					if(l_dues[e] == l_due)
+					{
+						l_expected.push_back(e);
+					}
+				}
+				l_wheel.advance(l_due, l_give);
+				std::sort(l_given.begin(), l_given.end());
+				REQUIRE( l_given == l_expected );
+			}
+			REQUIRE( l_wheel.size() == 0 );
+		}
+	}
+
+	SECTION("Passed deadlines are due on the current tick")
+	{
+		l_wheel.setup(3, 1000);
+		l_wheel.schedule(0, 10);
+		l_wheel.schedule(1, 999);
+		l_wheel.schedule(2, 1001);
+		REQUIRE( l_wheel.getNextTick() == 1000 );
+
+		std::vector<TimingWheel::ENTRY> l_given;
+		l_wheel.advance(1000, [&](TimingWheel::ENTRY p_entry) { l_given.push_back(p_entry); });
+		std::sort(l_given.begin(), l_given.end());
+		REQUIRE( l_given == std::vector<TimingWheel::ENTRY>({ 0, 1 }) );
+		REQUIRE( l_wheel.getNextTick() == 1001 );
+
+		// Scheduled once the wheel has moved
+		l_wheel.schedule(0, 500);
+		REQUIRE( l_wheel.getNextTick() == 1001 );
+		l_given.clear();
+		l_wheel.advance(1001, [&](TimingWheel::ENTRY p_entry) { l_given.push_back(p_entry); });
+		std::sort(l_given.begin(), l_given.end());
+		REQUIRE( l_given == std::vector<TimingWheel::ENTRY>({ 0, 2 }) );
+	}
+}
+
+TEST_CASE( "The event loop runs the instances on their deadlines", "[runners]" )
+{
+	typedef std::chrono::steady_clock Clock;
+
+	EventLoop l_loop;
+	l_loop.setup(100, 1000);
+
+	SECTION("Every instance runs its states in order, never before their deadline")
+	{
+		ModelInstance l_model;
+		REQUIRE_NOTHROW( l_model.setup("./data/running_ok.xml") );
+
+		std::vector<uint64_t>      l_starts = { 0, 3000, 7000 };
+		std::vector<CompiledModel> l_models;
+		for(std::size_t i = 0; i < l_starts.size(); i++)
+		{
+			l_models.emplace_back(l_model.getDefinition());
+		}
+		for(std::size_t i = 0; i < l_starts.size(); i++)
+		{
+			REQUIRE( l_loop.add(l_models[i], l_starts[i]) == i );
+		}
+
+		// The states and their deadlines, from a reference instance
+		std::vector<uint32_t> l_states;
+		std::vector<uint64_t> l_delays;
+		CompiledModel         l_reference(l_model.getDefinition());
+		for(uint32_t i = 0; i < 200; i++)
+		{
+			l_states.push_back(l_reference.nextState());
+			l_delays.push_back(l_reference.step());
+		}
+
+		struct Run { uint32_t instance; uint32_t state; uint64_t time; std::size_t messages; };
+		std::vector<Run> l_runs;
+		Clock::time_point l_origin = Clock::now();
+		l_loop.run([&](uint32_t p_index, CompiledModel& p_model)
+		{
+			uint64_t l_time = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - l_origin).count();
+			l_runs.push_back({ p_index, p_model.getCurrent(), l_time, p_model.getMessagesCount() });
+		}, 200000);
+
+		REQUIRE( l_loop.getStatistics().steps == l_runs.size() );
+
+		// The instances start in order
+		REQUIRE( l_runs.size() > 3 );
+		REQUIRE( l_runs[0].instance == 0 );
+
+		std::vector<uint32_t> l_firsts;
+		for(auto& l_run: l_runs)
+		{
+			if(std::find(l_firsts.begin(), l_firsts.end(), l_run.instance) == l_firsts.end())
+			{
+				l_firsts.push_back(l_run.instance);
+			}
+		}
+		REQUIRE( l_firsts == std::vector<uint32_t>({ 0, 1, 2 }) );
+
+		for(uint32_t i = 0; i < l_starts.size(); i++)
+		{
+			uint32_t l_step     = 0;
+			uint64_t l_deadline = l_starts[i];
+			for(auto& l_run: l_runs)
+			{
+				if(l_run.instance != i)
+				{
+					continue;
+				}
+				REQUIRE( l_step < l_states.size() );
+				REQUIRE( l_run.state    == l_states[l_step] );
+				REQUIRE( l_run.messages == 1 );
+				REQUIRE( l_run.time     >= l_deadline );
+				l_deadline += l_delays[l_step++];
+			}
+
+			// No instance is left behind (with a margin for a loaded machine)
+			uint32_t l_expected = 0;
+			for(uint64_t l_time = l_starts[i]; l_expected < l_delays.size() && l_time <= 100000; )
+			{
+				l_time += l_delays[l_expected++];
+			}
+			REQUIRE( l_step >= l_expected );
+		}
+	}
+
+	SECTION("Parked instances are polled without blocking the other ones")
+	{
+		ModelInstance l_waiting;
+		ModelInstance l_looping;
+		REQUIRE_NOTHROW( l_waiting.setup("./data/waiting.xml") );
+		REQUIRE_NOTHROW( l_looping.setup("./data/loop_5ms.xml") );
+
+		SymbolTable::ID l_go   = l_waiting.getSymbols().variables.find("GO");
+		SymbolTable::ID l_idle = l_waiting.getSymbols().states.find("IDLE");
+		SymbolTable::ID l_poll = l_waiting.getSymbols().states.find("POLL");
+
+		CompiledModel l_loop_5ms(l_looping.getDefinition());
+		l_loop.add(l_waiting.getCompiled());
+		l_loop.add(l_loop_5ms);
+
+		// The states of the waiting instance and the number of their messages
+		std::vector<std::pair<uint32_t, std::size_t>> l_runs;
+		std::vector<uint64_t>                         l_loops(3, 0);
+		std::thread l_run([&]()
+		{
+			l_loop.run([&](uint32_t p_index, CompiledModel& p_model)
+			{
+				if(p_index == 0)
+				{
+					l_runs.push_back({ l_waiting.getCompiled().getCurrent(), p_model.getMessagesCount() });
+					return;
+				}
+
+				// The other instance runs on while IDLE (1) then POLL (2) are parked
+				l_loops[l_runs.size() < 3 ? 1 : 2]++;
+			}, 0);
+		});
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		l_waiting.getVariables().set(l_go, 1);
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		l_waiting.getVariables().set(l_go, 2);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		l_loop.stop();
+		l_run.join();
+
+		// IDLE, IDLE resumed by GO (resent), POLL, then POLL resumed
+		// by its timeout (not resent) until GO is 2
+		REQUIRE( l_runs.size() >= 5 );
+		REQUIRE( l_runs[0] == std::make_pair(l_idle, std::size_t(1)) );
+		REQUIRE( l_runs[1] == std::make_pair(l_idle, std::size_t(1)) );
+		REQUIRE( l_runs[2] == std::make_pair(l_poll, std::size_t(1)) );
+		for(std::size_t i = 3; i + 1 < l_runs.size(); i++)
+		{
+			REQUIRE( l_runs[i] == std::make_pair(l_poll, std::size_t(0)) );
+		}
+		REQUIRE( l_runs.back() == std::make_pair(l_idle, std::size_t(1)) );
+
+		REQUIRE( l_loops[1] >= 2 );
+		REQUIRE( l_loops[2] >= 2 );
+	}
+}
+
+TEST_CASE( "The work stealing runner spreads the instances over its workers", "[runners]" )
+{
+	typedef std::chrono::steady_clock Clock;
+
+	WorkStealingRunner l_runner;
+	l_runner.setup(4, 100, 1000);
+	REQUIRE( l_runner.getWorkersCount() == 4 );
+
+	// The instances of the first worker run 20 states then wait, the other
+	// ones wait at once: the first worker has all the load
+	ModelInstance l_steps;
+	ModelInstance l_waiting;
+	REQUIRE_NOTHROW( l_steps.setup("./data/steps.xml") );
+	REQUIRE_NOTHROW( l_waiting.setup("./data/waiting.xml") );
+
+	const uint32_t             l_count = 32;
+	std::vector<CompiledModel> l_models;
+	for(uint32_t i = 0; i < l_count; i++)
+	{
+		l_models.emplace_back((i % 4) ? l_waiting.getDefinition() : l_steps.getDefinition());
+	}
+	for(uint32_t i = 0; i < l_count; i++)
+	{
+		REQUIRE( l_runner.add(l_models[i]) == i );
+	}
+
+	// The messages of a state of an instance (drawn from its generators)
+	auto l_encode = [](CompiledModel& p_model)
+	{
+		std::vector< std::vector<uint8_t> > l_messages;
+		for(std::size_t i = 0; i < p_model.getMessagesCount(); i++)
+		{
+			l_messages.emplace_back(p_model.getMessageSize(i), 0);
+			p_model.encodeMessage(i, l_messages.back().data(), l_messages.back().size());
+		}
+		return l_messages;
+	};
+
+	// The states run by every instance and their messages, from reference instances
+	std::vector< std::vector<uint32_t> >                           l_expected(2);
+	std::vector< std::vector< std::vector< std::vector<uint8_t> > > > l_payloads(2);
+	for(uint32_t m = 0; m < 2; m++)
+	{
+		CompiledModel l_reference(m ? l_waiting.getDefinition() : l_steps.getDefinition());
+		do
+		{
+			l_expected[m].push_back(l_reference.nextState());
+			l_payloads[m].push_back(l_encode(l_reference));
+			l_reference.step();
+		} while(!l_reference.isParked());
+	}
+	REQUIRE( l_payloads[0][0] != l_payloads[0][1] );
+	REQUIRE( l_expected[0].size() == 21 );
+	REQUIRE( l_expected[1].size() == 1 );
+
+	std::size_t l_total = 0;
+	for(uint32_t i = 0; i < l_count; i++)
+	{
+		l_total += l_expected[(i % 4) ? 1 : 0].size();
+	}
+
+	// The sends are slow: the other workers steal while the first one sends
+	std::vector< std::vector<uint32_t> > l_states(l_count);
+	std::vector< std::vector< std::vector< std::vector<uint8_t> > > >
+	                                     l_messages(l_count);
+	std::vector< std::atomic<bool> >     l_busy(l_count);
+	std::atomic<std::size_t>             l_runs(0);
+	std::atomic<uint32_t>                l_errors(0);
+	std::thread l_run([&]()
+	{
+		l_runner.run([&](uint32_t p_worker, uint32_t p_index, CompiledModel& p_model)
+		{
+			// An instance is only run by one worker at a time
+			if(p_worker >= 4 || l_busy[p_index].exchange(true) || &p_model != &l_models[p_index] || p_model.getMessagesCount() != 1)
+			{
+				l_errors++;
+			}
+			l_states[p_index].push_back(p_model.getCurrent());
+			l_messages[p_index].push_back(l_encode(p_model));
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+			l_busy[p_index].store(false);
+			l_runs++;
+		}, 0);
+	});
+
+	Clock::time_point l_limit = Clock::now() + std::chrono::seconds(10);
+	while(l_runs.load() < l_total && Clock::now() < l_limit)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// Nothing more is run once every instance waits
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	l_runner.stop();
+	l_run.join();
+
+	REQUIRE( l_errors.load() == 0 );
+	REQUIRE( l_runs.load() == l_total );
+	// The payloads of an instance do not depend on the workers which ran it
+	for(uint32_t i = 0; i < l_count; i++)
+	{
+		REQUIRE( l_states[i]   == l_expected[(i % 4) ? 1 : 0] );
+		REQUIRE( l_messages[i] == l_payloads[(i % 4) ? 1 : 0] );
+	}
+
+	WorkStealingRunner::Statistics l_statistics = l_runner.getStatistics();
+	REQUIRE( l_statistics.steps == l_total );
+	REQUIRE( l_statistics.stolen > 0 );
+
+	SECTION("A stopped runner can run again, until its duration")
+	{
+		Clock::time_point l_start = Clock::now();
+		l_runner.run([&](uint32_t, uint32_t, CompiledModel&) { l_runs++; }, 20000);
+		REQUIRE( Clock::now() - l_start >= std::chrono::milliseconds(20) );
+		REQUIRE( l_runs.load() == l_total );
+		REQUIRE( l_runner.getStatistics().steps == 0 );
+	}
+}
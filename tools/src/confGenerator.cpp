@@ -0,0 +1,68 @@
+/*!
+ * @file   confGenerator.cpp
+ * @brief  Writes a valid synthetic configuration file (Cf. ConfGenerator).
+ *         Usage: ModelGeneratorConfGenerator -o <conf_file> [-n states]
+ *                [-m transitions] [-k headers] [-f fields] [-j messages]
+ *                [-v variables]
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+
+#include "ConfGenerator.h"
+#include "Exception.h"
+
+using namespace ModGen;
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    string   l_file;
+    uint64_t l_states      = 1000;
+    uint32_t l_transitions = 3;
+    uint32_t l_headers     = 4;
+    uint32_t l_fields      = 4;
+    uint32_t l_messages    = 8;
+    uint32_t l_variables   = 16;
+
+    int l_option;
+    while((l_option = getopt(argc, argv, "o:n:m:k:f:j:v:")) != -1)
+    {
+        switch(l_option)
+        {
+        case 'o': l_file        = optarg;                                              break;
+        case 'n': l_states      = strtoull(optarg, nullptr, 10);                       break;
+        case 'm': l_transitions = static_cast<uint32_t>(strtoul(optarg, nullptr, 10)); break;
+        case 'k': l_headers     = static_cast<uint32_t>(strtoul(optarg, nullptr, 10)); break;
+        case 'f': l_fields      = static_cast<uint32_t>(strtoul(optarg, nullptr, 10)); break;
+        case 'j': l_messages    = static_cast<uint32_t>(strtoul(optarg, nullptr, 10)); break;
+        case 'v': l_variables   = static_cast<uint32_t>(strtoul(optarg, nullptr, 10)); break;
+        default:
+            l_file.clear();
+            break;
+        }
+    }
+
+    if(l_file.empty())
+    {
+        cerr << "Usage: " << argv[0] << " -o <conf_file> [-n states] [-m transitions per state]"
+             << " [-k headers] [-f fields per header] [-j messages] [-v variables]" << endl;
+        return 1;
+    }
+
+    try
+    {
+        ConfGenerator(l_states, l_transitions, l_headers, l_fields, l_messages, l_variables).write(l_file);
+    }
+    catch(const Exception::ParsingFileError& l_error)
+    {
+        cerr << l_error.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
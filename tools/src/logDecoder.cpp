@@ -0,0 +1,58 @@
+/*!
+ * @file   logDecoder.cpp
+ * @brief  Renders a binary log file (Cf. Logger::setBinary)
+ *         in the format of the text logs.
+ *         Usage: ModelGeneratorLogDecoder <binary_logs> [text_logs]
+ *         (the text logs are written to the standard output by default).
+ * @author lhm
+ * @date   17/10/2026
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "LogFormat.h"
+#include "Exception.h"
+
+using namespace ModGen;
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        cerr << "Usage: " << argv[0] << " <binary_logs> [text_logs]" << endl;
+        return 1;
+    }
+
+    ifstream l_binary(argv[1], ios::in | ios::binary);
+    if(!l_binary.is_open())
+    {
+        cerr << "Unable to open " << argv[1] << endl;
+        return 1;
+    }
+
+    ofstream l_file;
+    if(argc > 2)
+    {
+        l_file.open(argv[2]);
+        if(!l_file.is_open())
+        {
+            cerr << "Unable to create " << argv[2] << endl;
+            return 1;
+        }
+    }
+
+    try
+    {
+        LogFormat::decode(l_binary, (argc > 2) ? static_cast<ostream&>(l_file) : cout);
+    }
+    catch(const Exception::LoggerError& l_error)
+    {
+        cerr << l_error.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}